@@ -14,6 +14,9 @@ pod_checksum_t pod_crc_epd(pod_file_epd_t* file)
 		fprintf(stderr, "ERROR: pod_crc_epd() file == NULL!");
 		return 0;
 	}
+	if(!pod_store_fetch(file->store, 0, file->size))
+		return 0;
+
 	pod_byte_t* start = (pod_byte_t*)&file->data + POD_HEADER_EPD_SIZE;
 	pod_size_t size = file->size - POD_HEADER_EPD_SIZE;
 	// fprintf(stderr, "CRC of data at %p of size %lu!\n", start, size);
@@ -30,6 +33,10 @@ pod_checksum_t pod_crc_epd_entry(pod_file_epd_t* file, pod_number_t entry_index)
 
 	pod_byte_t* start = (pod_byte_t*)file->data + file->entries[entry_index].offset;
 	pod_number_t size = file->entries[entry_index].size;
+
+	if(!pod_store_fetch(file->store, file->entries[entry_index].offset, size))
+		return 0;
+
 	return pod_crc(start, size);
 }
 
@@ -50,78 +57,34 @@ pod_signed_number32_t pod_entry_epd_adjacent_diff(const void* a, const void* b)
 
 pod_bool_t pod_file_epd_update_sizes(pod_file_epd_t* pod_file)
 {
-	/* check arguments and allocate memory */
-	size_t num_entries = pod_file->header->file_count;
-
-	if(pod_file->gap_sizes)
-		free(pod_file->gap_sizes);
-
-	pod_file->gap_sizes = calloc(num_entries + 1, sizeof(pod_number_t));
-
-	if(pod_file->gap_sizes == NULL)
-	{
-		fprintf(stderr, "Unable to allocate memory for gap_sizes\n");
+	/* entry data sits between the directory and the end of the file */
+	pod_layout_t* layout = pod_layout_create(pod_file->entries, pod_file->header->file_count, sizeof(pod_entry_epd_t),
+						 offsetof(pod_entry_epd_t, offset), offsetof(pod_entry_epd_t, size),
+						 POD_HEADER_EPD_SIZE + pod_file->header->file_count * POD_DIR_ENTRY_EPD_SIZE, pod_file->size);
+	if(layout == NULL)
 		return false;
-	}
-
-	pod_number_t* offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* min_indices = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* ordered_offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* offset_sizes = calloc(num_entries, sizeof(pod_number_t));
-
-	/* sort offset indices and accumulate entry size */
-	for(pod_number_t i = 0; i < num_entries; i++)
-		offsets[i] = pod_file->entries[i].offset;
-
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		for(pod_number_t j = i; j < num_entries; j++)
-		{
-			if(offsets[j] <= offsets[i])
-				min_indices[i] = j;
-		}
-	}
 
-	pod_file->entry_data_size = 0;
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		ordered_offsets[i] = offsets[min_indices[i]];
-		offset_sizes[i] = pod_file->entries[min_indices[i]].size;
-		pod_file->entry_data_size += offset_sizes[i];
-	}
-
-	/* find gap sizes */ 
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		pod_file->gap_sizes[i] = ((i == num_entries - 1) ? pod_file->size : ordered_offsets[i + 1]) - (ordered_offsets[i] + offset_sizes[i]);
-		pod_file->gap_sizes[num_entries] += pod_file->gap_sizes[i];
-
-		fprintf(stderr, "gap[%u]=%u accum:%u\n", i, pod_file->gap_sizes[i], pod_file->gap_sizes[num_entries]);
-	}
-
-	/* check data start */
-	pod_file->data_start = pod_file->data + offsets[min_indices[0]];
-
-	/* cleanup */
-	free(offset_sizes);
-	free(ordered_offsets);
-	free(min_indices);
-	free(offsets);
+	free(pod_file->gap_sizes);
+	pod_file->gap_sizes = layout->gap_sizes;
+	pod_file->entry_data_size = layout->entry_data_size;
+	pod_file->data_start = pod_file->data + layout->data_start;
+	layout->gap_sizes = NULL;
 
+	pod_bool_t valid = layout->valid;
+	if(!valid)
+		fprintf(stderr, "ERROR: %s entry data %u-%u exceeds %zu-%zu!\n", pod_file->filename, layout->data_start, layout->data_end,
+			(pod_size_t)(POD_HEADER_EPD_SIZE + pod_file->header->file_count * POD_DIR_ENTRY_EPD_SIZE), pod_file->size);
 
-	/* compare accumulated entry sizes + gap_sizes[0] to index_offset - header */
-	pod_number_t size = pod_file->entry_data_size + pod_file->gap_sizes[num_entries];
-	pod_number_t expected_size = pod_file->size - POD_HEADER_EPD_SIZE - POD_DIR_ENTRY_EPD_SIZE * num_entries; 
-	pod_number_t sum_size = size + POD_HEADER_EPD_SIZE;
-	/* status output */
-	fprintf(stderr, "data_start: %lu/%lu\n", pod_file->entry_data - pod_file->data, pod_file->data_start - pod_file->data);
-	fprintf(stderr, "accumulated_size: %u/%u\naccumulated gap size: %u\n", size, expected_size, pod_file->gap_sizes[num_entries]);
-	fprintf(stderr, "data_start + size: %u + %u = %u", (pod_number_t)POD_HEADER_EPD_SIZE, size, sum_size);
-
-	return size == expected_size;
+	pod_layout_delete(layout);
+	return valid;
 }
 
 pod_file_epd_t* pod_file_epd_create(pod_string_t filename)
+{
+	return pod_file_epd_open(filename, POD_OPEN_READ);
+}
+
+pod_file_epd_t* pod_file_epd_open(pod_string_t filename, pod_open_mode_t mode)
 {
 	pod_file_epd_t* pod_file = calloc(1, sizeof(pod_file_epd_t));
 
@@ -147,67 +110,37 @@ pod_file_epd_t* pod_file_epd_create(pod_string_t filename)
 		return pod_file;
 	}
 
-	struct stat sb;
-	if(stat(filename, &sb) != 0 || sb.st_size == 0)
-	{
-		perror("stat");
-		return NULL;
-	}
-
 	pod_file->filename = strdup(filename);
-	pod_file->size = sb.st_size;
-
-	FILE* file = fopen(filename, "rb");
-
-	if(!file)
-	{
-		fprintf(stderr, "ERROR: Could not open POD file: %s\n", filename);
-		return NULL;
-	}
-
-	pod_file->data = calloc(1, pod_file->size);
+	pod_file->data = pod_store_load(filename, mode, &pod_file->store, &pod_file->size);
 
 	if(!pod_file->data)
 	{
-		fprintf(stderr, "ERROR: Could not allocate memory of size %zu for file %s!\n", pod_file->size, filename);
-		fclose(file);
+		fprintf(stderr, "ERROR: Could not load POD file %s!\n", filename);
 		return pod_file_epd_delete(pod_file);
 	}
 
-	if(fread(pod_file->data, POD_BYTE_SIZE, POD_IDENT_SIZE, file) != POD_IDENT_SIZE * POD_BYTE_SIZE)
+	/* lazy archives only read the header and the directory */
+	if(!pod_store_fetch(pod_file->store, 0, POD_HEADER_EPD_SIZE) ||
+	   !pod_store_fetch(pod_file->store, POD_HEADER_EPD_SIZE, ((pod_header_epd_t*)pod_file->data)->file_count * POD_DIR_ENTRY_EPD_SIZE))
 	{
-		fprintf(stderr, "ERROR: Could not read file magic %s!\n", filename);
-		fclose(file);
+		fprintf(stderr, "ERROR: Could not read EPD directory of %s!\n", filename);
 		return pod_file_epd_delete(pod_file);
 	}
+
 	if(!pod_is_epd(pod_file->data))
 	{
 		fprintf(stderr, "ERROR: POD file format is not EPD %s!\n", filename);
-		fclose(file);
-		return pod_file_epd_delete(pod_file);
-	}
-
-	if(fread(pod_file->data + POD_IDENT_SIZE, POD_BYTE_SIZE, EPD_COMMENT_SIZE, file) != EPD_COMMENT_SIZE * POD_BYTE_SIZE)
-	{
-		fprintf(stderr, "ERROR: Could not read file comment %s!\n", filename);
-		fclose(file);
-		return pod_file_epd_delete(pod_file);
-	}
-	if(fread(pod_file->data + POD_IDENT_SIZE + EPD_COMMENT_SIZE , POD_NUMBER_SIZE, 3, file) != 3)
-	{
-		fprintf(stderr, "ERROR: Could not read file header %s!\n", filename);
-		fclose(file);
-		return pod_file_epd_delete(pod_file);
-	}
-	if(fread(pod_file->data + POD_HEADER_EPD_SIZE, POD_BYTE_SIZE, pod_file->size - POD_HEADER_EPD_SIZE, file) != (pod_file->size - POD_HEADER_EPD_SIZE ) * POD_BYTE_SIZE)
-	{
-		fprintf(stderr, "ERROR: Could not read file %s!\n", filename);
-		fclose(file);
 		return pod_file_epd_delete(pod_file);
 	}
 
-	fclose(file);
-	pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
+	/* warm opens take checksum, layout and name index from the sidecar, */
+	/* mapped archives skip the whole file pass                          */
+	pod_cache_t* cache = pod_cache_load(filename, pod_file->data, POD_HEADER_EPD_SIZE, ((pod_header_epd_t*)pod_file->data)->file_count);
+	pod_file->checksum_valid = cache != NULL || pod_file->store == NULL;
+	if(cache != NULL)
+		pod_file->checksum = cache->checksum;
+	else if(pod_file->store == NULL)
+		pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
 
 	pod_file->header = (pod_header_epd_t*)pod_file->data;
 	pod_file->entries = (pod_entry_epd_t*)(pod_file->data + POD_HEADER_EPD_SIZE);
@@ -232,7 +165,17 @@ pod_file_epd_t* pod_file_epd_create(pod_string_t filename)
 
 	size_t max_entry_len = pod_file->entries[max_entry_index].size;
 
-	if(!pod_file_epd_update_sizes(pod_file))
+	if(cache != NULL)
+	{
+		pod_file->gap_sizes = cache->gap_sizes;
+		pod_file->data_start = pod_file->data + cache->data_start;
+		pod_file->entry_data_size = cache->entry_data_size;
+		pod_file->index = cache->index;
+		cache->gap_sizes = NULL;
+		cache->index = NULL;
+		cache = pod_cache_delete(cache);
+	}
+	else if(!pod_file_epd_update_sizes(pod_file))
 	{
 		fprintf(stderr, "ERROR: Could not update EPD file entry sizes\n");
 		pod_file = pod_file_epd_delete(pod_file);
@@ -249,6 +192,16 @@ bool pod_file_epd_add_entry(pod_file_epd_t* pod_file, pod_entry_epd_t* entry, po
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_add_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	size_t new_entry_size = POD_DIR_ENTRY_EPD_SIZE;
 	size_t new_entry_data_size = entry->size;
 	size_t new_path_data_size = strlen(filename) + 1;
@@ -291,6 +244,16 @@ bool pod_file_epd_del_entry(pod_file_epd_t* pod_file, pod_number_t entry_index)
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_del_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	if (entry_index >= pod_file->header->file_count)
 	{
 		fprintf(stderr, "ERROR: pod_file_epd_del_entry(entry_index >= pod_file->header->file_count)\n");
@@ -331,6 +294,50 @@ pod_entry_epd_t* pod_file_epd_get_entry(pod_file_epd_t* pod_file, pod_number_t e
 	return &pod_file->entries[entry_index];
 }
 
+bool pod_file_epd_stream_entry(pod_file_epd_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context)
+{
+	if (pod_file == NULL || sink == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_stream_entry(pod_file == NULL || sink == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_stream_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	pod_entry_epd_t* entry = &pod_file->entries[entry_index];
+	if (!pod_store_fetch(pod_file->store, entry->offset, entry->size))
+		return false;
+
+	return sink(context, pod_file->data + entry->offset, entry->size);
+}
+
+bool pod_file_epd_write_entry(pod_file_epd_t* pod_file, pod_number_t entry_index, FILE* file)
+{
+	if (pod_file == NULL || file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_write_entry(pod_file == NULL || file == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_write_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	/* stored bytes go from the archive fd to file inside the kernel */
+	pod_entry_epd_t* entry = &pod_file->entries[entry_index];
+	pod_ssize_t copied = pod_store_copy(pod_file->store, entry->offset, entry->size, file);
+	if (copied != 0)
+		return copied > 0;
+
+	return pod_file_epd_stream_entry(pod_file, entry_index, pod_sink_file, file);
+}
+
 bool pod_file_epd_extract_entry(pod_file_epd_t* pod_file, pod_number_t entry_index, pod_string_t dst)
 {
 	if (pod_file == NULL)
@@ -353,16 +360,13 @@ bool pod_file_epd_extract_entry(pod_file_epd_t* pod_file, pod_number_t entry_ind
 		return false;
 	}
 
-	pod_entry_epd_t* entry = &pod_file->entries[entry_index];
-	if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
+	bool ok = pod_file_epd_write_entry(pod_file, entry_index, file);
+	if (fclose(file) != 0)
 	{
-		fprintf(stderr, "ERROR: pod_file_epd_extract_entry(fwrite failed!\n");
-		fclose(file);
-		return false;
+		fprintf(stderr, "ERROR: pod_file_epd_extract_entry(fclose(%s) failed: %s\n", dst, strerror(errno));
+		ok = false;
 	}
-
-	fclose(file);
-	return true;
+	return ok;
 }
 
 pod_file_epd_t* pod_file_epd_delete(pod_file_epd_t* podfile)
@@ -374,6 +378,13 @@ pod_file_epd_t* pod_file_epd_delete(pod_file_epd_t* podfile)
 			free(podfile->gap_sizes);
 			podfile->gap_sizes = NULL;
 		}
+		podfile->index = pod_index_delete(podfile->index);
+		podfile->tree = pod_tree_delete(podfile->tree);
+		if(podfile->store)
+		{
+			podfile->store = pod_store_close(podfile->store);
+			podfile->data = NULL;
+		}
 		if(podfile->data)
 		{
 			free(podfile->data);
@@ -393,7 +404,7 @@ pod_file_epd_t* pod_file_epd_delete(pod_file_epd_t* podfile)
 	return podfile;
 }
 
-bool pod_file_epd_print(pod_file_epd_t* pod_file, pod_char_t* pattern)
+bool pod_file_epd_print(pod_file_epd_t* pod_file, pod_match_t* match)
 {
 	if(pod_file == NULL)
 	{
@@ -401,26 +412,31 @@ bool pod_file_epd_print(pod_file_epd_t* pod_file, pod_char_t* pattern)
 		return false;
 	}
 
+	/* lazy archives list without touching entry data */
+	pod_bool_t lazy = pod_store_is_lazy(pod_file->store);
+	pod_char_t checksum[POD_CHECKSUM_STRING_SIZE];
+
 	/* print entries */
 	printf("\nEntries:\n");
 	for(pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
 		pod_entry_epd_t* entry = &pod_file->entries[i];
 		pod_char_t* name = pod_file->entries[i].name;
-		if (pattern && strstr(name, pattern) == NULL)
+		if (!pod_match_test(match, name))
 			continue;
-		printf("%10u %10u %10u 0x%.8X/0x%.8X %s %s\n",
+		printf("%10u %10u %10u 0x%.8X/%s %s %s\n",
 		       	i,
 			entry->offset,
 			entry->size,
-			entry->checksum, pod_crc_epd_entry(pod_file, i),
+			entry->checksum, pod_checksum_str(checksum, "0x%.8X", lazy ? 0 : pod_crc_epd_entry(pod_file, i), !lazy),
 			pod_ctime(&entry->timestamp),
 			name);
 	}
 
 	/* print file summary */
+	pod_char_t file_checksum[POD_CHECKSUM_STRING_SIZE];
 	printf("\nSummary:\n \
-	        file checksum      : 0x%.8X/%.10u\n \
+	        file checksum      : %s\n \
 	        size               : %zu\n \
 		filename           : %s\n \
 		format             : %s\n \
@@ -428,7 +444,7 @@ bool pod_file_epd_print(pod_file_epd_t* pod_file, pod_char_t* pattern)
 		data checksum      : 0x%.8X/0x%.8X\n \
 		file entries       : 0x%.8X/%.10u\n \
 		version            : 0x%.8X/%.10u\n",
-		pod_file->checksum,pod_file->checksum,
+		pod_checksum_str(file_checksum, "0x%.8X/%.10u", pod_file->checksum, pod_file->checksum_valid),
 		pod_file->size,
 		pod_file->filename,
 		pod_type_desc_str(pod_type(pod_file->header->ident)),
@@ -447,6 +463,12 @@ bool pod_file_epd_write(pod_file_epd_t* pod_file, pod_string_t filename)
 		fprintf(stderr, "ERROR: pod_file or filename equals NULL!\n");
 		return false;
 	}
+
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_epd_write() archive is mapped read-only!\n");
+		return false;
+	}
 	
 	size_t new_total_size = pod_file->size + pod_file->header->file_count * POD_DIR_ENTRY_EPD_SIZE;
 	void* new_data = realloc(pod_file->data, new_total_size);
@@ -481,107 +503,50 @@ bool pod_file_epd_write(pod_file_epd_t* pod_file, pod_string_t filename)
 
 /* Extract EPD file pod_file to directory dst                       */
 /* @returns true on success otherwise false and leaves errno         */
-bool pod_file_epd_extract(pod_file_epd_t* pod_file, pod_string_t pattern, pod_string_t dst)
+bool pod_file_epd_extract(pod_file_epd_t* pod_file, pod_match_t* match, pod_string_t dst)
 {
-	pod_bool_t absolute = false;
 	if (pod_file == NULL)
 	{
 		fprintf(stderr, "ERROR: pod_file_epd_extract(pod_file == NULL)\n");
 		return false;
 	}
 
-	if (dst == NULL) { dst = "./"; }
-
-	pod_char_t cwd[POD_SYSTEM_PATH_SIZE];
-	getcwd(cwd, sizeof(cwd));
-	printf("cwd: %s\n", cwd);
-	pod_path_t root = pod_path_system_root();
-
-	printf("root: %s\n", root);
-	pod_path_t path = NULL;
-
-	if (absolute)
-	{
-		path = pod_path_append_win32(root, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append_win32(%s,%s)\n", root, dst);
-			free(root);
-			return false;
-		}
-	}
-	else
-	{
-		path = pod_path_append_win32(cwd, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append_win32(%s,%s)\n", cwd, dst);
-			free(root);
-			return false;
-		}
-	}
-
-	printf("path: %s\n", path);
-	/* create and change to destination directory */
-	if (mkdir_p(path, ACCESSPERMS) != 0)
-	{
-		fprintf(stderr, "mkdir_p(\"%s\", \'%c\') = %s\n", dst, '/', strerror(errno));
+	/* entries are created relative to dst, the working directory stays */
+	pod_dest_t* dir = pod_dest_open(dst);
+	if (dir == NULL)
 		return false;
-	}
-
-	if (chdir(path) != 0)
-	{
-		fprintf(stderr, "chdir(%s) = %s\n", path, strerror(errno));
-		return false;
-	}
 
 	/* extract entries */
-	for (int i = 0; i < pod_file->header->file_count; i++)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		if (pattern && strstr(pod_file->entries[i].name, pattern) == NULL)
+		pod_char_t* filename = pod_file->entries[i].name;
+		if (!pod_match_test(match, filename))
 			continue;
-	
-		char* basename = strdup(pod_file->entries[i].name);
-		if (!basename)
-		{
-			fprintf(stderr, "ERROR: strdup(filename) failed!\n");
-			return false;
-		}
-		char* p = basename;
-		while (*p)
-		{
-			if (*p == '/' || *p == '\\')
-			{
-				basename = p + 1;
-			}
-			p++;
-		}
-		
+
 		/* open and create directories including parents */
-		if (strlen(basename) > 0 && mkdir_p(pod_path_append(path, basename), ACCESSPERMS) != 0)
+		FILE* file = pod_dest_fopen(dir, filename);
+		if (file == NULL)
 		{
-			fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", basename, strerror(errno));
+			pod_dest_close(dir);
 			return false;
 		}
-		FILE* file = fopen(pod_file->entries[i].name, "wb");
-		if (file == NULL)
+
+		bool ok = pod_file_epd_write_entry(pod_file, i, file);
+		if (fclose(file) != 0)
 		{
-			fprintf(stderr, "ERROR: pod_fopen_mkdir(%s) failed: %s\n", pod_file->entries[i].name, strerror(errno));
-			return false;
+			fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", filename, strerror(errno));
+			ok = false;
 		}
-		if (fwrite(pod_file->data + pod_file->entries[i].offset, pod_file->entries[i].size, 1, file) != 1)
+		if (!ok)
 		{
-			fprintf(stderr, "ERROR: fwrite failed!\n");
-			fclose(file);
+			pod_dest_close(dir);
 			return false;
 		}
 
 		/* Debug/Info print thingy */
-		fprintf(stderr, "%s -> %s\n", pod_file->entries[i].name, pod_path_append_win32(path, pod_file->entries[i].name));
-
-		/* clean up and pop */
-		fclose(file);
+		fprintf(stderr, "%s -> %s/%s\n", filename, dir->path, filename);
 	}
-	chdir(cwd);
+
+	pod_dest_close(dir);
 	return true;
 }
\ No newline at end of file
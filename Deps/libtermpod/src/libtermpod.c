@@ -1,5 +1,7 @@
 #include "libtermpod.h"
 
+static pod_bool_t pod_file_cache_save(pod_file_type_t file);
+
 int pod_file_typeid(pod_file_type_t file)
 {
 	return ((file.pod1 != NULL) ? pod_type((char*)file.pod1->header) : POD_IDENT_TYPE_SIZE);
@@ -11,6 +13,11 @@ pod_bool_t pod_file_is_pod(pod_path_t name)
 }
 
 pod_file_type_t pod_file_create(pod_path_t name, pod_ident_type_t type)
+{
+	return pod_file_open(name, type, POD_OPEN_READ);
+}
+
+pod_file_type_t pod_file_open(pod_path_t name, pod_ident_type_t type, pod_open_mode_t mode)
 {
 	pod_file_type_t pod = { NULL };
 	if(name == NULL)
@@ -25,37 +32,37 @@ pod_file_type_t pod_file_create(pod_path_t name, pod_ident_type_t type)
 	switch(type)
 	{
 		case POD1:
-			pod.pod1 = pod_file_pod1_create(name);
+			pod.pod1 = pod_file_pod1_open(name, mode);
 			if(pod.pod1 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod1 file!\n");
 			break;
 		case POD2:
-			pod.pod2 = pod_file_pod2_create(name);
+			pod.pod2 = pod_file_pod2_open(name, mode);
 			if(pod.pod2 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod2 file!\n");
 			break;
 		case POD3:
-			pod.pod3 = pod_file_pod3_create(name);
+			pod.pod3 = pod_file_pod3_open(name, mode);
 			if(pod.pod3 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod3 file!\n");
 			break;
 		case POD4:
-			pod.pod4 = pod_file_pod4_create(name);
+			pod.pod4 = pod_file_pod4_open(name, mode);
 			if(pod.pod4 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod4 file!\n");
 			break;
 		case POD5:
-			pod.pod5 = pod_file_pod5_create(name);
+			pod.pod5 = pod_file_pod5_open(name, mode);
 			if(pod.pod5 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod5 file!\n");
 			break;
 		case POD6:
-			pod.pod6 = pod_file_pod6_create(name);
+			pod.pod6 = pod_file_pod6_open(name, mode);
 			if(pod.pod6 == NULL)
 				fprintf(stderr, "ERROR: cannot create pod6 file!\n");
 			break;
 		case EPD:
-			pod.epd = pod_file_epd_create(name);
+			pod.epd = pod_file_epd_open(name, mode);
 			if(pod.epd == NULL)
 				fprintf(stderr, "ERROR: cannot create epd file!\n");
 			break;
@@ -63,6 +70,11 @@ pod_file_type_t pod_file_create(pod_path_t name, pod_ident_type_t type)
 			fprintf(stderr, "ERROR: unknown file format!\n");
 			break;
 	}
+
+	/* warm opens got their index from the sidecar, cold ones write it */
+	if(pod.pod1 != NULL && pod_cache_is_enabled() && !dir_exists(name))
+		pod_file_cache_save(pod);
+
 	return pod;
 }
 
@@ -294,24 +306,24 @@ pod_file_type_t pod_file_merge(pod_file_type_t file, pod_file_type_t src) {
 	}
 }
 
-bool pod_file_print(pod_file_type_t file, pod_char_t* pattern)
+bool pod_file_print(pod_file_type_t file, pod_match_t* match)
 {
 	switch(pod_file_typeid(file))
 	{
 		case POD1:
-			return pod_file_pod1_print(file.pod1, pattern);
+			return pod_file_pod1_print(file.pod1, match);
 		case POD2:
-			return pod_file_pod2_print(file.pod2, pattern);
+			return pod_file_pod2_print(file.pod2, match);
 		case POD3:
-			return pod_file_pod3_print(file.pod3, pattern);
+			return pod_file_pod3_print(file.pod3, match);
 		case POD4:
-			return pod_file_pod4_print(file.pod4, pattern);
+			return pod_file_pod4_print(file.pod4, match);
 		case POD5:
-			return pod_file_pod5_print(file.pod5, pattern);
+			return pod_file_pod5_print(file.pod5, match);
 		case POD6:
-			return pod_file_pod6_print(file.pod6, pattern);
+			return pod_file_pod6_print(file.pod6, match);
 		case EPD:
-			return pod_file_epd_print(file.epd, pattern);
+			return pod_file_epd_print(file.epd, match);
 		default:
 			fprintf(stderr, "ERROR: pod_file_print() unknown file format!\n");
 			return false;
@@ -319,45 +331,31 @@ bool pod_file_print(pod_file_type_t file, pod_char_t* pattern)
 	return true;
 }
 
-pod_ssize_t pod_file_extract(pod_file_type_t file, pod_char_t* pattern, pod_path_t dst)
+pod_ssize_t pod_file_extract(pod_file_type_t file, pod_match_t* match, pod_path_t dst)
 {
 	pod_ssize_t size = 0;
 	switch (pod_file_typeid(file))
 	{
 		case POD1:
-			size = pod_file_pod1_extract(file.pod1, pattern, dst);
+			size = pod_file_pod1_extract(file.pod1, match, dst);
 			break;
 		case POD2:
-			size = pod_file_pod2_extract(file.pod2, pattern, dst);
+			size = pod_file_pod2_extract(file.pod2, match, dst);
 			break;
 		case POD3:
-			size = pod_file_pod3_extract(file.pod3, pattern, dst);
+			size = pod_file_pod3_extract(file.pod3, match, dst);
 			break;
 		case POD4:
-			size = pod_file_pod4_extract(file.pod4, pattern, dst);
+			size = pod_file_pod4_extract(file.pod4, match, dst);
 			break;
 		case POD5:
-			size = pod_file_pod5_extract(file.pod5, pattern, dst);
-			while (file.pod5->header->next_archive[0] != '\0') {
-				pod_file_type_t next = pod_file_create(file.pod5->header->next_archive, -1);
-				fprintf(stderr, "INFO: pod_file_extract() next archive: %s\n", file.pod5->header->next_archive);
-				size += pod_file_extract(next, pattern, dst);
-				pod_file_delete(file);
-				file = next;
-			}
+			size = pod_file_pod5_extract(file.pod5, match, dst);
 			break;
 		case POD6:
-			size = pod_file_pod6_extract(file.pod6, pattern, dst);
-			while (file.pod6->header->next_archive[0] != '\0') {
-				pod_file_type_t next = pod_file_create(file.pod6->header->next_archive, -1);
-				fprintf(stderr, "INFO: pod_file_extract() next archive: %s\n", file.pod6->header->next_archive);
-				size += pod_file_extract(next, pattern, dst);
-				pod_file_delete(file);
-				file = next;
-			}
+			size = pod_file_pod6_extract(file.pod6, match, dst);
 			break;
 		case EPD:
-			size = pod_file_epd_extract(file.epd, pattern, dst);
+			size = pod_file_epd_extract(file.epd, match, dst);
 			break;
 		default:
 			fprintf(stderr, "ERROR: pod_file_extract() unknown file format!\n");
@@ -366,7 +364,7 @@ pod_ssize_t pod_file_extract(pod_file_type_t file, pod_char_t* pattern, pod_path
 	return size;
 }
 
-pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
+pod_ssize_t pod_file_count(pod_file_type_t file, pod_match_t* match)
 {
 	pod_ssize_t size = 0;
 	switch (pod_file_typeid(file))
@@ -374,7 +372,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 		case POD1:
 			for (int i = 0; i < file.pod1->header->file_count; i++) {
 				pod_entry_pod1_t* entry = &file.pod1->entries[i];
-				if (pattern == NULL || strstr(entry->name, pattern) != NULL) {
+				if (pod_match_test(match, entry->name)) {
 					size++;
 				}
 			}
@@ -383,7 +381,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 			for (int i = 0; i < file.pod2->header->file_count; i++) {
 				pod_entry_pod2_t* entry = &file.pod2->entries[i];
 				pod_char_t* name = file.pod2->path_data + entry->path_offset;
-				if (pattern == NULL || strstr(name, pattern) != NULL) {
+				if (pod_match_test(match, name)) {
 					size++;
 				}
 			}
@@ -392,7 +390,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 			for (int i = 0; i < file.pod3->header->file_count; i++) {
 				pod_entry_pod3_t* entry = &file.pod3->entries[i];
 				pod_char_t* name = file.pod3->path_data + entry->path_offset;
-				if (pattern == NULL || strstr(name, pattern) != NULL) {
+				if (pod_match_test(match, name)) {
 					size++;
 				}
 			}
@@ -401,7 +399,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 			for (int i = 0; i < file.pod4->header->file_count; i++) {
 				pod_entry_pod4_t* entry = &file.pod4->entries[i];
 				pod_char_t* name = file.pod4->path_data + entry->path_offset;
-				if (pattern == NULL || strstr(name, pattern) != NULL) {
+				if (pod_match_test(match, name)) {
 					size++;
 				}
 			}
@@ -410,7 +408,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 			for (int i = 0; i < file.pod5->header->file_count; i++) {
 				pod_entry_pod5_t* entry = &file.pod5->entries[i];
 				pod_char_t* name = file.pod5->path_data + entry->path_offset;
-				if (pattern == NULL || strstr(name, pattern) != NULL) {
+				if (pod_match_test(match, name)) {
 					size++;
 				}
 			}
@@ -419,7 +417,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 			for (int i = 0; i < file.pod6->header->file_count; i++) {
 				pod_entry_pod6_t* entry = &file.pod6->entries[i];
 				pod_char_t* name = file.pod6->path_data + entry->path_offset;
-				if (pattern == NULL || strstr(name, pattern) != NULL) {
+				if (pod_match_test(match, name)) {
 					size++;
 				}
 			}
@@ -427,7 +425,7 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 		case EPD:
 			for (int i = 0; i < file.epd->header->file_count; i++) {
 				pod_entry_epd_t* entry = &file.epd->entries[i];
-				if (pattern == NULL || strstr(entry->name, pattern) != NULL) {
+				if (pod_match_test(match, entry->name)) {
 					size++;
 				}
 			}
@@ -440,194 +438,1735 @@ pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern)
 }
 
 /* access entries by name and/or number */
-pod_byte_t* pod_file_entry_data_get(pod_file_type_t file, pod_path_t entry_name, pod_number_t entry_number) {
+pod_number_t pod_file_entry_count(pod_file_type_t file)
+{
 	switch (pod_file_typeid(file))
 	{
 		case POD1:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod1->header->file_count; i++) {
-					pod_entry_pod1_t* entry = &file.pod1->entries[i];
-					if (strcmp(entry->name, entry_name) == 0) {
-						return file.pod1->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod1_t* entry = &file.pod1->entries[entry_number];
-				return file.pod1->entry_data + entry->offset;
-			}
+			return file.pod1->header->file_count;
 		case POD2:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod2->header->file_count; i++) {
-					pod_entry_pod2_t* entry = &file.pod2->entries[i];
-					pod_char_t* name = file.pod2->path_data + entry->path_offset;
-					if (strcmp(name, entry_name) == 0) {
-						return file.pod2->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod2_t* entry = &file.pod2->entries[entry_number];
-				return file.pod2->entry_data + entry->offset;
-			}
+			return file.pod2->header->file_count;
 		case POD3:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod3->header->file_count; i++) {
-					pod_entry_pod3_t* entry = &file.pod3->entries[i];
-					pod_char_t* name = file.pod3->path_data + entry->path_offset;
-					if (strcmp(name, entry_name) == 0) {
-						return file.pod3->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod3_t* entry = &file.pod3->entries[entry_number];
-				return file.pod3->entry_data + entry->offset;
-			}
+			return file.pod3->header->file_count;
 		case POD4:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod4->header->file_count; i++) {
-					pod_entry_pod4_t* entry = &file.pod4->entries[i];
-					pod_char_t* name = file.pod4->path_data + entry->path_offset;
-					if (strcmp(name, entry_name) == 0) {
-						return file.pod4->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod4_t* entry = &file.pod4->entries[entry_number];
-				return file.pod4->entry_data + entry->offset;
-			}
+			return file.pod4->header->file_count;
 		case POD5:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod5->header->file_count; i++) {
-					pod_entry_pod5_t* entry = &file.pod5->entries[i];
-					pod_char_t* name = file.pod5->path_data + entry->path_offset;
-					if (strcmp(name, entry_name) == 0) {
-						return file.pod5->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod5_t* entry = &file.pod5->entries[entry_number];
-				return file.pod5->entry_data + entry->offset;
-			}
+			return file.pod5->header->file_count;
 		case POD6:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.pod6->header->file_count; i++) {
-					pod_entry_pod6_t* entry = &file.pod6->entries[i];
-					pod_char_t* name = file.pod6->path_data + entry->path_offset;
-					if (strcmp(name, entry_name) == 0) {
-						return file.pod6->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_pod6_t* entry = &file.pod6->entries[entry_number];
-				return file.pod6->entry_data + entry->offset;
-			}
+			return file.pod6->header->file_count;
 		case EPD:
-			if (entry_number == NULL) {
-				for (int i = 0; i < file.epd->header->file_count; i++) {
-					pod_entry_epd_t* entry = &file.epd->entries[i];
-					if (strcmp(entry->name, entry_name) == 0) {
-						return file.epd->entry_data + entry->offset;
-					}
-				}
-			}
-			else {
-				pod_entry_epd_t* entry = &file.epd->entries[entry_number];
-				return file.epd->entry_data + entry->offset;
-			}
+			return file.epd->header->file_count;
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_count() unknown file format!\n");
+			return 0;
+	}
+}
+
+pod_char_t* pod_file_entry_name(pod_file_type_t file, pod_number_t entry_number)
+{
+	if (entry_number >= pod_file_entry_count(file))
+		return NULL;
+
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			return file.pod1->entries[entry_number].name;
+		case POD2:
+			return file.pod2->path_data + file.pod2->entries[entry_number].path_offset;
+		case POD3:
+			return file.pod3->path_data + file.pod3->entries[entry_number].path_offset;
+		case POD4:
+			return file.pod4->path_data + file.pod4->entries[entry_number].path_offset;
+		case POD5:
+			return file.pod5->path_data + file.pod5->entries[entry_number].path_offset;
+		case POD6:
+			return file.pod6->path_data + file.pod6->entries[entry_number].path_offset;
+		case EPD:
+			return file.epd->entries[entry_number].name;
 		default:
-			fprintf(stderr, "ERROR: pod_file_entry_data_get() unknown file format!\n");
+			fprintf(stderr, "ERROR: pod_file_entry_name() unknown file format!\n");
 			return NULL;
 	}
-	return NULL;
 }
-pod_file_type_t  pod_file_entry_data_add(pod_file_type_t file, void* entry, pod_string_t filename, pod_byte_t* data) {
+
+/* the name index lives in the format struct so it dies with the archive */
+static pod_index_t** pod_file_index_ref(pod_file_type_t file)
+{
 	switch (pod_file_typeid(file))
 	{
 		case POD1:
-			file.pod1 = pod_file_pod1_add_entry(file.pod1, entry, filename, data);
-			break;
+			return &file.pod1->index;
 		case POD2:
-			file.pod2 = pod_file_pod2_add_entry(file.pod2, entry, filename, data);
-			break;
+			return &file.pod2->index;
 		case POD3:
-			file.pod3 = pod_file_pod3_add_entry(file.pod3, entry, filename, data);
-			break;
+			return &file.pod3->index;
 		case POD4:
-			file.pod4 = pod_file_pod4_add_entry(file.pod4, entry, filename, data);
-			break;
+			return &file.pod4->index;
 		case POD5:
-			file.pod5 = pod_file_pod5_add_entry(file.pod5, entry, filename, data);
-			break;
+			return &file.pod5->index;
 		case POD6:
-			file.pod6 = pod_file_pod6_add_entry(file.pod6, entry, filename, data);
-			break;
+			return &file.pod6->index;
 		case EPD:
-			file.epd = pod_file_epd_add_entry(file.epd, entry, filename, data);
-			break;
+			return &file.epd->index;
 		default:
-			fprintf(stderr, "ERROR: pod_file_entry_data_add() unknown file format!\n");
-			break;
+			fprintf(stderr, "ERROR: pod_file_index() unknown file format!\n");
+			return NULL;
 	}
-	return file;
 }
-pod_file_type_t  pod_file_entry_data_del(pod_file_type_t file, pod_number_t entry_number) {
+
+pod_index_t* pod_file_index(pod_file_type_t file)
+{
+	pod_index_t** index = pod_file_index_ref(file);
+	if (index == NULL)
+		return NULL;
+
+	if (*index == NULL)
+	{
+		pod_number_t count = pod_file_entry_count(file);
+		if ((*index = pod_index_create(count)) == NULL)
+			return NULL;
+
+		for (pod_number_t i = 0; i < count; i++)
+		{
+			if (!pod_index_insert(*index, pod_file_entry_name(file, i), i))
+			{
+				*index = pod_index_delete(*index);
+				return NULL;
+			}
+		}
+	}
+
+	return *index;
+}
+
+pod_ssize_t pod_file_entry_find(pod_file_type_t file, pod_path_t entry_name)
+{
+	return pod_index_find(pod_file_index(file), entry_name);
+}
+
+/* the directory tree lives next to the name index and dies with it */
+static pod_tree_t** pod_file_tree_ref(pod_file_type_t file)
+{
 	switch (pod_file_typeid(file))
 	{
 		case POD1:
-			file.pod1 = pod_file_pod1_del_entry(file.pod1, entry_number);
+			return &file.pod1->tree;
+		case POD2:
+			return &file.pod2->tree;
+		case POD3:
+			return &file.pod3->tree;
+		case POD4:
+			return &file.pod4->tree;
+		case POD5:
+			return &file.pod5->tree;
+		case POD6:
+			return &file.pod6->tree;
+		case EPD:
+			return &file.epd->tree;
+		default:
+			fprintf(stderr, "ERROR: pod_file_tree() unknown file format!\n");
+			return NULL;
+	}
+}
+
+pod_tree_t* pod_file_tree(pod_file_type_t file)
+{
+	pod_tree_t** tree = pod_file_tree_ref(file);
+	if (tree == NULL)
+		return NULL;
+
+	if (*tree == NULL)
+	{
+		pod_number_t count = pod_file_entry_count(file);
+		const pod_char_t** names = malloc((count > 0 ? count : 1) * sizeof(pod_char_t*));
+		if (names == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_file_tree() could not allocate %u names!\n", count);
+			return NULL;
+		}
+
+		for (pod_number_t i = 0; i < count; i++)
+			names[i] = pod_file_entry_name(file, i);
+
+		*tree = pod_tree_create(names, count);
+		free(names);
+	}
+
+	return *tree;
+}
+
+/* @returns the volume holding entry of volumes and its number there */
+static pod_file_type_t pod_volumes_locate(pod_volumes_t* volumes, pod_number_t entry, pod_number_t* file_entry)
+{
+	pod_number_t low = 0;
+	pod_number_t high = volumes->count;
+	while (high - low > 1)
+	{
+		pod_number_t mid = low + (high - low) / 2;
+		if (volumes->first_entry[mid] <= entry)
+			low = mid;
+		else
+			high = mid;
+	}
+	*file_entry = entry - volumes->first_entry[low];
+	return volumes->files[low];
+}
+
+/* a single archive seen as volumes without following next_archive */
+static pod_volumes_t* pod_volumes_view(pod_volumes_t* view, pod_file_type_t* file, pod_number_t* first_entry)
+{
+	first_entry[0] = 0;
+	first_entry[1] = pod_file_entry_count(*file);
+	*view = (pod_volumes_t){ file, 1, first_entry, first_entry[1], pod_file_index(*file), pod_file_tree(*file), false };
+	return view->tree != NULL ? view : NULL;
+}
+
+static pod_ssize_t pod_volumes_list_tree(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match)
+{
+	pod_tree_t* tree = volumes->tree;
+	pod_number_t node = pod_tree_find(tree, dir);
+	if (node == POD_TREE_NONE)
+	{
+		fprintf(stderr, "ERROR: pod_file_list_dir() no directory %s in archive!\n", dir);
+		return -1;
+	}
+
+	pod_ssize_t listed = 0;
+	for (pod_number_t child = tree->nodes[node].first_child; child != POD_TREE_NONE; child = tree->nodes[child].next_sibling)
+	{
+		printf("%.*s%c\n", (int)tree->nodes[child].name_size, tree->nodes[child].name, POD_PATH_SEPARATOR);
+		listed++;
+	}
+
+	pod_number_t child = tree->nodes[node].first_child;
+	for (pod_number_t pos = pod_tree_next_file(tree, node, tree->nodes[node].begin, &child);
+	     pos < tree->nodes[node].end;
+	     pos = pod_tree_next_file(tree, node, pos + 1, &child))
+	{
+		pod_char_t* name = pod_volumes_entry_name(volumes, tree->order[pos]);
+		if (!pod_match_test(match, name))
+			continue;
+		printf("%s\n", name);
+		listed++;
+	}
+
+	return listed;
+}
+
+pod_ssize_t pod_file_list_dir(pod_file_type_t file, pod_path_t dir, pod_match_t* match)
+{
+	pod_volumes_t view;
+	pod_number_t first_entry[2];
+	if (pod_volumes_view(&view, &file, first_entry) == NULL)
+		return -1;
+	return pod_volumes_list_tree(&view, dir, match);
+}
+
+/* where the bytes of entry lie in the archive image, with its uncompressed */
+/* size and compression level; nothing is made resident                   */
+static pod_bool_t pod_file_entry_location(pod_file_type_t file, pod_number_t entry, pod_store_t** store, pod_byte_t** data, pod_number_t* offset, pod_number_t* size, pod_number_t* uncompressed, pod_number_t* level)
+{
+	*level = 0;
+
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			*store = file.pod1->store;
+			*data = file.pod1->data;
+			*offset = file.pod1->entries[entry].offset;
+			*size = file.pod1->entries[entry].size;
 			break;
 		case POD2:
-			file.pod2 = pod_file_pod2_del_entry(file.pod2, entry_number);
+			*store = file.pod2->store;
+			*data = file.pod2->data;
+			*offset = file.pod2->entries[entry].offset;
+			*size = file.pod2->entries[entry].size;
 			break;
 		case POD3:
-			file.pod3 = pod_file_pod3_del_entry(file.pod3, entry_number);
+			*store = file.pod3->store;
+			*data = file.pod3->data;
+			*offset = file.pod3->entries[entry].offset;
+			*size = file.pod3->entries[entry].size;
 			break;
 		case POD4:
-			file.pod4 = pod_file_pod4_del_entry(file.pod4, entry_number);
+			*store = file.pod4->store;
+			*data = file.pod4->data;
+			*offset = file.pod4->entries[entry].offset;
+			*size = file.pod4->entries[entry].size;
+			*uncompressed = file.pod4->entries[entry].uncompressed;
+			*level = file.pod4->entries[entry].compression_level;
 			break;
 		case POD5:
-			file.pod5 = pod_file_pod5_del_entry(file.pod5, entry_number);
+			*store = file.pod5->store;
+			*data = file.pod5->data;
+			*offset = file.pod5->entries[entry].offset;
+			*size = file.pod5->entries[entry].size;
+			*uncompressed = file.pod5->entries[entry].uncompressed;
+			*level = file.pod5->entries[entry].compression_level;
 			break;
 		case POD6:
-			file.pod6 = pod_file_pod6_del_entry(file.pod6, entry_number);
+			*store = file.pod6->store;
+			*data = file.pod6->data;
+			*offset = file.pod6->entries[entry].offset;
+			*size = file.pod6->entries[entry].size;
+			*uncompressed = file.pod6->entries[entry].uncompressed;
+			*level = file.pod6->entries[entry].compression_level;
 			break;
 		case EPD:
-			file.epd = pod_file_epd_del_entry(file.epd, entry_number);
+			*store = file.epd->store;
+			*data = file.epd->data;
+			*offset = file.epd->entries[entry].offset;
+			*size = file.epd->entries[entry].size;
 			break;
 		default:
-			fprintf(stderr, "ERROR: pod_file_entry_data_del() unknown file format!\n");
-			break;
+			return false;
 	}
-	return file;
+
+	if (*level == 0)
+		*uncompressed = *size;
+	return true;
 }
-pod_checksum_t   pod_file_entry_data_chk(pod_file_type_t file, pod_number_t entry_number) {
+
+/* @returns the bytes of entry as stored in the archive made resident and */
+/* its uncompressed size and compression level, NULL if it is unreadable */
+static pod_byte_t* pod_file_entry_stored(pod_file_type_t file, pod_number_t entry, pod_number_t* size, pod_number_t* uncompressed, pod_number_t* level)
+{
+	pod_store_t* store;
+	pod_byte_t* data;
+	pod_number_t offset;
+	if (!pod_file_entry_location(file, entry, &store, &data, &offset, size, uncompressed, level) ||
+	    !pod_store_fetch(store, offset, *size))
+		return NULL;
+	return data + offset;
+}
+
+/* @returns the deflated bytes of entry made resident, NULL if it is stored */
+static pod_byte_t* pod_file_entry_deflated(pod_file_type_t file, pod_number_t entry, pod_number_t* size, pod_number_t* uncompressed)
+{
+	pod_number_t level;
+	pod_byte_t* data = pod_file_entry_stored(file, entry, size, uncompressed, &level);
+	return level > 0 ? data : NULL;
+}
+
+/* @returns the modification time recorded for entry, 0 if the format has none */
+static pod_time_t pod_file_entry_timestamp(pod_file_type_t file, pod_number_t entry)
+{
 	switch (pod_file_typeid(file))
 	{
-		case POD1:
-			return pod_crc_pod1_entry(file.pod1, entry_number);
 		case POD2:
-			return pod_crc_pod2_entry(file.pod2, entry_number);
+			return file.pod2->entries[entry].timestamp;
 		case POD3:
-			return pod_crc_pod3_entry(file.pod3, entry_number);
+			return (pod_time_t)file.pod3->entries[entry].timestamp;
 		case POD4:
-			return pod_crc_pod4_entry(file.pod4, entry_number);
+			return (pod_time_t)file.pod4->entries[entry].timestamp;
 		case POD5:
-			return pod_crc_pod5_entry(file.pod5, entry_number);
-		case POD6:
-			return pod_crc_pod6_entry(file.pod6, entry_number);
+			return (pod_time_t)file.pod5->entries[entry].timestamp;
 		case EPD:
-			return pod_crc_epd_entry(file.epd, entry_number);
+			return (pod_time_t)file.epd->entries[entry].timestamp;
 		default:
-			fprintf(stderr, "ERROR: pod_file_entry_data_chk() unknown file format!\n");
-			break;
+			return 0;
 	}
-	return 0;
 }
+
+/* how an extraction treats files already in the destination */
+enum pod_file_sync_t
+{
+	POD_SYNC_NONE,      /* overwrite every file                            */
+	POD_SYNC_CHANGED,   /* only write files that differ from their entry   */
+	POD_SYNC_PRUNE,     /* as changed, and remove files not in the archive */
+};
+typedef enum pod_file_sync_t pod_file_sync_t;
+
+/* one output file of an extraction, a worker only touches its own job */
+typedef struct pod_file_extract_job_s
+{
+	pod_file_type_t file;   /* volume holding the entry */
+	pod_number_t entry;     /* entry number inside file */
+	pod_string_t path;  /* relative to the destination */
+	pod_bool_t ok;
+	pod_bool_t unchanged;   /* a sync found the file up to date */
+} pod_file_extract_job_t;
+
+/* where a job reads the archive, jobs run in the order of their reads */
+typedef struct pod_file_extract_read_s
+{
+	pod_number_t job;
+	pod_number_t volume;
+	pod_store_t* store;
+	pod_size_t offset;
+	pod_size_t size;
+	pod_number_t window;    /* readahead window holding the read */
+} pod_file_extract_read_t;
+
+/* a stretch of one archive read ahead of the workers */
+typedef struct pod_file_extract_window_s
+{
+	pod_store_t* store;
+	pod_size_t offset;
+	pod_size_t size;
+} pod_file_extract_window_t;
+
+typedef struct pod_file_extract_jobs_s
+{
+	pod_volumes_t* volumes;
+	pod_dest_t* dst;
+	pod_uring_t* ring;      /* NULL writes on pool workers */
+	FILE* tar;              /* set streams the jobs into one tar instead of dst */
+	pod_file_sync_t sync;
+	pod_file_extract_job_t* jobs;
+	pod_number_t count;
+	pod_number_t capacity;
+	pod_file_extract_read_t* reads;     /* count, by volume and offset */
+	pod_file_extract_window_t* windows;
+	pod_number_t window_count;
+} pod_file_extract_jobs_t;
+
+/* the existing output a sync compares an entry against */
+typedef struct pod_file_compare_s
+{
+	FILE* input;
+	pod_size_t compared;
+	pod_bool_t differs;
+	pod_byte_t buffer[POD_SYNC_COMPARE_SIZE];
+} pod_file_compare_t;
+
+/* pod_sink_t matching the entry against the next bytes of the input, */
+/* it stops the entry at the first difference                         */
+static pod_bool_t pod_file_compare_sink(void* context, const pod_byte_t* data, pod_size_t size)
+{
+	pod_file_compare_t* compare = context;
+	while (!compare->differs && size > 0)
+	{
+		pod_size_t chunk = size < sizeof(compare->buffer) ? size : sizeof(compare->buffer);
+		if (fread(compare->buffer, 1, chunk, compare->input) != chunk || memcmp(compare->buffer, data, chunk) != 0)
+			compare->differs = true;
+		compare->compared += chunk;
+		data += chunk;
+		size -= chunk;
+	}
+	return !compare->differs;
+}
+
+/* @returns true if the file of job already holds its entry; a file a sync */
+/* wrote carries the entry timestamp, so size and time settle it without   */
+/* reading, anything else is compared byte by byte and stamped when equal  */
+static pod_bool_t pod_file_extract_unchanged(pod_file_extract_jobs_t* jobs, pod_file_extract_job_t* job)
+{
+	pod_size_t size;
+	pod_time_t mtime;
+	pod_ssize_t expected = pod_file_entry_data_size(job->file, job->entry);
+	if (expected < 0 || !pod_dest_stat(jobs->dst, job->path, &size, &mtime) || size != (pod_size_t)expected)
+		return false;
+
+	pod_time_t timestamp = pod_file_entry_timestamp(job->file, job->entry);
+	if (timestamp > 0 && mtime == timestamp)
+		return true;
+
+	pod_file_compare_t* compare = malloc(sizeof(pod_file_compare_t));
+	if (compare == NULL)
+		return false;
+	compare->input = pod_dest_fopen_read(jobs->dst, job->path);
+	compare->compared = 0;
+	compare->differs = false;
+	if (compare->input == NULL)
+	{
+		free(compare);
+		return false;
+	}
+
+	pod_bool_t same = pod_file_entry_data_stream(job->file, job->entry, pod_file_compare_sink, compare) &&
+	                  !compare->differs && compare->compared == size;
+	fclose(compare->input);
+	free(compare);
+
+	if (same && timestamp > 0)
+		pod_dest_touch(jobs->dst, job->path, timestamp);
+	return same;
+}
+
+static pod_bool_t pod_file_extract_job(void* context, pod_number_t index)
+{
+	pod_file_extract_jobs_t* jobs = context;
+	pod_file_extract_job_t* job = &jobs->jobs[index];
+
+	if (jobs->sync != POD_SYNC_NONE && pod_file_extract_unchanged(jobs, job))
+	{
+		job->unchanged = true;
+		job->ok = true;
+		return true;
+	}
+
+	FILE* output = pod_dest_fopen(jobs->dst, job->path);
+	if (output == NULL)
+		return false;
+
+	job->ok = pod_file_entry_data_write(job->file, job->entry, output);
+	if (fclose(output) != 0)
+	{
+		fprintf(stderr, "ERROR: fclose(%s/%s) failed: %s\n", jobs->dst->path, job->path, strerror(errno));
+		job->ok = false;
+	}
+
+	/* stamped files are recognised by the next sync without reading them */
+	pod_time_t timestamp = pod_file_entry_timestamp(job->file, job->entry);
+	if (job->ok && jobs->sync != POD_SYNC_NONE && timestamp > 0)
+		pod_dest_touch(jobs->dst, job->path, timestamp);
+	return job->ok;
+}
+
+/* start reading the window after the one position opens and release the */
+/* window before the previous one, which the workers are done with       */
+static void pod_file_extract_ahead(pod_file_extract_jobs_t* jobs, pod_number_t position)
+{
+	pod_number_t window = jobs->reads[position].window;
+	if (position > 0 && jobs->reads[position - 1].window == window)
+		return;
+
+	if (window + 1 < jobs->window_count)
+		pod_store_advise(jobs->windows[window + 1].store, jobs->windows[window + 1].offset, jobs->windows[window + 1].size, POD_STORE_WILLNEED);
+	if (window >= 2)
+		pod_store_advise(jobs->windows[window - 2].store, jobs->windows[window - 2].offset, jobs->windows[window - 2].size, POD_STORE_DONTNEED);
+}
+
+/* pod_pool_job_t running the job at position of the read order */
+static pod_bool_t pod_file_extract_read(void* context, pod_number_t position)
+{
+	pod_file_extract_jobs_t* jobs = context;
+	pod_file_extract_ahead(jobs, position);
+	return pod_file_extract_job(context, jobs->reads[position].job);
+}
+
+/* decode one job into memory and queue it on the ring, entries that do not */
+/* fit the in-flight budget are written directly                            */
+static pod_bool_t pod_file_extract_job_uring(void* context, pod_number_t index)
+{
+	pod_file_extract_jobs_t* jobs = context;
+	pod_file_extract_job_t* job = &jobs->jobs[index];
+
+	if (jobs->sync != POD_SYNC_NONE && pod_file_extract_unchanged(jobs, job))
+	{
+		job->unchanged = true;
+		job->ok = true;
+		return true;
+	}
+
+	pod_number_t size, uncompressed, level;
+	pod_byte_t* data = pod_file_entry_stored(job->file, job->entry, &size, &uncompressed, &level);
+	if (data == NULL)
+		return false;
+
+	pod_byte_t* owned = NULL;
+	if (level > 0)
+	{
+		if (uncompressed > POD_URING_INFLIGHT_SIZE)
+			return pod_file_extract_job(context, index);
+
+		/* like the streaming path, bytes that do not inflate are written as stored */
+		owned = malloc(uncompressed > 0 ? uncompressed : 1);
+		if (owned != NULL && pod_codec_inflate_buffer(pod_codec_thread(), data, size, owned, uncompressed, pod_file_entry_name(job->file, job->entry)))
+		{
+			data = owned;
+			size = uncompressed;
+		}
+		else
+		{
+			free(owned);
+			owned = NULL;
+		}
+	}
+
+	return pod_uring_write(jobs->ring, job->path, data, size, owned, &job->ok);
+}
+
+/* stream one job as a tar member, inflating it in a single pass */
+static pod_bool_t pod_file_extract_job_tar(pod_file_extract_jobs_t* jobs, pod_number_t index)
+{
+	pod_file_extract_job_t* job = &jobs->jobs[index];
+
+	pod_char_t name[POD_SYSTEM_PATH_SIZE];
+	pod_number_t size, uncompressed, level;
+	if (!pod_dest_relative(job->path, name, sizeof(name)) ||
+	    pod_file_entry_stored(job->file, job->entry, &size, &uncompressed, &level) == NULL)
+		return false;
+
+	pod_tar_entry_t entry;
+	if (!pod_tar_entry_begin(&entry, jobs->tar, name, uncompressed, pod_file_entry_timestamp(job->file, job->entry)))
+		return false;
+
+	pod_bool_t streamed = pod_file_entry_data_stream(job->file, job->entry, pod_tar_sink, &entry);
+	job->ok = pod_tar_entry_end(&entry) && streamed;
+	return job->ok;
+}
+
+/* queue the files of node below path, creating path once before its */
+/* first file; path holds len bytes and is restored before returning */
+static pod_bool_t pod_file_extract_node(pod_file_extract_jobs_t* jobs, pod_tree_t* tree, pod_number_t node, pod_match_t* match, pod_char_t* path, pod_size_t len)
+{
+	pod_bool_t created = len == 0;
+
+	pod_number_t child = tree->nodes[node].first_child;
+	for (pod_number_t pos = pod_tree_next_file(tree, node, tree->nodes[node].begin, &child);
+	     pos < tree->nodes[node].end;
+	     pos = pod_tree_next_file(tree, node, pos + 1, &child))
+	{
+		pod_number_t entry;
+		pod_file_type_t file = pod_volumes_locate(jobs->volumes, tree->order[pos], &entry);
+		pod_char_t* name = pod_file_entry_name(file, entry);
+		if (!pod_match_test(match, name))
+			continue;
+
+		/* a name that a later volume carries again is left to that volume */
+		if (jobs->volumes->count > 1 && pod_index_find(jobs->volumes->index, name) != (pod_ssize_t)tree->order[pos])
+			continue;
+
+		if (!created && jobs->dst != NULL)
+		{
+			if (!pod_dest_make(jobs->dst, path))
+				return false;
+			created = true;
+		}
+
+		pod_char_t* basename = name;
+		for (pod_char_t* c = name; *c; c++)
+		{
+			if (*c == '\\' || *c == '/')
+				basename = c + 1;
+		}
+
+		if (len + 1 + strlen(basename) >= POD_SYSTEM_PATH_SIZE)
+		{
+			fprintf(stderr, "ERROR: pod_file_extract_node() path of %s too long!\n", name);
+			return false;
+		}
+
+		if (jobs->count == jobs->capacity)
+		{
+			pod_number_t capacity = jobs->capacity ? jobs->capacity * 2 : 64;
+			pod_file_extract_job_t* grown = realloc(jobs->jobs, capacity * sizeof(pod_file_extract_job_t));
+			if (grown == NULL)
+			{
+				fprintf(stderr, "ERROR: pod_file_extract_node() could not allocate %u jobs!\n", capacity);
+				return false;
+			}
+			jobs->jobs = grown;
+			jobs->capacity = capacity;
+		}
+
+		pod_file_extract_job_t* job = &jobs->jobs[jobs->count];
+		job->file = file;
+		job->entry = entry;
+		job->ok = false;
+		job->unchanged = false;
+		job->path = malloc(len + 1 + strlen(basename) + 1);
+		if (job->path == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_file_extract_node() could not allocate path of %s!\n", name);
+			return false;
+		}
+		memcpy(job->path, path, len);
+		pod_size_t sep = len > 0;
+		job->path[len] = '/';
+		strcpy(job->path + len + sep, basename);
+		jobs->count++;
+	}
+
+	for (child = tree->nodes[node].first_child; child != POD_TREE_NONE; child = tree->nodes[child].next_sibling)
+	{
+		pod_tree_node_t* sub = &tree->nodes[child];
+		if (len + 1 + sub->name_size >= POD_SYSTEM_PATH_SIZE)
+		{
+			fprintf(stderr, "ERROR: pod_file_extract_node() path of %.*s too long!\n", (int)sub->name_size, sub->name);
+			return false;
+		}
+		pod_size_t sep = len > 0;
+		path[len] = '/';
+		memcpy(path + len + sep, sub->name, sub->name_size);
+		path[len + sep + sub->name_size] = '\0';
+
+		pod_bool_t ok = pod_file_extract_node(jobs, tree, child, match, path, len + sep + sub->name_size);
+		path[len] = '\0';
+		if (!ok)
+			return false;
+	}
+
+	return true;
+}
+
+static int pod_file_extract_read_compare(const void* a, const void* b)
+{
+	const pod_file_extract_read_t* x = a;
+	const pod_file_extract_read_t* y = b;
+	if (x->volume != y->volume)
+		return x->volume < y->volume ? -1 : 1;
+	if (x->offset != y->offset)
+		return x->offset < y->offset ? -1 : 1;
+	return x->job < y->job ? -1 : x->job > y->job;
+}
+
+/* order the jobs by where their data lies so every archive is read from */
+/* front to back, and cut that order into readahead windows of at most   */
+/* POD_READAHEAD_SIZE bytes that never span a larger gap than            */
+/* POD_READ_RUN_GAP                                                      */
+static pod_bool_t pod_file_extract_plan(pod_file_extract_jobs_t* jobs)
+{
+	jobs->reads = malloc((jobs->count > 0 ? jobs->count : 1) * sizeof(pod_file_extract_read_t));
+	jobs->windows = malloc((jobs->count > 0 ? jobs->count : 1) * sizeof(pod_file_extract_window_t));
+	if (jobs->reads == NULL || jobs->windows == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_extract_plan() could not allocate %u reads!\n", jobs->count);
+		return false;
+	}
+
+	for (pod_number_t i = 0; i < jobs->count; i++)
+	{
+		pod_file_extract_read_t* read = &jobs->reads[i];
+		pod_file_extract_job_t* job = &jobs->jobs[i];
+		pod_byte_t* data;
+		pod_number_t offset, size, uncompressed, level;
+		if (!pod_file_entry_location(job->file, job->entry, &read->store, &data, &offset, &size, &uncompressed, &level))
+		{
+			read->store = NULL;
+			offset = size = 0;
+		}
+
+		read->job = i;
+		read->volume = 0;
+		while (read->volume + 1 < jobs->volumes->count && jobs->volumes->files[read->volume].pod1 != job->file.pod1)
+			read->volume++;
+		read->offset = offset;
+		read->size = size;
+	}
+	qsort(jobs->reads, jobs->count, sizeof(pod_file_extract_read_t), pod_file_extract_read_compare);
+
+	jobs->window_count = 0;
+	pod_file_extract_window_t* window = NULL;
+	for (pod_number_t i = 0; i < jobs->count; i++)
+	{
+		pod_file_extract_read_t* read = &jobs->reads[i];
+		pod_size_t end = read->offset + read->size;
+		if (window == NULL || window->store != read->store || read->offset > window->offset + window->size + POD_READ_RUN_GAP ||
+		    end - window->offset > POD_READAHEAD_SIZE)
+		{
+			window = &jobs->windows[jobs->window_count++];
+			window->store = read->store;
+			window->offset = read->offset;
+			window->size = 0;
+		}
+		if (end > window->offset + window->size)
+			window->size = end - window->offset;
+		read->window = jobs->window_count - 1;
+	}
+
+	return true;
+}
+
+/* @returns the seconds of a wall clock */
+static double pod_file_extract_clock()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/* remove the files below path of jobs->dst that no entry below node of */
+/* tree names, whether selected or not                                   */
+static pod_ssize_t pod_file_extract_prune(pod_file_extract_jobs_t* jobs, pod_tree_t* tree, pod_number_t node, pod_char_t* path)
+{
+	pod_number_t count = tree->nodes[node].end - tree->nodes[node].begin;
+	pod_char_t** keep = calloc(count > 0 ? count : 1, sizeof(pod_char_t*));
+	if (keep == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_extract_prune() could not allocate %u paths!\n", count);
+		return -1;
+	}
+
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	pod_number_t kept = 0;
+	for (pod_number_t pos = tree->nodes[node].begin; pos < tree->nodes[node].end; pos++)
+	{
+		if (pod_dest_relative(pod_volumes_entry_name(jobs->volumes, tree->order[pos]), relative, sizeof(relative)) &&
+		    (keep[kept] = strdup(relative)) != NULL)
+			kept++;
+	}
+
+	pod_ssize_t removed = pod_dest_prune(jobs->dst, path, (const pod_char_t**)keep, kept);
+	for (pod_number_t i = 0; i < kept; i++)
+		free(keep[i]);
+	free(keep);
+	return removed;
+}
+
+/* extract the subtree dir of all volumes on threads workers, or through */
+/* an io_uring when enabled, or as members of tar in name order; the      */
+/* summary is printed afterwards in name order whatever order the files   */
+/* were written in                                                        */
+static pod_ssize_t pod_file_extract_tree(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads, FILE* tar, pod_file_sync_t sync)
+{
+	pod_tree_t* tree = volumes->tree;
+	pod_number_t node = pod_tree_find(tree, dir);
+	if (node == POD_TREE_NONE)
+	{
+		fprintf(stderr, "ERROR: pod_file_extract_tree() no directory %s in archive!\n", dir);
+		return -1;
+	}
+
+	/* files keep their full archive path below dst */
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	pod_size_t len = 0;
+	for (pod_number_t n = node; n != POD_TREE_ROOT; n = tree->nodes[n].parent)
+		len += (len > 0) + tree->nodes[n].name_size;
+	if (len >= sizeof(path))
+	{
+		fprintf(stderr, "ERROR: pod_file_extract_tree() path of %s too long!\n", dir);
+		return -1;
+	}
+
+	path[len] = '\0';
+	pod_size_t end = len;
+	for (pod_number_t n = node; n != POD_TREE_ROOT; n = tree->nodes[n].parent)
+	{
+		end -= tree->nodes[n].name_size;
+		memcpy(path + end, tree->nodes[n].name, tree->nodes[n].name_size);
+		if (end > 0)
+			path[--end] = '/';
+	}
+
+	pod_file_extract_jobs_t jobs = { volumes, NULL, NULL, tar, sync, NULL, 0, 0, NULL, NULL, 0 };
+	if (tar == NULL && (jobs.dst = pod_dest_open(dst)) == NULL)
+		return -1;
+
+	pod_bool_t ok = pod_file_extract_node(&jobs, tree, node, match, path, len);
+
+	if (ok && tar != NULL)
+	{
+		for (pod_number_t i = 0; i < jobs.count; i++)
+			ok = pod_file_extract_job_tar(&jobs, i) && ok;
+	}
+	else if (ok && (ok = pod_file_extract_plan(&jobs)))
+	{
+		double start = pod_file_extract_clock();
+		if (jobs.window_count > 0)
+			pod_store_advise(jobs.windows[0].store, jobs.windows[0].offset, jobs.windows[0].size, POD_STORE_WILLNEED);
+
+		if (pod_uring_is_enabled())
+		{
+			jobs.ring = pod_uring_create(jobs.dst);
+			if (jobs.ring == NULL)
+				fprintf(stderr, "INFO: pod_file_extract_tree() io_uring unavailable, writing on the workers\n");
+		}
+
+		/* ring requests die with the thread that queued them, so the calling */
+		/* thread decodes every job while the kernel writes behind it          */
+		if (jobs.ring != NULL)
+		{
+			for (pod_number_t i = 0; i < jobs.count; i++)
+			{
+				pod_file_extract_ahead(&jobs, i);
+				ok = pod_file_extract_job_uring(&jobs, jobs.reads[i].job) && ok;
+			}
+
+			/* the summary reads job->ok, so every queued write has to finish first */
+			ok = pod_uring_wait(jobs.ring) && ok;
+		}
+		else
+			ok = pod_pool_run(threads > 0 ? threads : pod_pool_cpu_count(), jobs.count, pod_file_extract_read, &jobs);
+
+		for (pod_number_t w = jobs.window_count > 2 ? jobs.window_count - 2 : 0; w < jobs.window_count; w++)
+			pod_store_advise(jobs.windows[w].store, jobs.windows[w].offset, jobs.windows[w].size, POD_STORE_DONTNEED);
+
+		/* files a sync found unchanged by size and time were never read */
+		pod_size_t bytes = 0;
+		for (pod_number_t i = 0; i < jobs.count; i++)
+		{
+			if (!jobs.jobs[jobs.reads[i].job].unchanged)
+				bytes += jobs.reads[i].size;
+		}
+		double seconds = pod_file_extract_clock() - start;
+		double megabytes = (double)bytes / (1024.0 * 1024.0);
+		fprintf(stderr, "INFO: pod_file_extract_tree() read %.1f MB in %u windows in %.3f s, %.1f MB/s\n", megabytes, jobs.window_count, seconds, seconds > 0 ? megabytes / seconds : 0.0);
+	}
+
+	if (jobs.ring != NULL)
+	{
+		jobs.ring = pod_uring_delete(jobs.ring);
+		for (pod_number_t i = 0; ok && i < jobs.count; i++)
+			ok = jobs.jobs[i].ok;
+
+		for (pod_number_t i = 0; jobs.sync != POD_SYNC_NONE && i < jobs.count; i++)
+		{
+			pod_time_t timestamp = pod_file_entry_timestamp(jobs.jobs[i].file, jobs.jobs[i].entry);
+			if (jobs.jobs[i].ok && !jobs.jobs[i].unchanged && timestamp > 0)
+				pod_dest_touch(jobs.dst, jobs.jobs[i].path, timestamp);
+		}
+	}
+
+	/* only a complete sync may decide what no longer belongs to the archive */
+	pod_ssize_t removed = 0;
+	if (ok && sync == POD_SYNC_PRUNE)
+		ok = (removed = pod_file_extract_prune(&jobs, tree, node, path)) >= 0;
+
+	pod_ssize_t extracted = 0;
+	pod_number_t unchanged = 0;
+	for (pod_number_t i = 0; i < jobs.count; i++)
+	{
+		if (jobs.jobs[i].unchanged)
+		{
+			unchanged++;
+			extracted++;
+		}
+		else if (jobs.jobs[i].ok)
+		{
+			pod_char_t* name = pod_file_entry_name(jobs.jobs[i].file, jobs.jobs[i].entry);
+			if (tar != NULL)
+				fprintf(stderr, "%s -> %s\n", name, jobs.jobs[i].path);
+			else
+				fprintf(stderr, "%s -> %s/%s\n", name, jobs.dst->path, jobs.jobs[i].path);
+			extracted++;
+		}
+		free(jobs.jobs[i].path);
+	}
+	free(jobs.jobs);
+	free(jobs.reads);
+	free(jobs.windows);
+	pod_dest_close(jobs.dst);
+
+	if (sync != POD_SYNC_NONE)
+		fprintf(stderr, "INFO: pod_file_extract_tree() %u unchanged, %zd written, %zd removed\n", unchanged, extracted - unchanged, removed);
+	return ok ? extracted : -1;
+}
+
+pod_bool_t pod_file_inflate_bench(pod_file_type_t file, pod_number_t rounds)
+{
+	pod_number_t count = pod_file_entry_count(file);
+	pod_number_t entries = 0;
+	pod_number_t largest = 0;
+	pod_size_t bytes = 0;
+
+	/* one untimed pass makes every entry resident before the clock runs */
+	for (pod_number_t i = 0; i < count; i++)
+	{
+		pod_number_t size, uncompressed;
+		if (pod_file_entry_deflated(file, i, &size, &uncompressed) == NULL)
+			continue;
+		entries++;
+		bytes += uncompressed;
+		if (uncompressed > largest)
+			largest = uncompressed;
+	}
+
+	if (entries == 0)
+	{
+		fprintf(stderr, "ERROR: pod_file_inflate_bench() archive has no compressed entries!\n");
+		return false;
+	}
+
+	pod_byte_t* buffer = malloc(largest > 0 ? largest : 1);
+	pod_codec_t* codec = pod_codec_create();
+	if (buffer == NULL || codec == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_inflate_bench() out of memory!\n");
+		free(buffer);
+		pod_codec_delete(codec);
+		return false;
+	}
+
+	if (rounds == 0)
+		rounds = 1;
+	printf("%u compressed entries, %zu bytes inflated, %u rounds\n", entries, bytes, rounds);
+
+	pod_bool_t ok = true;
+	for (pod_number_t b = 0; b < pod_codec_backend_count(); b++)
+	{
+		const pod_codec_backend_t* backend = pod_codec_backend_get(b);
+		pod_number_t failed = 0;
+
+		clock_t start = clock();
+		for (pod_number_t round = 0; round < rounds; round++)
+		{
+			for (pod_number_t i = 0; i < count; i++)
+			{
+				pod_number_t size, uncompressed;
+				pod_byte_t* data = pod_file_entry_deflated(file, i, &size, &uncompressed);
+				if (data != NULL && !pod_codec_inflate_buffer_with(codec, backend, data, size, buffer, uncompressed, pod_file_entry_name(file, i)))
+					failed++;
+			}
+		}
+		double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		double megabytes = (double)bytes * rounds / (1024.0 * 1024.0);
+
+		printf("%-12s %10.3f s %10.1f MB/s %8u failed\n", backend->name, seconds, seconds > 0 ? megabytes / seconds : 0.0, failed);
+		ok = ok && failed == 0;
+	}
+
+	free(buffer);
+	pod_codec_delete(codec);
+	return ok;
+}
+
+pod_bool_t pod_file_open_bench(pod_path_t name, pod_number_t rounds)
+{
+	static const pod_char_t* mode_names[POD_OPEN_MODE_SIZE] = { "read", "mmap", "lazy" };
+
+	/* one untimed open checks the archive and warms the page cache */
+	pod_file_type_t file = pod_file_open(name, -1, POD_OPEN_READ);
+	if (file.pod1 == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_open_bench() could not open %s!\n", name);
+		return false;
+	}
+	pod_number_t entries = pod_file_entry_count(file);
+	pod_file_delete(file);
+
+	if (rounds == 0)
+		rounds = 1;
+	printf("%u entries, %u rounds, sidecar %s\n", entries, rounds, pod_cache_is_enabled() ? "enabled" : "disabled");
+
+	for (pod_number_t mode = 0; mode < POD_OPEN_MODE_SIZE; mode++)
+	{
+		/* lazy and mapped opens block on I/O, which process time misses */
+		double start = pod_file_extract_clock();
+		for (pod_number_t round = 0; round < rounds; round++)
+		{
+			file = pod_file_open(name, -1, (pod_open_mode_t)mode);
+			if (file.pod1 == NULL)
+			{
+				fprintf(stderr, "ERROR: pod_file_open_bench() %s open of %s failed!\n", mode_names[mode], name);
+				return false;
+			}
+			pod_file_delete(file);
+		}
+		double seconds = pod_file_extract_clock() - start;
+
+		printf("%-12s %10.3f s %10.3f ms per open\n", mode_names[mode], seconds, seconds * 1000.0 / rounds);
+	}
+	return true;
+}
+
+pod_ssize_t pod_file_extract_dir(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst)
+{
+	return pod_file_extract_parallel(file, dir, match, dst, 1);
+}
+
+pod_ssize_t pod_file_extract_parallel(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads)
+{
+	pod_volumes_t* volumes = pod_volumes_create(file);
+	if (volumes == NULL)
+		return -1;
+	pod_ssize_t extracted = pod_volumes_extract(volumes, dir, match, dst, threads);
+	pod_volumes_delete(volumes);
+	return extracted;
+}
+
+pod_ssize_t pod_file_extract_sync(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads, pod_bool_t prune)
+{
+	pod_volumes_t* volumes = pod_volumes_create(file);
+	if (volumes == NULL)
+		return -1;
+	pod_ssize_t extracted = pod_volumes_sync(volumes, dir, match, dst, threads, prune);
+	pod_volumes_delete(volumes);
+	return extracted;
+}
+
+pod_ssize_t pod_file_extract_tar(pod_file_type_t file, pod_path_t dir, pod_match_t* match, FILE* output)
+{
+	pod_volumes_t* volumes = pod_volumes_create(file);
+	if (volumes == NULL)
+		return -1;
+	pod_ssize_t extracted = pod_volumes_extract_tar(volumes, dir, match, output);
+	pod_volumes_delete(volumes);
+	return extracted;
+}
+
+/* @returns the archive the volume file continues in, NULL after the last */
+static pod_char_t* pod_file_next_archive(pod_file_type_t file)
+{
+	pod_char_t* next_archive = NULL;
+	if (pod_file_typeid(file) == POD5)
+		next_archive = file.pod5->header->next_archive;
+	else if (pod_file_typeid(file) == POD6)
+		next_archive = file.pod6->header->next_archive;
+	return next_archive != NULL && next_archive[0] != '\0' ? next_archive : NULL;
+}
+
+static pod_open_mode_t pod_file_open_mode(pod_file_type_t file)
+{
+	pod_store_t* store = NULL;
+	if (pod_file_typeid(file) == POD5)
+		store = file.pod5->store;
+	else if (pod_file_typeid(file) == POD6)
+		store = file.pod6->store;
+	return store != NULL ? store->mode : POD_OPEN_READ;
+}
+
+static pod_string_t pod_file_filename(pod_file_type_t file)
+{
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			return file.pod1->filename;
+		case POD2:
+			return file.pod2->filename;
+		case POD3:
+			return file.pod3->filename;
+		case POD4:
+			return file.pod4->filename;
+		case POD5:
+			return file.pod5->filename;
+		case POD6:
+			return file.pod6->filename;
+		case EPD:
+			return file.epd->filename;
+		default:
+			return NULL;
+	}
+}
+
+pod_volumes_t* pod_volumes_create(pod_file_type_t file)
+{
+	if (file.pod1 == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_create(file == NULL)\n");
+		return NULL;
+	}
+
+	pod_volumes_t* volumes = calloc(1, sizeof(pod_volumes_t));
+	pod_number_t capacity = 4;
+	if (volumes == NULL || (volumes->files = malloc(capacity * sizeof(pod_file_type_t))) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_create() could not allocate volumes!\n");
+		free(volumes);
+		return NULL;
+	}
+	volumes->files[volumes->count++] = file;
+
+	/* every volume is opened the way the first one was */
+	pod_open_mode_t mode = pod_file_open_mode(file);
+	for (pod_char_t* next_archive = pod_file_next_archive(file); next_archive != NULL;
+	     next_archive = pod_file_next_archive(volumes->files[volumes->count - 1]))
+	{
+		for (pod_number_t i = 0; i < volumes->count; i++)
+		{
+			pod_string_t filename = pod_file_filename(volumes->files[i]);
+			if (filename != NULL && strcmp(filename, next_archive) == 0)
+			{
+				fprintf(stderr, "ERROR: pod_volumes_create() next archive %s loops back!\n", next_archive);
+				return pod_volumes_delete(volumes);
+			}
+		}
+
+		if (volumes->count == capacity)
+		{
+			pod_file_type_t* grown = realloc(volumes->files, capacity * 2 * sizeof(pod_file_type_t));
+			if (grown == NULL)
+			{
+				fprintf(stderr, "ERROR: pod_volumes_create() could not allocate %u volumes!\n", capacity * 2);
+				return pod_volumes_delete(volumes);
+			}
+			volumes->files = grown;
+			capacity *= 2;
+		}
+
+		fprintf(stderr, "INFO: pod_volumes_create() next archive: %s\n", next_archive);
+		pod_file_type_t next = pod_file_open(next_archive, -1, mode);
+		if (next.pod1 == NULL)
+			return pod_volumes_delete(volumes);
+		volumes->files[volumes->count++] = next;
+	}
+
+	volumes->first_entry = malloc((volumes->count + 1) * sizeof(pod_number_t));
+	if (volumes->first_entry == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_create() could not allocate volumes!\n");
+		return pod_volumes_delete(volumes);
+	}
+	for (pod_number_t i = 0; i < volumes->count; i++)
+	{
+		volumes->first_entry[i] = volumes->entries;
+		volumes->entries += pod_file_entry_count(volumes->files[i]);
+	}
+	volumes->first_entry[volumes->count] = volumes->entries;
+
+	/* a lone archive keeps using its own index and tree */
+	if (volumes->count == 1)
+	{
+		volumes->index = pod_file_index(file);
+		volumes->tree = pod_file_tree(file);
+		if (volumes->index == NULL || volumes->tree == NULL)
+			return pod_volumes_delete(volumes);
+		return volumes;
+	}
+
+	/* later volumes replace what earlier ones carried under the same */
+	/* name, so their names go in first and win the index              */
+	const pod_char_t** names = malloc((volumes->entries > 0 ? volumes->entries : 1) * sizeof(pod_char_t*));
+	volumes->index = pod_index_create(volumes->entries);
+	if (names == NULL || volumes->index == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_create() could not allocate an index of %u entries!\n", volumes->entries);
+		free(names);
+		return pod_volumes_delete(volumes);
+	}
+	for (pod_number_t v = volumes->count; v-- > 0;)
+	{
+		for (pod_number_t i = 0; i < pod_file_entry_count(volumes->files[v]); i++)
+		{
+			pod_number_t entry = volumes->first_entry[v] + i;
+			names[entry] = pod_file_entry_name(volumes->files[v], i);
+			if (!pod_index_insert(volumes->index, names[entry], entry))
+			{
+				free(names);
+				return pod_volumes_delete(volumes);
+			}
+		}
+	}
+
+	volumes->tree = pod_tree_create(names, volumes->entries);
+	free(names);
+	if (volumes->tree == NULL)
+		return pod_volumes_delete(volumes);
+	return volumes;
+}
+
+pod_volumes_t* pod_volumes_open(pod_path_t name, pod_open_mode_t mode)
+{
+	pod_file_type_t file = pod_file_open(name, -1, mode);
+	if (file.pod1 == NULL)
+		return NULL;
+
+	pod_volumes_t* volumes = pod_volumes_create(file);
+	if (volumes == NULL)
+	{
+		pod_file_delete(file);
+		return NULL;
+	}
+	volumes->owns_first = true;
+	return volumes;
+}
+
+pod_volumes_t* pod_volumes_delete(pod_volumes_t* volumes)
+{
+	if (volumes == NULL)
+		return NULL;
+
+	if (volumes->count > 1)
+	{
+		pod_index_delete(volumes->index);
+		pod_tree_delete(volumes->tree);
+	}
+	for (pod_number_t i = volumes->owns_first ? 0 : 1; i < volumes->count; i++)
+		pod_file_delete(volumes->files[i]);
+
+	free(volumes->files);
+	free(volumes->first_entry);
+	free(volumes);
+	return NULL;
+}
+
+pod_char_t* pod_volumes_entry_name(pod_volumes_t* volumes, pod_number_t entry)
+{
+	pod_number_t file_entry;
+	if (volumes == NULL || entry >= volumes->entries)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_entry_name(entry >= entries)\n");
+		return NULL;
+	}
+	pod_file_type_t file = pod_volumes_locate(volumes, entry, &file_entry);
+	return pod_file_entry_name(file, file_entry);
+}
+
+pod_ssize_t pod_volumes_entry_find(pod_volumes_t* volumes, pod_path_t entry_name)
+{
+	return volumes != NULL ? pod_index_find(volumes->index, entry_name) : -1;
+}
+
+pod_file_type_t pod_volumes_entry_file(pod_volumes_t* volumes, pod_number_t entry, pod_number_t* file_entry)
+{
+	if (volumes == NULL || entry >= volumes->entries)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_entry_file(entry >= entries)\n");
+		pod_file_type_t none = { NULL };
+		return none;
+	}
+	return pod_volumes_locate(volumes, entry, file_entry);
+}
+
+pod_bool_t pod_volumes_print(pod_volumes_t* volumes, pod_match_t* match)
+{
+	if (volumes == NULL)
+		return false;
+	if (volumes->count == 1)
+		return pod_file_print(volumes->files[0], match);
+
+	/* entries replaced by a later volume are marked with a * */
+	printf("\nEntries:\n");
+	for (pod_number_t v = 0; v < volumes->count; v++)
+	{
+		pod_file_type_t file = volumes->files[v];
+		for (pod_number_t i = 0; i < pod_file_entry_count(file); i++)
+		{
+			pod_number_t entry = volumes->first_entry[v] + i;
+			pod_char_t* name = pod_file_entry_name(file, i);
+			if (!pod_match_test(match, name))
+				continue;
+			pod_bool_t replaced = pod_index_find(volumes->index, name) != (pod_ssize_t)entry;
+			printf("%10u %10zd %4u%c %s\n", entry, pod_file_entry_data_size(file, i), v, replaced ? '*' : ' ', name);
+		}
+	}
+
+	printf("\nVolumes:\n");
+	for (pod_number_t v = 0; v < volumes->count; v++)
+		printf("%4u %10u %10u %s\n", v, volumes->first_entry[v], volumes->first_entry[v + 1] - volumes->first_entry[v], pod_file_filename(volumes->files[v]));
+
+	return true;
+}
+
+pod_ssize_t pod_volumes_list_dir(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match)
+{
+	return volumes != NULL ? pod_volumes_list_tree(volumes, dir, match) : -1;
+}
+
+pod_ssize_t pod_volumes_extract(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads)
+{
+	return volumes != NULL ? pod_file_extract_tree(volumes, dir, match, dst, threads, NULL, POD_SYNC_NONE) : -1;
+}
+
+pod_ssize_t pod_volumes_sync(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads, pod_bool_t prune)
+{
+	return volumes != NULL ? pod_file_extract_tree(volumes, dir, match, dst, threads, NULL, prune ? POD_SYNC_PRUNE : POD_SYNC_CHANGED) : -1;
+}
+
+pod_ssize_t pod_volumes_extract_tar(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, FILE* output)
+{
+	if (volumes == NULL || output == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_volumes_extract_tar(volumes == NULL || output == NULL)\n");
+		return -1;
+	}
+
+	/* the archive is ended even after errors so the members so far stay readable */
+	pod_ssize_t extracted = pod_file_extract_tree(volumes, dir, match, NULL, 1, output, POD_SYNC_NONE);
+	if (!pod_tar_close(output))
+		return -1;
+	return extracted;
+}
+
+/* write the .podidx sidecar of an archive parsed without one */
+static pod_bool_t pod_file_cache_save(pod_file_type_t file)
+{
+	pod_index_t** ref = pod_file_index_ref(file);
+	if (ref == NULL || *ref != NULL)
+		return true;
+
+	pod_cache_t cache = { 0 };
+	pod_string_t filename = NULL;
+	pod_store_t* store = NULL;
+	pod_byte_t* data = NULL;
+	pod_byte_t* data_start = NULL;
+	pod_size_t size = 0;
+	pod_number_t* checksum = NULL;
+	pod_bool_t* checksum_valid = NULL;
+	int type = pod_file_typeid(file);
+
+	switch (type)
+	{
+		case POD1:
+			filename = file.pod1->filename;
+			store = file.pod1->store;
+			data = file.pod1->data;
+			size = file.pod1->size;
+			checksum = &file.pod1->checksum;
+			checksum_valid = &file.pod1->checksum_valid;
+			data_start = file.pod1->entry_data;
+			cache.entry_data_size = file.pod1->entry_data_size;
+			break;
+		case POD2:
+			filename = file.pod2->filename;
+			store = file.pod2->store;
+			data = file.pod2->data;
+			size = file.pod2->size;
+			checksum = &file.pod2->checksum;
+			checksum_valid = &file.pod2->checksum_valid;
+			data_start = file.pod2->entry_data;
+			cache.entry_data_size = file.pod2->entry_data_size;
+			break;
+		case POD3:
+			filename = file.pod3->filename;
+			store = file.pod3->store;
+			data = file.pod3->data;
+			size = file.pod3->size;
+			checksum = &file.pod3->checksum;
+			checksum_valid = &file.pod3->checksum_valid;
+			data_start = file.pod3->data_start;
+			cache.entry_data_size = file.pod3->entry_data_size;
+			cache.gap_sizes = file.pod3->gap_sizes;
+			cache.gap_count = file.pod3->header->file_count;
+			break;
+		case POD4:
+			filename = file.pod4->filename;
+			store = file.pod4->store;
+			data = file.pod4->data;
+			size = file.pod4->size;
+			checksum = &file.pod4->checksum;
+			checksum_valid = &file.pod4->checksum_valid;
+			data_start = file.pod4->data_start;
+			cache.entry_data_size = file.pod4->entry_data_size;
+			cache.gap_sizes = file.pod4->gap_sizes;
+			cache.gap_count = file.pod4->header->file_count;
+			break;
+		case POD5:
+			filename = file.pod5->filename;
+			store = file.pod5->store;
+			data = file.pod5->data;
+			size = file.pod5->size;
+			checksum = &file.pod5->checksum;
+			checksum_valid = &file.pod5->checksum_valid;
+			data_start = file.pod5->data_start;
+			cache.entry_data_size = file.pod5->entry_data_size;
+			cache.gap_sizes = file.pod5->gap_sizes;
+			cache.gap_count = file.pod5->header->file_count;
+			break;
+		case POD6:
+			filename = file.pod6->filename;
+			store = file.pod6->store;
+			data = file.pod6->data;
+			size = file.pod6->size;
+			checksum = &file.pod6->checksum;
+			checksum_valid = &file.pod6->checksum_valid;
+			data_start = file.pod6->data_start;
+			cache.entry_data_size = file.pod6->entry_data_size;
+			cache.gap_sizes = file.pod6->gap_sizes;
+			cache.gap_count = file.pod6->header->file_count;
+			break;
+		case EPD:
+			filename = file.epd->filename;
+			store = file.epd->store;
+			data = file.epd->data;
+			size = file.epd->size;
+			checksum = &file.epd->checksum;
+			checksum_valid = &file.epd->checksum_valid;
+			data_start = file.epd->data_start;
+			cache.entry_data_size = file.epd->entry_data_size;
+			cache.gap_sizes = file.epd->gap_sizes;
+			cache.gap_count = file.epd->header->file_count;
+			break;
+		default:
+			fprintf(stderr, "ERROR: pod_file_cache_save() unknown file format!\n");
+			return false;
+	}
+
+	/* mapped archives skipped the checksum, pay for it once here */
+	if (store != NULL)
+	{
+		if (!pod_store_fetch(store, 0, size))
+			return false;
+		*checksum = pod_crc(data, size);
+		*checksum_valid = true;
+	}
+
+	cache.checksum = *checksum;
+	cache.entries = pod_file_entry_count(file);
+	cache.data_start = data_start ? data_start - data : 0;
+	cache.index = pod_file_index(file);
+	if (cache.index == NULL)
+		return false;
+
+	return pod_cache_save(filename, POD_HEADER_SIZE[type], &cache);
+}
+
+pod_byte_t* pod_file_entry_data_get(pod_file_type_t file, pod_path_t entry_name, pod_number_t entry_number) {
+	if (entry_name != NULL)
+	{
+		pod_ssize_t found = pod_file_entry_find(file, entry_name);
+		if (found < 0)
+			return NULL;
+		entry_number = found;
+	}
+
+	if (entry_number >= pod_file_entry_count(file))
+	{
+		fprintf(stderr, "ERROR: pod_file_entry_data_get(entry_number >= file_count)\n");
+		return NULL;
+	}
+
+	/* makes the entry bytes resident for lazily opened archives */
+	pod_number_t size;
+	pod_number_t uncompressed;
+	pod_number_t level;
+	return pod_file_entry_stored(file, entry_number, &size, &uncompressed, &level);
+}
+
+pod_file_type_t  pod_file_entry_data_add(pod_file_type_t file, void* entry, pod_string_t filename, pod_byte_t* data) {
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			file.pod1 = pod_file_pod1_add_entry(file.pod1, entry, filename, data);
+			break;
+		case POD2:
+			file.pod2 = pod_file_pod2_add_entry(file.pod2, entry, filename, data);
+			break;
+		case POD3:
+			file.pod3 = pod_file_pod3_add_entry(file.pod3, entry, filename, data);
+			break;
+		case POD4:
+			file.pod4 = pod_file_pod4_add_entry(file.pod4, entry, filename, data);
+			break;
+		case POD5:
+			file.pod5 = pod_file_pod5_add_entry(file.pod5, entry, filename, data);
+			break;
+		case POD6:
+			file.pod6 = pod_file_pod6_add_entry(file.pod6, entry, filename, data);
+			break;
+		case EPD:
+			file.epd = pod_file_epd_add_entry(file.epd, entry, filename, data);
+			break;
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_data_add() unknown file format!\n");
+			break;
+	}
+	return file;
+}
+pod_file_type_t  pod_file_entry_data_del(pod_file_type_t file, pod_number_t entry_number) {
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			file.pod1 = pod_file_pod1_del_entry(file.pod1, entry_number);
+			break;
+		case POD2:
+			file.pod2 = pod_file_pod2_del_entry(file.pod2, entry_number);
+			break;
+		case POD3:
+			file.pod3 = pod_file_pod3_del_entry(file.pod3, entry_number);
+			break;
+		case POD4:
+			file.pod4 = pod_file_pod4_del_entry(file.pod4, entry_number);
+			break;
+		case POD5:
+			file.pod5 = pod_file_pod5_del_entry(file.pod5, entry_number);
+			break;
+		case POD6:
+			file.pod6 = pod_file_pod6_del_entry(file.pod6, entry_number);
+			break;
+		case EPD:
+			file.epd = pod_file_epd_del_entry(file.epd, entry_number);
+			break;
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_data_del() unknown file format!\n");
+			break;
+	}
+	return file;
+}
+pod_checksum_t   pod_file_entry_data_chk(pod_file_type_t file, pod_number_t entry_number) {
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			return pod_crc_pod1_entry(file.pod1, entry_number);
+		case POD2:
+			return pod_crc_pod2_entry(file.pod2, entry_number);
+		case POD3:
+			return pod_crc_pod3_entry(file.pod3, entry_number);
+		case POD4:
+			return pod_crc_pod4_entry(file.pod4, entry_number);
+		case POD5:
+			return pod_crc_pod5_entry(file.pod5, entry_number);
+		case POD6:
+			return pod_crc_pod6_entry(file.pod6, entry_number);
+		case EPD:
+			return pod_crc_epd_entry(file.epd, entry_number);
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_data_chk() unknown file format!\n");
+			break;
+	}
+	return 0;
+}
+pod_bool_t       pod_file_entry_data_stream(pod_file_type_t file, pod_number_t entry_number, pod_sink_t sink, void* context) {
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			return pod_file_pod1_stream_entry(file.pod1, entry_number, sink, context);
+		case POD2:
+			return pod_file_pod2_stream_entry(file.pod2, entry_number, sink, context);
+		case POD3:
+			return pod_file_pod3_stream_entry(file.pod3, entry_number, sink, context);
+		case POD4:
+			return pod_file_pod4_stream_entry(file.pod4, entry_number, sink, context);
+		case POD5:
+			return pod_file_pod5_stream_entry(file.pod5, entry_number, sink, context);
+		case POD6:
+			return pod_file_pod6_stream_entry(file.pod6, entry_number, sink, context);
+		case EPD:
+			return pod_file_epd_stream_entry(file.epd, entry_number, sink, context);
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_data_stream() unknown file format!\n");
+			return false;
+	}
+}
+
+pod_bool_t       pod_file_entry_data_write(pod_file_type_t file, pod_number_t entry_number, FILE* output) {
+	switch (pod_file_typeid(file))
+	{
+		case POD1:
+			return pod_file_pod1_write_entry(file.pod1, entry_number, output);
+		case POD2:
+			return pod_file_pod2_write_entry(file.pod2, entry_number, output);
+		case POD3:
+			return pod_file_pod3_write_entry(file.pod3, entry_number, output);
+		case POD4:
+			return pod_file_pod4_write_entry(file.pod4, entry_number, output);
+		case POD5:
+			return pod_file_pod5_write_entry(file.pod5, entry_number, output);
+		case POD6:
+			return pod_file_pod6_write_entry(file.pod6, entry_number, output);
+		case EPD:
+			return pod_file_epd_write_entry(file.epd, entry_number, output);
+		default:
+			fprintf(stderr, "ERROR: pod_file_entry_data_write() unknown file format!\n");
+			return false;
+	}
+}
+
+/* a resolved batched read, sorted by offset */
+typedef struct pod_file_read_slot_s
+{
+	pod_number_t offset;
+	pod_number_t size;
+	pod_number_t read;
+} pod_file_read_slot_t;
+
+static int pod_file_read_slot_compare(const void* a, const void* b)
+{
+	const pod_file_read_slot_t* x = a;
+	const pod_file_read_slot_t* y = b;
+	if (x->offset != y->offset)
+		return x->offset < y->offset ? -1 : 1;
+	return x->read < y->read ? -1 : x->read > y->read;
+}
+
+/* decompress one resolved read into its buffer */
+static pod_bool_t pod_file_read_one(pod_file_type_t file, pod_file_read_t* read, pod_codec_t* codec)
+{
+	pod_store_t* store;
+	pod_byte_t* data;
+	pod_number_t offset, size, uncompressed, level;
+	pod_file_entry_location(file, read->entry, &store, &data, &offset, &size, &uncompressed, &level);
+
+	read->size = uncompressed;
+	if (read->buffer == NULL)
+		return true;
+	if (read->buffer_size < uncompressed)
+	{
+		fprintf(stderr, "ERROR: pod_file_read_one(%s) needs %u bytes, buffer has %zu!\n", pod_file_entry_name(file, read->entry), uncompressed, read->buffer_size);
+		return false;
+	}
+
+	if (!pod_store_fetch(store, offset, size))
+		return false;
+	if (level > 0)
+		return pod_codec_inflate_buffer(codec, data + offset, size, read->buffer, uncompressed, pod_file_entry_name(file, read->entry));
+	memcpy(read->buffer, data + offset, size);
+	return true;
+}
+
+pod_ssize_t      pod_file_entry_data_size(pod_file_type_t file, pod_number_t entry_number) {
+	if (entry_number >= pod_file_entry_count(file))
+	{
+		fprintf(stderr, "ERROR: pod_file_entry_data_size(entry_number >= file_count)\n");
+		return -1;
+	}
+
+	pod_store_t* store;
+	pod_byte_t* data;
+	pod_number_t offset, size, uncompressed, level;
+	if (!pod_file_entry_location(file, entry_number, &store, &data, &offset, &size, &uncompressed, &level))
+		return -1;
+	return uncompressed;
+}
+
+pod_ssize_t      pod_file_entry_data_read(pod_file_type_t file, pod_number_t entry_number, pod_byte_t* buffer, pod_size_t buffer_size) {
+	pod_file_read_t read = { NULL, entry_number, buffer, buffer_size, 0, false };
+	if (pod_file_entry_data_read_many(file, &read, 1) != 1)
+		return -1;
+	return read.size;
+}
+
+pod_ssize_t      pod_file_entry_data_read_many(pod_file_type_t file, pod_file_read_t* reads, pod_number_t count) {
+	if (reads == NULL && count > 0)
+	{
+		fprintf(stderr, "ERROR: pod_file_entry_data_read_many(reads == NULL)\n");
+		return -1;
+	}
+
+	pod_file_read_slot_t* slots = malloc((count > 0 ? count : 1) * sizeof(pod_file_read_slot_t));
+	if (slots == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_entry_data_read_many() could not allocate %u reads!\n", count);
+		return -1;
+	}
+
+	/* resolve every request, the ones that fail stay out of the schedule */
+	pod_number_t entries = pod_file_entry_count(file);
+	pod_number_t valid = 0;
+	pod_store_t* store = NULL;
+	pod_byte_t* data;
+	for (pod_number_t i = 0; i < count; i++)
+	{
+		pod_file_read_t* read = &reads[i];
+		read->ok = false;
+		read->size = 0;
+		if (read->name != NULL)
+		{
+			pod_ssize_t found = pod_file_entry_find(file, read->name);
+			if (found < 0)
+			{
+				fprintf(stderr, "ERROR: pod_file_entry_data_read_many() no entry %s!\n", read->name);
+				continue;
+			}
+			read->entry = (pod_number_t)found;
+		}
+		if (read->entry >= entries)
+		{
+			fprintf(stderr, "ERROR: pod_file_entry_data_read_many(entry %u >= file_count)\n", read->entry);
+			continue;
+		}
+
+		pod_number_t uncompressed, level;
+		pod_file_read_slot_t* slot = &slots[valid];
+		if (!pod_file_entry_location(file, read->entry, &store, &data, &slot->offset, &slot->size, &uncompressed, &level))
+			continue;
+		slot->read = i;
+		valid++;
+	}
+
+	/* serve the reads in archive order, neighbours are fetched together */
+	/* so a lazy store reads each run with one call                      */
+	qsort(slots, valid, sizeof(pod_file_read_slot_t), pod_file_read_slot_compare);
+	pod_codec_t* codec = pod_codec_thread();
+	pod_ssize_t served = 0;
+	for (pod_number_t first = 0; first < valid;)
+	{
+		pod_size_t start = slots[first].offset;
+		pod_size_t end = start + slots[first].size;
+		pod_number_t last = first + 1;
+		while (last < valid && slots[last].offset <= end + POD_READ_RUN_GAP &&
+		       (pod_size_t)slots[last].offset + slots[last].size - start <= POD_READ_RUN_SIZE)
+		{
+			if ((pod_size_t)slots[last].offset + slots[last].size > end)
+				end = (pod_size_t)slots[last].offset + slots[last].size;
+			last++;
+		}
+
+		pod_bool_t fetched = pod_store_fetch(store, start, end - start);
+		for (; first < last; first++)
+		{
+			pod_file_read_t* read = &reads[slots[first].read];
+			read->ok = fetched && pod_file_read_one(file, read, codec);
+			served += read->ok;
+		}
+	}
+
+	free(slots);
+	return served;
+}
+
 pod_ssize_t      pod_file_entry_data_ext(pod_file_type_t file, pod_number_t entry_number, pod_path_t dst) {
 	switch (pod_file_typeid(file))
 	{
@@ -33,8 +33,35 @@ typedef union pod_entry_type_u
 	pod_entry_epd_t*  epd;
 } pod_entry_type_t;
 
+/* a POD5/POD6 archive together with every volume its next_archive chain */
+/* continues in, entries are numbered across the volumes in chain order   */
+/* and a name resolves to its last occurrence, the copy extracting the    */
+/* volumes one after another would leave behind                           */
+typedef struct pod_volumes_s
+{
+	pod_file_type_t* files;     /* files[0] is the archive the chain starts at */
+	pod_number_t count;
+	pod_number_t* first_entry;  /* number of the first entry of each volume, count + 1 */
+	pod_number_t entries;
+	pod_index_t* index;
+	pod_tree_t* tree;
+	pod_bool_t owns_first;      /* files[0] is deleted with the volumes */
+} pod_volumes_t;
+
+/* one request of a batched read, by name if set otherwise by entry number */
+typedef struct pod_file_read_s
+{
+	pod_path_t name;
+	pod_number_t entry;
+	pod_byte_t* buffer;      /* caller memory, NULL only asks for size */
+	pod_size_t buffer_size;
+	pod_size_t size;         /* out: decompressed size of the entry */
+	pod_bool_t ok;           /* out */
+} pod_file_read_t;
+
 pod_bool_t       pod_file_is_pod(pod_path_t name);
 pod_file_type_t  pod_file_create(pod_path_t name, pod_ident_type_t type);
+pod_file_type_t  pod_file_open(pod_path_t name, pod_ident_type_t type, pod_open_mode_t mode);
 pod_file_type_t  pod_file_delete(pod_file_type_t file);
 pod_checksum_t   pod_file_chksum(pod_file_type_t file);
 int              pod_file_typeid(pod_file_type_t file);
@@ -43,13 +70,64 @@ void             pod_file_crc(pod_file_type_t file);
 pod_ssize_t      pod_file_write(pod_file_type_t file, pod_path_t dst_name);
 pod_file_type_t  pod_file_reset(pod_file_type_t file);
 pod_file_type_t  pod_file_merge(pod_file_type_t file, pod_file_type_t src);
-pod_bool_t       pod_file_print(pod_file_type_t file, pod_char_t* pattern);
-pod_ssize_t pod_file_extract(pod_file_type_t file, pod_char_t* pattern, pod_path_t dst);
-pod_ssize_t pod_file_count(pod_file_type_t file, pod_char_t* pattern);
+pod_bool_t       pod_file_print(pod_file_type_t file, pod_match_t* match);
+/* extract this volume only, pod_file_extract_parallel() follows split archives */
+pod_ssize_t pod_file_extract(pod_file_type_t file, pod_match_t* match, pod_path_t dst);
+pod_ssize_t pod_file_count(pod_file_type_t file, pod_match_t* match);
+/* list or extract one directory of the archive, "" is the root; */
+/* extraction follows split archives                             */
+pod_ssize_t pod_file_list_dir(pod_file_type_t file, pod_path_t dir, pod_match_t* match);
+pod_ssize_t pod_file_extract_dir(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst);
+/* extract on threads workers, 0 uses every processor; follows split archives */
+pod_ssize_t pod_file_extract_parallel(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads);
+/* like pod_file_extract_parallel() but only rewrite files that differ from */
+/* their entry, prune also removes files below dir the archive lacks        */
+pod_ssize_t pod_file_extract_sync(pod_file_type_t file, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads, pod_bool_t prune);
+/* stream the selected files below dir as a POSIX tar to output, e.g. stdout */
+pod_ssize_t pod_file_extract_tar(pod_file_type_t file, pod_path_t dir, pod_match_t* match, FILE* output);
+/* time every inflate backend on the compressed entries, prints MB/s */
+pod_bool_t pod_file_inflate_bench(pod_file_type_t file, pod_number_t rounds);
+/* time opening name rounds times in every open mode, directory parsing and */
+/* layout analysis included; warm opens are timed if the sidecar is enabled */
+pod_bool_t pod_file_open_bench(pod_path_t name, pod_number_t rounds);
+
+/* open the archive name and every volume after it with mode */
+pod_volumes_t*   pod_volumes_open(pod_path_t name, pod_open_mode_t mode);
+/* open the volumes after file, which stays owned by the caller */
+pod_volumes_t*   pod_volumes_create(pod_file_type_t file);
+pod_volumes_t*   pod_volumes_delete(pod_volumes_t* volumes);
+pod_char_t*      pod_volumes_entry_name(pod_volumes_t* volumes, pod_number_t entry_number);
+pod_ssize_t      pod_volumes_entry_find(pod_volumes_t* volumes, pod_path_t entry_name);
+/* @returns the volume holding entry_number and its number in there */
+pod_file_type_t  pod_volumes_entry_file(pod_volumes_t* volumes, pod_number_t entry_number, pod_number_t* file_entry);
+pod_bool_t       pod_volumes_print(pod_volumes_t* volumes, pod_match_t* match);
+pod_ssize_t      pod_volumes_list_dir(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match);
+/* extract all volumes in one run on threads workers, 0 uses every processor */
+pod_ssize_t      pod_volumes_extract(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads);
+pod_ssize_t      pod_volumes_sync(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, pod_path_t dst, pod_number_t threads, pod_bool_t prune);
+pod_ssize_t      pod_volumes_extract_tar(pod_volumes_t* volumes, pod_path_t dir, pod_match_t* match, FILE* output);
 
 /* access entries by name and/or number */
+pod_number_t     pod_file_entry_count(pod_file_type_t file);
+pod_char_t*      pod_file_entry_name(pod_file_type_t file, pod_number_t entry_number);
+pod_index_t*     pod_file_index(pod_file_type_t file);
+pod_tree_t*      pod_file_tree(pod_file_type_t file);
+pod_ssize_t      pod_file_entry_find(pod_file_type_t file, pod_path_t entry_name);
 pod_byte_t*      pod_file_entry_data_get(pod_file_type_t file, pod_path_t entry_name, pod_number_t entry_number);
 pod_file_type_t  pod_file_entry_data_add(pod_file_type_t file, void* entry, pod_string_t filename, pod_byte_t* data);
 pod_file_type_t  pod_file_entry_data_del(pod_file_type_t file, pod_number_t entry_number);
 pod_checksum_t   pod_file_entry_data_chk(pod_file_type_t file, pod_number_t entry_number);
 pod_ssize_t      pod_file_entry_data_ext(pod_file_type_t file, pod_number_t entry_number, pod_path_t dst);
+/* hand the (decompressed) data of one entry to sink in bounded pieces */
+pod_bool_t       pod_file_entry_data_stream(pod_file_type_t file, pod_number_t entry_number, pod_sink_t sink, void* context);
+/* write the (decompressed) data of one entry to output at its position */
+pod_bool_t       pod_file_entry_data_write(pod_file_type_t file, pod_number_t entry_number, FILE* output);
+/* decompressed size of one entry, -1 if there is no such entry */
+pod_ssize_t      pod_file_entry_data_size(pod_file_type_t file, pod_number_t entry_number);
+/* decompress one entry into buffer, @returns its size or -1 on errors and */
+/* if buffer is smaller than pod_file_entry_data_size()                    */
+pod_ssize_t      pod_file_entry_data_read(pod_file_type_t file, pod_number_t entry_number, pod_byte_t* buffer, pod_size_t buffer_size);
+/* serve count reads in archive offset order, fetching neighbouring entries */
+/* together; every read gets its size and ok even if others fail           */
+/* @returns the number of reads that succeeded, -1 if none could be tried   */
+pod_ssize_t      pod_file_entry_data_read_many(pod_file_type_t file, pod_file_read_t* reads, pod_number_t count);
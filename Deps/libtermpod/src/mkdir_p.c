@@ -1,6 +1,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #ifdef _WIN32
 #include <Windows.h>
 #else
@@ -17,7 +18,7 @@ int mkdir_p(const char* dirname, const int mode)
 {
     if (dirname == NULL) {
         return -1;
-	} else if (dirname == ".") {
+	} else if (strcmp(dirname, ".") == 0) {
         return 0;
     }
     char* p;
@@ -25,12 +26,12 @@ int mkdir_p(const char* dirname, const int mode)
     bool ret = true;
     
     temp = calloc(1, strlen(dirname) + 1);
-    p = strdup(dirname);
+    p = (char*)dirname;
     
 #ifdef _WIN32
     /* Skip Windows drive letter. */
-    if ((p = strchr(dirname, ':')) != NULL) {
-        p++;
+    if (strchr(dirname, ':') != NULL) {
+        p = strchr(dirname, ':') + 1;
     }
 #endif
 
@@ -42,7 +43,7 @@ int mkdir_p(const char* dirname, const int mode)
     while ((p = strchr(p, SEP)) != NULL) {
         /* Skip empty elements. Could be a Windows UNC path or
            just multiple separators which is okay. */
-        if (p != dirname && *(p - 1) == SEP) {
+        if (p == dirname || *(p - 1) == SEP) {
             p++;
             continue;
         }
@@ -78,12 +79,10 @@ int mkdir_p(const char* dirname, const int mode)
     if (mkdir(dirname, mode) != 0) {
         if (errno != EEXIST) {
             ret = false;
-            break;
         }
     }
 #endif
 
     free(temp);
-    free(p);
     return ret ? 0 : -1;
 }
@@ -14,6 +14,9 @@ pod_checksum_t pod_crc_pod1(pod_file_pod1_t* file)
 		return 0;
 	}
 
+	if(!pod_store_fetch(file->store, 0, file->size))
+		return 0;
+
 	return pod_crc(file->data + POD_IDENT_SIZE + POD_HEADER_CHECKSUM_SIZE, file->size - POD_IDENT_SIZE - POD_HEADER_CHECKSUM_SIZE);
 }
 
@@ -25,6 +28,9 @@ pod_checksum_t pod_crc_pod1_entry(pod_file_pod1_t* file, pod_number_t entry_inde
 		return 0;
 	}
 
+	if(!pod_store_fetch(file->store, file->entries[entry_index].offset, file->entries[entry_index].size))
+		return 0;
+
 	return pod_crc(file->data + file->entries[entry_index].offset, file->entries[entry_index].size);
 }
  
@@ -35,6 +41,11 @@ pod_checksum_t   pod_file_pod1_chksum(pod_file_pod1_t* podfile)
 }
 
 pod_file_pod1_t* pod_file_pod1_create(pod_string_t filename)
+{
+	return pod_file_pod1_open(filename, POD_OPEN_READ);
+}
+
+pod_file_pod1_t* pod_file_pod1_open(pod_string_t filename, pod_open_mode_t mode)
 {
 	pod_file_pod1_t* pod_file = calloc(1, sizeof(pod_file_pod1_t));
 
@@ -59,48 +70,42 @@ pod_file_pod1_t* pod_file_pod1_create(pod_string_t filename)
 		return pod_file;
 	}
 
-	struct stat sb;
-	if(stat(filename, &sb) != 0 || sb.st_size == 0)
-	{
-		perror("stat");
-		return NULL;
-	}
-
-	pod_file->filename = calloc(1, strlen(filename));
-	pod_file->filename = strcpy(pod_file->filename, filename);
-	pod_file->size = sb.st_size;
+	pod_file->filename = strdup(filename);
+	pod_file->data = pod_store_load(filename, mode, &pod_file->store, &pod_file->size);
 
-	FILE* file = fopen(filename, "rb");
-
-	if(!file)
+	if(!pod_file->data)
 	{
-		fprintf(stderr, "ERROR: Could not open POD file: %s\n", filename);
+		fprintf(stderr, "ERROR: Could not load POD file %s!\n", filename);
+		pod_file_pod1_delete(pod_file);
 		return NULL;
 	}
 
-	pod_file->data = calloc(1, pod_file->size);
+	size_t data_pos = 0;
+	pod_file->header = (pod_header_pod1_t*)pod_file->data;
 
-	if(!pod_file->data)
+	/* lazy archives only read the header and the directory */
+	if(!pod_store_fetch(pod_file->store, 0, POD_HEADER_POD1_SIZE) ||
+	   !pod_store_fetch(pod_file->store, POD_HEADER_POD1_SIZE, pod_file->header->file_count * POD_DIR_ENTRY_POD1_SIZE))
 	{
-		fprintf(stderr, "ERROR: Could not allocate memory of size %zu for file %s!\n", pod_file->size, filename);
-		fclose(file);
+		fprintf(stderr, "ERROR: Could not read POD1 directory of %s!\n", filename);
 		pod_file_pod1_delete(pod_file);
 		return NULL;
 	}
 
-	if(fread(pod_file->data, POD_BYTE_SIZE, pod_file->size, file) != pod_file->size * POD_BYTE_SIZE)
+	/* warm opens take checksum and name index from the sidecar, */
+	/* mapped archives skip the whole file pass                  */
+	pod_cache_t* cache = pod_cache_load(filename, pod_file->data, POD_HEADER_POD1_SIZE, pod_file->header->file_count);
+	pod_file->checksum_valid = cache != NULL || pod_file->store == NULL;
+	if(cache != NULL)
 	{
-		fprintf(stderr, "ERROR: Could not read file %s!\n", filename);
-		fclose(file);
-		pod_file_pod1_delete(pod_file);
-		return NULL;
+		pod_file->checksum = cache->checksum;
+		pod_file->index = cache->index;
+		cache->index = NULL;
+		cache = pod_cache_delete(cache);
 	}
+	else if(pod_file->store == NULL)
+		pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
 
-	fclose(file);
-	pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
-
-	size_t data_pos = 0;
-	pod_file->header = (pod_header_pod1_t*)pod_file->data;
 	data_pos += POD_HEADER_POD1_SIZE;
 	pod_file->entries = (pod_entry_pod1_t*)(pod_file->data + data_pos);
 	data_pos += pod_file->header->file_count * POD_DIR_ENTRY_POD1_SIZE;
@@ -139,6 +144,16 @@ bool pod_file_pod1_add_entry(pod_file_pod1_t* pod_file, pod_entry_pod1_t* entry,
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_add_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	size_t new_entry_size = POD_DIR_ENTRY_POD1_SIZE;
 	size_t new_entry_data_size = entry->size;
 	size_t new_path_data_size = strlen(filename) + 1;
@@ -181,6 +196,16 @@ bool pod_file_pod1_del_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_del_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	if (entry_index >= pod_file->header->file_count)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod1_del_entry(entry_index >= pod_file->header->file_count)\n");
@@ -221,6 +246,50 @@ pod_entry_pod1_t* pod_file_pod1_get_entry(pod_file_pod1_t* pod_file, pod_number_
 	return &pod_file->entries[entry_index];
 }
 
+bool pod_file_pod1_stream_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context)
+{
+	if (pod_file == NULL || sink == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_stream_entry(pod_file == NULL || sink == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_stream_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	pod_entry_pod1_t* entry = &pod_file->entries[entry_index];
+	if (!pod_store_fetch(pod_file->store, entry->offset, entry->size))
+		return false;
+
+	return sink(context, pod_file->data + entry->offset, entry->size);
+}
+
+bool pod_file_pod1_write_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, FILE* file)
+{
+	if (pod_file == NULL || file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_write_entry(pod_file == NULL || file == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_write_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	/* stored bytes go from the archive fd to file inside the kernel */
+	pod_entry_pod1_t* entry = &pod_file->entries[entry_index];
+	pod_ssize_t copied = pod_store_copy(pod_file->store, entry->offset, entry->size, file);
+	if (copied != 0)
+		return copied > 0;
+
+	return pod_file_pod1_stream_entry(pod_file, entry_index, pod_sink_file, file);
+}
+
 bool pod_file_pod1_extract_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, pod_string_t dst)
 {
 	if (pod_file == NULL)
@@ -243,17 +312,13 @@ bool pod_file_pod1_extract_entry(pod_file_pod1_t* pod_file, pod_number_t entry_i
 		return false;
 	}
 
-	pod_entry_pod1_t* entry = &pod_file->entries[entry_index];
-
-	if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
+	bool ok = pod_file_pod1_write_entry(pod_file, entry_index, file);
+	if (fclose(file) != 0)
 	{
-		fprintf(stderr, "ERROR: pod_file_pod1_extract_entry(fwrite failed!\n");
-		fclose(file);
-		return false;
+		fprintf(stderr, "ERROR: pod_file_pod1_extract_entry(fclose(%s) failed: %s\n", dst, strerror(errno));
+		ok = false;
 	}
-
-	fclose(file);
-	return true;
+	return ok;
 }
 
 bool pod_file_pod1_write(pod_file_pod1_t* pod_file, pod_string_t filename)
@@ -263,6 +328,12 @@ bool pod_file_pod1_write(pod_file_pod1_t* pod_file, pod_string_t filename)
 		fprintf(stderr, "ERROR: pod_file or filename equals NULL!\n");
 		return false;
 	}
+
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod1_write() archive is mapped read-only!\n");
+		return false;
+	}
 	
 	size_t new_total_size = pod_file->size + pod_file->header->file_count * POD_DIR_ENTRY_POD1_SIZE;
 	void* new_data = realloc(pod_file->data, new_total_size);
@@ -297,108 +368,51 @@ bool pod_file_pod1_write(pod_file_pod1_t* pod_file, pod_string_t filename)
 
 /* Extract POD1 file pod_file to directory dst                       */
 /* @returns true on success otherwise false and leaves errno         */
-bool pod_file_pod1_extract(pod_file_pod1_t* pod_file, pod_string_t pattern, pod_string_t dst)
+bool pod_file_pod1_extract(pod_file_pod1_t* pod_file, pod_match_t* match, pod_string_t dst)
 {
-	pod_bool_t absolute = false;
-	if(pod_file == NULL)
+	if (pod_file == NULL)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod1_extract(pod_file == NULL)\n");
 		return false;
 	}
 
-	if(dst == NULL) { dst = "./"; }
-
-	pod_char_t cwd[POD_SYSTEM_PATH_SIZE];
-	getcwd(cwd, sizeof(cwd));
-	printf("cwd: %s\n",cwd);
-	pod_path_t root = pod_path_system_root();
-
-	printf("root: %s\n",root);
-	pod_path_t path = NULL;
-
-	if(absolute)
-	{
-		path = pod_path_append(root, dst);
-		if(!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", root, dst);
-			free(root);
-			return false;
-		}
-	}
-	else
-	{
-		path = pod_path_append(cwd, dst);
-		if(!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", cwd, dst);
-			free(root);
-			return false;
-		}
-	}
-
-	printf("path: %s\n", path);
-	/* create and change to destination directory */
-	if(mkdir_p(path, ACCESSPERMS) != 0)
-	{
-		fprintf(stderr, "mkdir_p(\"%s\", \'%c\') = %s\n", dst, '/', strerror(errno));
+	/* entries are created relative to dst, the working directory stays */
+	pod_dest_t* dir = pod_dest_open(dst);
+	if (dir == NULL)
 		return false;
-	}
-
-	if(chdir(path) != 0)
-	{
-		fprintf(stderr, "chdir(%s) = %s\n", path, strerror(errno));
-		return false;
-	}
 
 	/* extract entries */
-	for(int i = 0; i < pod_file->header->file_count; i++)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		if (pattern && strstr(pod_file->entries[i].name, pattern) == NULL)
+		pod_char_t* filename = pod_file->entries[i].name;
+		if (!pod_match_test(match, filename))
 			continue;
 
-		char* basename = strdup(pod_file->entries[i].name);
-		if (!basename)
+		/* open and create directories including parents */
+		FILE* file = pod_dest_fopen(dir, filename);
+		if (file == NULL)
 		{
-			fprintf(stderr, "ERROR: strdup(filename) failed!\n");
+			pod_dest_close(dir);
 			return false;
 		}
-		char* p = basename;
-		while (*p)
-		{
-			if (*p == '/' || *p == '\\')
-			{
-				basename = p + 1;
-			}
-			p++;
-		}
 
-		/* open and create directories including parents */
-		if(strlen(basename) > 0 && mkdir_p(pod_path_append(path, basename), ACCESSPERMS) != 0)
+		bool ok = pod_file_pod1_write_entry(pod_file, i, file);
+		if (fclose(file) != 0)
 		{
-			fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", basename, strerror(errno));
-			return false;
+			fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", filename, strerror(errno));
+			ok = false;
 		}
-		FILE* file = fopen(pod_file->entries[i].name, "wb");
-		if(file == NULL)
+		if (!ok)
 		{
-			fprintf(stderr, "ERROR: pod_fopen_mkdir(%s) failed: %s\n", pod_file->entries[i].name, strerror(errno));
-			return false;
-		}
-		if(fwrite(pod_file->data + pod_file->entries[i].offset, pod_file->entries[i].size, 1, file) != 1)
-		{
-			fprintf(stderr, "ERROR: fwrite failed!\n");
-			fclose(file);
+			pod_dest_close(dir);
 			return false;
 		}
 
 		/* Debug/Info print thingy */
-		fprintf(stderr, "%s -> %s\n", pod_file->entries[i].name, pod_path_append(path, pod_file->entries[i].name));
-
-		/* clean up and pop */
-		fclose(file);
+		fprintf(stderr, "%s -> %s/%s\n", filename, dir->path, filename);
 	}
-	chdir(cwd);
+
+	pod_dest_close(dir);
 	return true;
 }
 
@@ -406,6 +420,13 @@ pod_file_pod1_t* pod_file_pod1_delete(pod_file_pod1_t* pod_file)
 {
 	if(pod_file)
 	{
+		pod_file->index = pod_index_delete(pod_file->index);
+		pod_file->tree = pod_tree_delete(pod_file->tree);
+		if(pod_file->store)
+		{
+			pod_file->store = pod_store_close(pod_file->store);
+			pod_file->data = NULL;
+		}
 		if(pod_file->data)
 		{
 			free(pod_file->data);
@@ -425,7 +446,7 @@ pod_file_pod1_t* pod_file_pod1_delete(pod_file_pod1_t* pod_file)
 	return pod_file;
 }
 
-bool pod_file_pod1_print(pod_file_pod1_t* pod_file, pod_char_t* pattern)
+bool pod_file_pod1_print(pod_file_pod1_t* pod_file, pod_match_t* match)
 {
 	if(pod_file == NULL)
 	{
@@ -438,7 +459,7 @@ bool pod_file_pod1_print(pod_file_pod1_t* pod_file, pod_char_t* pattern)
 	for(pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
 		pod_entry_pod1_t* entry = &pod_file->entries[i];
-		if (pattern && strstr(entry->name, pattern) == NULL)
+		if (!pod_match_test(match, entry->name))
 			continue;
 		printf("%10u 0x%.8X/%.10u 0x%.8X/%10u %s\n",
 		       	i,
@@ -448,8 +469,9 @@ bool pod_file_pod1_print(pod_file_pod1_t* pod_file, pod_char_t* pattern)
 	}
 
 	/* print file summary */
-	printf("\nSummary:\nfile checksum      : 0x%.8X\nsize               : %zu\nfilename           : %s\nformat             : %s\ncomment            : %s\nfile entries       : 0x%.8X/%.10u\n",
-		pod_file->checksum,
+	pod_char_t file_checksum[POD_CHECKSUM_STRING_SIZE];
+	printf("\nSummary:\nfile checksum      : %s\nsize               : %zu\nfilename           : %s\nformat             : %s\ncomment            : %s\nfile entries       : 0x%.8X/%.10u\n",
+		pod_checksum_str(file_checksum, "0x%.8X", pod_file->checksum, pod_file->checksum_valid),
 		pod_file->size,
 		pod_file->filename,
 		pod_type_desc_str(POD1),
@@ -54,7 +54,11 @@ typedef struct pod_file_pod_s
 	pod_string_t filename;
 	pod_size_t size;
 	pod_number_t checksum;
+	pod_bool_t checksum_valid; /* false if a mapped or lazy open skipped the file pass */
 	pod_byte_t* data;
+	pod_store_t* store; /* NULL unless the archive is mapped */
+	pod_index_t* index; /* name lookup, built on first use */
+	pod_tree_t* tree; /* directory tree, built on first use */
 	/* end of not serialized content */
 } pod_file_pod1_t;
 
@@ -63,14 +67,17 @@ uint32_t pod_crc_pod1(pod_file_pod1_t* file);
 uint32_t pod_crc_pod1_entry(pod_file_pod1_t* file, pod_number_t entry_index);
 uint32_t pod_crc_pod1_audit(pod_file_pod1_t* file, pod_number_t audit_index);
 pod_file_pod1_t* pod_file_pod1_create(pod_string_t filename);
+pod_file_pod1_t* pod_file_pod1_open(pod_string_t filename, pod_open_mode_t mode);
 pod_file_pod1_t* pod_file_pod1_delete(pod_file_pod1_t* podfile);
 pod_checksum_t   pod_file_pod1_chksum(pod_file_pod1_t* podfile);
-bool pod_file_pod1_print(pod_file_pod1_t* podfile, pod_char_t* pattern);
+bool pod_file_pod1_print(pod_file_pod1_t* podfile, pod_match_t* match);
 bool pod_file_pod1_write(pod_file_pod1_t* pod_file, pod_string_t filename);
 bool pod_audit_entry_pod1_print(pod_audit_entry_pod1_t* audit);
 bool pod_file_pod1_add_entry(pod_file_pod1_t* pod_file, pod_entry_pod1_t* entry, pod_string_t filename, pod_byte_t* data);
 bool pod_file_pod1_del_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index);
 pod_entry_pod1_t* pod_file_pod1_get_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index);
+bool pod_file_pod1_stream_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context);
+bool pod_file_pod1_write_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, FILE* file);
 bool pod_file_pod1_extract_entry(pod_file_pod1_t* pod_file, pod_number_t entry_index, pod_string_t dst);
-bool pod_file_pod1_extract(pod_file_pod1_t* pod_file, pod_string_t pattern, pod_string_t dst);
+bool pod_file_pod1_extract(pod_file_pod1_t* pod_file, pod_match_t* match, pod_string_t dst);
 #endif
@@ -11,6 +11,9 @@ pod_checksum_t pod_crc_pod2(pod_file_pod2_t* file)
 		return 0;
 	}
 
+	if(!pod_store_fetch(file->store, 0, file->size))
+		return 0;
+
 	return pod_crc(file->data + POD_IDENT_SIZE + POD_HEADER_CHECKSUM_SIZE, file->size - POD_IDENT_SIZE - POD_HEADER_CHECKSUM_SIZE);
 }
 
@@ -22,6 +25,9 @@ pod_checksum_t pod_crc_pod2_entry(pod_file_pod2_t* file, pod_number_t entry_inde
 		return 0;
 	}
 
+	if(!pod_store_fetch(file->store, file->entries[entry_index].offset, file->entries[entry_index].size))
+		return 0;
+
 	return pod_crc(file->data + file->entries[entry_index].offset, file->entries[entry_index].size);
 }
  
@@ -55,7 +61,7 @@ bool pod_audit_entry_pod2_print(pod_audit_entry_pod2_t* audit)
 	return true;
 }
 
-bool pod_file_pod2_print(pod_file_pod2_t* pod_file, pod_char_t* pattern)
+bool pod_file_pod2_print(pod_file_pod2_t* pod_file, pod_match_t* match)
 {
 	if(pod_file == NULL)
 	{
@@ -63,19 +69,23 @@ bool pod_file_pod2_print(pod_file_pod2_t* pod_file, pod_char_t* pattern)
 		return false;
 	}
 
+	/* lazy archives list without touching entry data */
+	pod_bool_t lazy = pod_store_is_lazy(pod_file->store);
+	pod_char_t checksum[POD_CHECKSUM_STRING_SIZE];
+
 	/* print entries */
 	printf("\nEntries:\n");
 	for(pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
 		pod_entry_pod2_t* entry = &pod_file->entries[i];
 		pod_char_t* name = pod_file->path_data + entry->path_offset;
-		if (pattern && strstr(name, pattern) == NULL)
+		if (!pod_match_test(match, name))
 			continue;
-		printf("%10u %10u %.8X/%.8X %10u %s %s %10u\n",
+		printf("%10u %10u %.8X/%s %10u %s %s %10u\n",
 		       	i,
 			entry->offset,
 			entry->checksum,
-			pod_crc_pod2_entry(pod_file, i),
+			pod_checksum_str(checksum, "%.8X", lazy ? 0 : pod_crc_pod2_entry(pod_file, i), !lazy),
 			entry->size,
 			pod_ctime(&entry->timestamp),
 			name,
@@ -95,14 +105,15 @@ bool pod_file_pod2_print(pod_file_pod2_t* pod_file, pod_char_t* pattern)
 	}
 
 	/* print file summary */
-	printf("\nSummary:\nfile checksum      : 0x%.8X\nsize               : %zu\nfilename           : %s\nformat             : %s\ncomment            : %s\ndata checksum      : 0x%.8X/0x%.8X\nfile entries       : 0x%.8X/%.10u\naudit entries      : 0x%.8X/%.10u\n",
-		pod_file->checksum,
+	pod_char_t file_checksum[POD_CHECKSUM_STRING_SIZE];
+	printf("\nSummary:\nfile checksum      : %s\nsize               : %zu\nfilename           : %s\nformat             : %s\ncomment            : %s\ndata checksum      : 0x%.8X/%s\nfile entries       : 0x%.8X/%.10u\naudit entries      : 0x%.8X/%.10u\n",
+		pod_checksum_str(file_checksum, "0x%.8X", pod_file->checksum, pod_file->checksum_valid),
 		pod_file->size,
 		pod_file->filename,
 		pod_type_desc_str(pod_type(pod_file->header->ident)),
 		pod_file->header->comment,
 		pod_file->header->checksum,
-		pod_crc_pod2(pod_file),
+		pod_checksum_str(checksum, "0x%.8X", lazy ? 0 : pod_crc_pod2(pod_file), !lazy),
 		pod_file->header->file_count,pod_file->header->file_count,
 		pod_file->header->audit_file_count,pod_file->header->audit_file_count);
 
@@ -114,6 +125,13 @@ pod_file_pod2_t* pod_file_pod2_delete(pod_file_pod2_t* podfile)
 {
 	if(podfile != NULL)
 	{
+		podfile->index = pod_index_delete(podfile->index);
+		podfile->tree = pod_tree_delete(podfile->tree);
+		if(podfile->store)
+		{
+			podfile->store = pod_store_close(podfile->store);
+			podfile->data = NULL;
+		}
 		if(podfile->data)
 		{
 			free(podfile->data);
@@ -140,6 +158,11 @@ pod_file_pod2_t* pod_file_pod2_delete(pod_file_pod2_t* podfile)
 }
 
 pod_file_pod2_t* pod_file_pod2_create(pod_string_t filename)
+{
+	return pod_file_pod2_open(filename, POD_OPEN_READ);
+}
+
+pod_file_pod2_t* pod_file_pod2_open(pod_string_t filename, pod_open_mode_t mode)
 {
 	pod_file_pod2_t* pod_file = calloc(1, sizeof(pod_file_pod2_t));
 
@@ -166,46 +189,40 @@ pod_file_pod2_t* pod_file_pod2_create(pod_string_t filename)
 		return pod_file;
 	}
 
-	struct stat sb;
-	if(stat(filename, &sb) != 0 || sb.st_size == 0)
-	{
-		perror("stat");
-		return NULL;
-	}
-
-	pod_file->filename = calloc(1, strlen(filename));
-	pod_file->filename = strcpy(pod_file->filename, filename);
-	pod_file->size = sb.st_size;
+	pod_file->filename = strdup(filename);
+	pod_file->data = pod_store_load(filename, mode, &pod_file->store, &pod_file->size);
 
-	FILE* file = fopen(filename, "rb");
-
-	if(!file)
+	if(!pod_file->data)
 	{
-		fprintf(stderr, "ERROR: Could not open POD file: %s\n", filename);
-		return NULL;
+		fprintf(stderr, "ERROR: Could not load POD file %s!\n", filename);
+		return pod_file_pod2_delete(pod_file);
 	}
 
-	pod_file->data = calloc(1, pod_file->size);
+	size_t data_pos = 0;
+	pod_file->header = (pod_header_pod2_t*)pod_file->data;
 
-	if(!pod_file->data)
+	/* lazy archives only read the header, directory, path table and audit trail */
+	if(!pod_store_fetch(pod_file->store, 0, POD_HEADER_POD2_SIZE) ||
+	   !pod_store_fetch(pod_file->store, POD_HEADER_POD2_SIZE, pod_file->header->file_count * POD_DIR_ENTRY_POD2_SIZE))
 	{
-		fprintf(stderr, "ERROR: Could not allocate memory of size %zu for file %s!\n", pod_file->size, filename);
-		fclose(file);
+		fprintf(stderr, "ERROR: Could not read POD2 directory of %s!\n", filename);
 		return pod_file_pod2_delete(pod_file);
 	}
 
-	if(fread(pod_file->data, POD_BYTE_SIZE, pod_file->size, file) != pod_file->size * POD_BYTE_SIZE)
+	/* warm opens take checksum and name index from the sidecar, */
+	/* mapped archives skip the whole file pass                  */
+	pod_cache_t* cache = pod_cache_load(filename, pod_file->data, POD_HEADER_POD2_SIZE, pod_file->header->file_count);
+	pod_file->checksum_valid = cache != NULL || pod_file->store == NULL;
+	if(cache != NULL)
 	{
-		fprintf(stderr, "ERROR: Could not read file %s!\n", filename);
-		fclose(file);
-		return pod_file_pod2_delete(pod_file);
+		pod_file->checksum = cache->checksum;
+		pod_file->index = cache->index;
+		cache->index = NULL;
+		cache = pod_cache_delete(cache);
 	}
+	else if(pod_file->store == NULL)
+		pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
 
-	fclose(file);
-	pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
-
-	size_t data_pos = 0;
-	pod_file->header = (pod_header_pod2_t*)pod_file->data;
 	data_pos += POD_HEADER_POD2_SIZE;
 	pod_file->entries = (pod_entry_pod2_t*)(pod_file->data + data_pos);
 	data_pos += pod_file->header->file_count * POD_DIR_ENTRY_POD2_SIZE;
@@ -235,6 +252,13 @@ pod_file_pod2_t* pod_file_pod2_create(pod_string_t filename)
 		}
 	}
 
+	/* path table sits between the directory and the first entry */
+	if(pod_file->header->file_count > 0 && pod_file->entries[min_entry_index].offset > data_pos &&
+	   !pod_store_fetch(pod_file->store, data_pos, pod_file->entries[min_entry_index].offset - data_pos))
+	{
+		fprintf(stderr, "ERROR: Could not read POD2 path table of %s!\n", filename);
+		return pod_file_pod2_delete(pod_file);
+	}
 
 	pod_file->path_data = (pod_char_t*) (pod_file->data + data_pos);
 	size_t max_path_len = strlen(pod_file->path_data + pod_file->entries[max_path_index].path_offset) + 1;
@@ -252,6 +276,12 @@ pod_file_pod2_t* pod_file_pod2_create(pod_string_t filename)
 
 	pod_file->audit_trail = (pod_audit_entry_pod2_t*)(pod_file->data + data_pos);
 
+	if(!pod_store_fetch(pod_file->store, data_pos, pod_file->header->audit_file_count * POD_AUDIT_ENTRY_POD2_SIZE))
+	{
+		fprintf(stderr, "ERROR: Could not read POD2 audit trail of %s!\n", filename);
+		return pod_file_pod2_delete(pod_file);
+	}
+
 	return pod_file;
 }
 
@@ -263,6 +293,16 @@ bool pod_file_pod2_add_entry(pod_file_pod2_t* pod_file, pod_entry_pod2_t* entry,
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_add_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	size_t new_entry_size = POD_DIR_ENTRY_POD2_SIZE;
 	size_t new_entry_data_size = entry->size;
 	size_t new_path_data_size = strlen(filename) + 1;
@@ -315,6 +355,16 @@ bool pod_file_pod2_del_entry(pod_file_pod2_t* pod_file, pod_number_t entry_index
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_del_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	if (entry_index >= pod_file->header->file_count)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod2_del_entry(entry_index >= pod_file->header->file_count)\n");
@@ -355,6 +405,50 @@ pod_entry_pod2_t* pod_file_pod2_get_entry(pod_file_pod2_t* pod_file, pod_number_
 	return &pod_file->entries[entry_index];
 }
 
+bool pod_file_pod2_stream_entry(pod_file_pod2_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context)
+{
+	if (pod_file == NULL || sink == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_stream_entry(pod_file == NULL || sink == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_stream_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	pod_entry_pod2_t* entry = &pod_file->entries[entry_index];
+	if (!pod_store_fetch(pod_file->store, entry->offset, entry->size))
+		return false;
+
+	return sink(context, pod_file->data + entry->offset, entry->size);
+}
+
+bool pod_file_pod2_write_entry(pod_file_pod2_t* pod_file, pod_number_t entry_index, FILE* file)
+{
+	if (pod_file == NULL || file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_write_entry(pod_file == NULL || file == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_write_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	/* stored bytes go from the archive fd to file inside the kernel */
+	pod_entry_pod2_t* entry = &pod_file->entries[entry_index];
+	pod_ssize_t copied = pod_store_copy(pod_file->store, entry->offset, entry->size, file);
+	if (copied != 0)
+		return copied > 0;
+
+	return pod_file_pod2_stream_entry(pod_file, entry_index, pod_sink_file, file);
+}
+
 bool pod_file_pod2_extract_entry(pod_file_pod2_t* pod_file, pod_number_t entry_index, pod_string_t dst)
 {
 	if (pod_file == NULL)
@@ -377,16 +471,13 @@ bool pod_file_pod2_extract_entry(pod_file_pod2_t* pod_file, pod_number_t entry_i
 		return false;
 	}
 
-	pod_entry_pod2_t* entry = &pod_file->entries[entry_index];
-	if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
+	bool ok = pod_file_pod2_write_entry(pod_file, entry_index, file);
+	if (fclose(file) != 0)
 	{
-		fprintf(stderr, "ERROR: pod_file_pod2_extract_entry(fwrite failed!\n");
-		fclose(file);
-		return false;
+		fprintf(stderr, "ERROR: pod_file_pod2_extract_entry(fclose(%s) failed: %s\n", dst, strerror(errno));
+		ok = false;
 	}
-
-	fclose(file);
-	return true;
+	return ok;
 }
 
 bool pod_file_pod2_write(pod_file_pod2_t* pod_file, pod_string_t filename)
@@ -397,35 +488,32 @@ bool pod_file_pod2_write(pod_file_pod2_t* pod_file, pod_string_t filename)
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod2_write() archive is mapped read-only!\n");
+		return false;
+	}
+
 	// apply all path_data to the end of the pod_file->data.
-	// start at the end of the file and work backwards
+	// names follow each other in entry order, note where each one starts
 
+	size_t* name_offsets = malloc((pod_file->header->file_count + 1) * sizeof(size_t));
+	if (!name_offsets) {
+		fprintf(stderr, "ERROR: allocating name offsets!\n");
+		return false;
+	}
 	pod_file->path_data_size = 0;
-	for (int i = pod_file->header->file_count - 1; i >= 0; i--)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_entry_pod2_t* entry = &pod_file->entries[i];
-
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
-
-		size_t name_size = strlen(name) + 1;
-		pod_file->path_data_size += name_size;
+		name_offsets[i] = pod_file->path_data_size;
+		pod_file->path_data_size += strlen(pod_file->path_data + pod_file->path_data_size) + 1;
 	}
 
 	size_t new_total_size = pod_file->size + pod_file->path_data_size + pod_file->header->file_count * POD_DIR_ENTRY_POD2_SIZE;
 	void* new_data = realloc(pod_file->data, new_total_size);
 	if (!new_data) {
 		fprintf(stderr, "ERROR: extending data entries!\n");
+		free(name_offsets);
 		return false;
 	}
 	pod_file->data = new_data;
@@ -447,24 +535,14 @@ bool pod_file_pod2_write(pod_file_pod2_t* pod_file, pod_string_t filename)
 	{
 		pod_entry_pod2_t* entry = &pod_file->entries[i];
 
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
+		pod_char_t* name = pod_file->path_data + name_offsets[i];
 
 		size_t name_size = strlen(name) + 1;
 		entry->path_offset = path_data_size2;
 		memcpy(pod_file->data + pod_file->size + path_data_size2, name, name_size);
 		path_data_size2 += name_size;
 	}
+	free(name_offsets);
 	pod_file->size += pod_file->path_data_size;
 	pod_file->path_data = (pod_char_t*)(pod_file->data + pod_file->size - pod_file->path_data_size);
 
@@ -483,109 +561,50 @@ bool pod_file_pod2_write(pod_file_pod2_t* pod_file, pod_string_t filename)
 
 /* Extract POD2 file pod_file to directory dst                       */
 /* @returns true on success otherwise false and leaves errno         */
-bool pod_file_pod2_extract(pod_file_pod2_t* pod_file, pod_string_t pattern, pod_string_t dst)
+bool pod_file_pod2_extract(pod_file_pod2_t* pod_file, pod_match_t* match, pod_string_t dst)
 {
-	pod_bool_t absolute = false;
-	if(pod_file == NULL)
+	if (pod_file == NULL)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod2_extract(pod_file == NULL)\n");
 		return false;
 	}
 
-	if(dst == NULL) { dst = "./"; }
-
-	pod_char_t cwd[POD_SYSTEM_PATH_SIZE];
-	getcwd(cwd, sizeof(cwd));
-	printf("cwd: %s\n",cwd);
-	pod_path_t root = pod_path_system_root();
-
-	printf("root: %s\n",root);
-	pod_path_t path = NULL;
-
-	if(absolute)
-	{
-		path = pod_path_append(root, dst);
-		if(!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", root, dst);
-			free(root);
-			return false;
-		}
-	}
-	else
-	{
-		path = pod_path_append(cwd, dst);
-		if(!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", cwd, dst);
-			free(root);
-			return false;
-		}
-	}
-
-	printf("path: %s\n", path);
-	/* create and change to destination directory */
-	if(mkdir_p(path, ACCESSPERMS) != 0)
-	{
-		fprintf(stderr, "mkdir_p(\"%s\", \'%c\') = %s\n", dst, '/', strerror(errno));
-		return false;
-	}
-
-	if(chdir(path) != 0)
-	{
-		fprintf(stderr, "chdir(%s) = %s\n", path, strerror(errno));
+	/* entries are created relative to dst, the working directory stays */
+	pod_dest_t* dir = pod_dest_open(dst);
+	if (dir == NULL)
 		return false;
-	}
 
 	/* extract entries */
-	for(int i = 0; i < pod_file->header->file_count; i++)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_string_t filename = strdup(pod_file->path_data + pod_file->entries[i].path_offset);
-		if(!filename)
-		{
-			fprintf(stderr, "ERROR: pod_file_pod2_extract(filename == NULL)\n");
-			return false;
-		}
-		if (pattern && strstr(filename, pattern) == NULL)
-		{
-			free(filename);
+		pod_char_t* filename = pod_file->path_data + pod_file->entries[i].path_offset;
+		if (!pod_match_test(match, filename))
 			continue;
-		}
-
-		pod_string_t basename = pod_path_dirname(filename);
-		if (!basename)
-		{
-			fprintf(stderr, "ERROR: pod_path_dirname(%s) failed: %s\n", filename, strerror(errno));
-			free(filename);
-			return false;
-		}
 
 		/* open and create directories including parents */
-		if(strlen(basename) > 0 && mkdir_p(pod_path_append(path, basename), ACCESSPERMS) != 0)
+		FILE* file = pod_dest_fopen(dir, filename);
+		if (file == NULL)
 		{
-			fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", basename, strerror(errno));
+			pod_dest_close(dir);
 			return false;
 		}
-		FILE* file = fopen(filename, "wb");
-		if(file == NULL)
+
+		bool ok = pod_file_pod2_write_entry(pod_file, i, file);
+		if (fclose(file) != 0)
 		{
-			fprintf(stderr, "ERROR: pod_fopen_mkdir(%s) failed: %s\n", filename, strerror(errno));
-			return false;
+			fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", filename, strerror(errno));
+			ok = false;
 		}
-		if(fwrite(pod_file->data + pod_file->entries[i].offset, pod_file->entries[i].size, 1, file) != 1)
+		if (!ok)
 		{
-			fprintf(stderr, "ERROR: fwrite failed!\n");
-			fclose(file);
+			pod_dest_close(dir);
 			return false;
 		}
 
 		/* Debug/Info print thingy */
-		fprintf(stderr, "%s -> %s\n", filename, pod_path_append(path, filename));
-
-		/* clean up and pop */
-		fclose(file);
-		free(filename);
+		fprintf(stderr, "%s -> %s/%s\n", filename, dir->path, filename);
 	}
-	chdir(cwd);
+
+	pod_dest_close(dir);
 	return true;
 }
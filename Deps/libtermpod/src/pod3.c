@@ -17,6 +17,8 @@ pod_checksum_t pod_crc_pod3(pod_file_pod3_t* file)
 	}
 	pod_size_t offset = 0x412;
 	pod_size_t size = file->size - offset;
+	if(!pod_store_fetch(file->store, offset, size))
+		return 0;
 	fprintf(stderr, "CRC of data at %p of size %zu!\n", file->data + offset, size);
 	return pod_crc(file->data + offset, size);
 }
@@ -29,6 +31,8 @@ pod_checksum_t pod_crc_pod3_off(pod_file_pod3_t* file, pod_size_t offset)
 		return 0;
 	}
 	pod_size_t size = file->size - offset;
+	if(!pod_store_fetch(file->store, offset, size))
+		return 0;
 	fprintf(stderr, "CRC of data at %p of size %zu!\n", file->data + offset, size);
 	return pod_crc(file->data + offset, size);
 }
@@ -44,6 +48,9 @@ pod_checksum_t pod_crc_pod3_entry(pod_file_pod3_t* file, pod_number_t entry_inde
 	pod_byte_t* start = (pod_byte_t*)file->data + file->entries[entry_index].offset;
 	pod_number_t size = file->entries[entry_index].size;
 
+	if(!pod_store_fetch(file->store, file->entries[entry_index].offset, size))
+		return 0;
+
 	return pod_crc(start, size);
 }
 
@@ -78,76 +85,26 @@ pod_signed_number32_t pod_entry_pod3_adjacent_diff(const void* a, const void* b)
 
 pod_bool_t pod_file_pod3_update_sizes(pod_file_pod3_t* pod_file)
 {
-	/* check arguments and allocate memory */
-	size_t num_entries = pod_file->header->file_count;
-
-	if(pod_file->gap_sizes)
-		free(pod_file->gap_sizes);
-
-	pod_file->gap_sizes = calloc(num_entries, sizeof(pod_number_t));
-
-	if(pod_file->gap_sizes == NULL)
-	{
-		fprintf(stderr, "Unable to allocate memory for gap_sizes\n");
+	/* entry data sits between the header and index_offset */
+	pod_layout_t* layout = pod_layout_create(pod_file->entries, pod_file->header->file_count, sizeof(pod_entry_pod3_t),
+						 offsetof(pod_entry_pod3_t, offset), offsetof(pod_entry_pod3_t, size),
+						 POD_HEADER_POD3_SIZE, pod_file->header->index_offset);
+	if(layout == NULL)
 		return false;
-	}
-
-	pod_number_t* offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* min_indices = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* ordered_offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* offset_sizes = calloc(num_entries, sizeof(pod_number_t));
-
-	/* sort offset indices and accumulate entry size */
-	for(pod_number_t i = 0; i < num_entries; i++)
-		offsets[i] = pod_file->entries[i].offset;
-
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		for(pod_number_t j = i; j < num_entries; j++)
-		{
-			if(offsets[j] <= offsets[i])
-				min_indices[i] = j;
-		}
-	}
-
-	pod_file->entry_data_size = 0;
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		ordered_offsets[i] = offsets[min_indices[i]];
-		offset_sizes[i] = pod_file->entries[min_indices[i]].size;
-		pod_file->entry_data_size += offset_sizes[i];
-	}
 
-	/* find gap sizes */ 
-	for(pod_number_t i = 1; i < num_entries; i++)
-	{
-		pod_file->gap_sizes[i] = ordered_offsets[i] - (ordered_offsets[i - 1] + offset_sizes[i - 1]);
-		pod_file->gap_sizes[0] += pod_file->gap_sizes[i];
-		printf("gap[%d]=%d\n", i, pod_file->gap_sizes[i]);
-	}
-
-
-	pod_size_t expected_size = pod_file->header->index_offset - POD_HEADER_POD3_SIZE;
-	pod_size_t size = pod_file->entry_data_size + pod_file->gap_sizes[0];
-	/* check data start */
-	pod_file->data_start = pod_file->data + pod_file->entries[min_indices[0]].offset;
-
-	/* cleanup */
-	free(offset_sizes);
-	free(ordered_offsets);
-	free(min_indices);
-	free(offsets);
+	free(pod_file->gap_sizes);
+	pod_file->gap_sizes = layout->gap_sizes;
+	pod_file->entry_data_size = layout->entry_data_size;
+	pod_file->data_start = pod_file->data + layout->data_start;
+	layout->gap_sizes = NULL;
 
+	pod_bool_t valid = layout->valid;
+	if(!valid)
+		fprintf(stderr, "ERROR: %s entry data %u-%u exceeds %zu-%zu!\n", pod_file->filename, layout->data_start, layout->data_end,
+			(pod_size_t)POD_HEADER_POD3_SIZE, (pod_size_t)pod_file->header->index_offset);
 
-	/* compare accumulated entry sizes + gap_sizes[0] to index_offset - header */
-	pod_size_t sum_size = expected_size + POD_HEADER_POD3_SIZE + pod_file->header->size_index;
-	/* status output */
-	fprintf(stderr, "data_start: %p/%p\n", pod_file->data_start, pod_file->data + POD_HEADER_POD3_SIZE);
-	fprintf(stderr, "size_diff: %zu/%u\n", size - expected_size, pod_file->gap_sizes[0]);
-	fprintf(stderr, "index_offset + size_index: %u + %u = %zu\n", pod_file->header->index_offset, pod_file->header->size_index,
-	sum_size);
-
-	return size == expected_size;
+	pod_layout_delete(layout);
+	return valid;
 }
 
 /*
@@ -203,6 +160,7 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename)
 	fclose(file);
 
 	pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
+	pod_file->checksum_valid = true;
 
 	pod_number_t num_entries = pod_file->header->file_count;
 	pod_file->entries = (pod_entry_pod3_t*)(pod_file->data +  pod_file->header->index_offset);
@@ -260,7 +218,12 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename)
 }
 */
 
-pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
+pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename)
+{
+	return pod_file_pod3_open(filename, POD_OPEN_READ);
+}
+
+pod_file_pod3_t* pod_file_pod3_open(pod_string_t filename, pod_open_mode_t mode) {
     pod_number_t ecx4;
     pod_number_t edx5;
     pod_number_t edx6;
@@ -268,13 +231,6 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
     pod_number_t v8;
     pod_number_t v9;
 
-    /* read POD data */
-    struct stat sb;
-    size_t bytes = 0;
-    size_t read = 0;
-
-    uint8_t rotor = 0;
-
 	/* allocate memory */
 	pod_file_pod3_t* pod_file = calloc(1, sizeof(pod_file_pod3_t));
 	if (!pod_file)
@@ -308,51 +264,30 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
 		return pod_file;
 	}
 
-	if (stat(filename, &sb) != 0) {
-		free(pod_file);
-	    perror("stat");
-	    return NULL;
-	}
-
-    FILE* file = fopen(filename, "rb");
-    if(!file)
-	    return NULL;
-
-    pod_file->data = calloc(sb.st_size,sizeof(uint8_t));
+    /* progress goes to stderr, stdout may carry an extracted tar stream */
+    pod_file->filename = strdup(filename);
+    pod_file->data = pod_store_load(filename, mode, &pod_file->store, &pod_file->size);
     if(!pod_file->data)
     {
-    	fclose(file);
-	free(pod_file);
-    	return NULL;
+	    fprintf(stderr, "\rLoading POD file... %lu/%lu FAILED!\n", 0UL, pod_file->size);
+	    fflush(stderr);
+	    return pod_file_pod3_delete(pod_file);
     }
 
     pod_file->header = (pod_header_pod3_t*)pod_file->data;
-    pod_file->filename = strdup(filename);
-    pod_file->size = sb.st_size;
-
 
-    /* read data as sizeof(pod_file_block_t) steps */
-    pod_file_block_t* ptr = (pod_file_block_t*)&pod_file->data[0];
-
-    for(read = 0; read < sb.st_size; read += fread(ptr++, sizeof(uint8_t), sizeof(pod_file_block_t), file))
+    /* lazy archives only read the header and the directory, path table and */
+    /* audit trail which all follow index_offset                            */
+    if(!pod_store_fetch(pod_file->store, 0, POD_HEADER_POD3_SIZE) ||
+       pod_file->header->index_offset > pod_file->size ||
+       !pod_store_fetch(pod_file->store, pod_file->header->index_offset, pod_file->size - pod_file->header->index_offset))
     {
-	    fprintf(stdout, "\rLoading POD file... %lu/%lu (%c)", read, sb.st_size, rotorchar[rotor]); 
-	    fflush(stdout);
-	    rotor++;
-	    rotor&=3;
-    }
-
-    if( read != pod_file->size)
-    {
-	    fprintf(stdout, "\rLoading POD file... %lu/%lu FAILED!\n", read, pod_file->size);
-	    fflush(stdout);
-	    fclose(file);
+	    fprintf(stderr, "\rLoading POD file... %lu/%lu FAILED!\n", 0UL, pod_file->size);
+	    fflush(stderr);
 	    return pod_file_pod3_delete(pod_file);
     }
 
-    fprintf(stdout, "\rLoading POD file... %lu/%lu SUCCESS!\n", read, sb.st_size, rotorchar[rotor]);
-
-    pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
+    fprintf(stderr, "\rLoading POD file... %lu/%lu SUCCESS!\n", pod_file->size, pod_file->size);
 
 /*
     for(pod_number_t i = 0; i < pod_file->size; i+=4)
@@ -364,7 +299,6 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
     }
 */
 
-    fprintf(stdout, "\rCreating POD file checksum... %08x SUCCESS!\n", pod_file->checksum);
     /* read header */
     uint8_t iudiff = *(uint8_t*)&pod_file->header->index_offset - *(uint8_t*)&pod_file->header->size_index;
     uint8_t isdiff = *(int8_t*)&pod_file->header->index_offset - *(int8_t*)&pod_file->header->size_index;
@@ -372,19 +306,30 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
 
     if(!pod_is_pod3(pod_file->header->ident))
     {
-	    fprintf(stdout, "\rReading POD file magic... %u/%u FAILED!\n", 0,4);
-	    fflush(stdout);
-	    fclose(file);
+	    fprintf(stderr, "\rReading POD file magic... %u/%u FAILED!\n", 0,4);
+	    fflush(stderr);
 	    return pod_file_pod3_delete(pod_file);
     }
     else
-    	fprintf(stdout, "\rReading POD file magic... %u/%u SUCCESS!\n", 4,4);
+    	fprintf(stderr, "\rReading POD file magic... %u/%u SUCCESS!\n", 4,4);
+
+    /* warm opens take checksum, layout and name index from the sidecar,  */
+    /* mapped archives skip the whole file pass; both happen before the   */
+    /* header fields below are patched in place                           */
+    pod_cache_t* cache = pod_cache_load(filename, pod_file->data, POD_HEADER_POD3_SIZE, pod_file->header->file_count);
+    pod_file->checksum_valid = cache != NULL || pod_file->store == NULL;
+    if(cache != NULL)
+	    pod_file->checksum = cache->checksum;
+    else if(pod_file->store == NULL)
+	    pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
+
+    fprintf(stderr, "\rCreating POD file checksum... %08x SUCCESS!\n", pod_file->checksum);
 
     if((pod_file->header->checksum = *(pod_number_t*)(pod_file->data + 4)) == 0)
 	    pod_file->header->checksum = 0xfffffffe;
     else if(*(int8_t*)&pod_file->header->index_offset <= *(int8_t*)&pod_file->header->size_index)
     {
-	    printf("Loading index_offset: %02x/%08x size_index: %02x/%08x\n", *(int8_t*)&pod_file->header->index_offset, pod_file->header->index_offset, *(int8_t*)&pod_file->header->size_index, pod_file->header->size_index);
+	    fprintf(stderr, "Loading index_offset: %02x/%08x size_index: %02x/%08x\n", *(int8_t*)&pod_file->header->index_offset, pod_file->header->index_offset, *(int8_t*)&pod_file->header->size_index, pod_file->header->size_index);
 	    pod_file->header->checksum = 0xffffffff;
     }
 
@@ -459,7 +404,17 @@ pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename) {
 	    pod_file->audit_data_size = pod_file->header->audit_file_count * POD_AUDIT_ENTRY_POD3_SIZE;
     }
 
-    if(!pod_file_pod3_update_sizes(pod_file))
+    if(cache != NULL)
+    {
+	    pod_file->gap_sizes = cache->gap_sizes;
+	    pod_file->data_start = pod_file->data + cache->data_start;
+	    pod_file->entry_data_size = cache->entry_data_size;
+	    pod_file->index = cache->index;
+	    cache->gap_sizes = NULL;
+	    cache->index = NULL;
+	    cache = pod_cache_delete(cache);
+    }
+    else if(!pod_file_pod3_update_sizes(pod_file))
     {
 	    fprintf(stderr, "ERROR: Could not update POD3 file entry sizes\n");
 	    return pod_file_pod3_delete(pod_file);
@@ -475,6 +430,16 @@ bool pod_file_pod3_add_entry(pod_file_pod3_t* pod_file, pod_entry_pod3_t* entry,
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_add_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	size_t new_entry_size = POD_DIR_ENTRY_POD3_SIZE;
 	size_t new_entry_data_size = entry->size;
 	size_t new_path_data_size = strlen(filename) + 1;
@@ -527,6 +492,16 @@ bool pod_file_pod3_del_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_del_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	if (entry_index >= pod_file->header->file_count)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod3_del_entry(entry_index >= pod_file->header->file_count)\n");
@@ -567,6 +542,50 @@ pod_entry_pod3_t* pod_file_pod3_get_entry(pod_file_pod3_t* pod_file, pod_number_
 	return &pod_file->entries[entry_index];
 }
 
+bool pod_file_pod3_stream_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context)
+{
+	if (pod_file == NULL || sink == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_stream_entry(pod_file == NULL || sink == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_stream_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	pod_entry_pod3_t* entry = &pod_file->entries[entry_index];
+	if (!pod_store_fetch(pod_file->store, entry->offset, entry->size))
+		return false;
+
+	return sink(context, pod_file->data + entry->offset, entry->size);
+}
+
+bool pod_file_pod3_write_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, FILE* file)
+{
+	if (pod_file == NULL || file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_write_entry(pod_file == NULL || file == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_write_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	/* stored bytes go from the archive fd to file inside the kernel */
+	pod_entry_pod3_t* entry = &pod_file->entries[entry_index];
+	pod_ssize_t copied = pod_store_copy(pod_file->store, entry->offset, entry->size, file);
+	if (copied != 0)
+		return copied > 0;
+
+	return pod_file_pod3_stream_entry(pod_file, entry_index, pod_sink_file, file);
+}
+
 bool pod_file_pod3_extract_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, pod_string_t dst)
 {
 	if (pod_file == NULL)
@@ -589,16 +608,13 @@ bool pod_file_pod3_extract_entry(pod_file_pod3_t* pod_file, pod_number_t entry_i
 		return false;
 	}
 
-	pod_entry_pod3_t* entry = &pod_file->entries[entry_index];
-	if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
+	bool ok = pod_file_pod3_write_entry(pod_file, entry_index, file);
+	if (fclose(file) != 0)
 	{
-		fprintf(stderr, "ERROR: pod_file_pod3_extract_entry(fwrite failed!\n");
-		fclose(file);
-		return false;
+		fprintf(stderr, "ERROR: pod_file_pod3_extract_entry(fclose(%s) failed: %s\n", dst, strerror(errno));
+		ok = false;
 	}
-
-	fclose(file);
-	return true;
+	return ok;
 }
 
 pod_file_pod3_t* pod_file_pod3_delete(pod_file_pod3_t* podfile)
@@ -610,6 +626,13 @@ pod_file_pod3_t* pod_file_pod3_delete(pod_file_pod3_t* podfile)
 			free(podfile->gap_sizes);
 			podfile->gap_sizes = NULL;
 		}
+		podfile->index = pod_index_delete(podfile->index);
+		podfile->tree = pod_tree_delete(podfile->tree);
+		if(podfile->store)
+		{
+			podfile->store = pod_store_close(podfile->store);
+			podfile->data = NULL;
+		}
 		if(podfile->data)
 		{
 			free(podfile->data);
@@ -649,7 +672,7 @@ bool pod_audit_entry_pod3_print(pod_audit_entry_pod3_t* audit)
 	return true;
 }
 
-bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_char_t* pattern)
+bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_match_t* match)
 {
 	if(pod_file == NULL)
 	{
@@ -657,19 +680,23 @@ bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_char_t* pattern)
 		return false;
 	}
 
+	/* lazy archives list without touching entry data */
+	pod_bool_t lazy = pod_store_is_lazy(pod_file->store);
+	pod_char_t checksum[POD_CHECKSUM_STRING_SIZE];
+
 	/* print entries */
 	printf("\nEntries:\n");
 	for(pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
 		pod_entry_pod3_t* entry = &pod_file->entries[i];
 		pod_char_t* name = pod_file->path_data + entry->path_offset;
-		if (pattern && strstr(name, pattern) == NULL)
+		if (!pod_match_test(match, name))
 			continue;
-		printf("%.10u %.10u %.8X/%.8X %10u %.32s %.32s %10u\n",
+		printf("%.10u %.10u %.8X/%s %10u %.32s %.32s %10u\n",
 		       	i,
 			entry->offset,
 			entry->checksum,
-			pod_crc_pod3_entry(pod_file, i),
+			pod_checksum_str(checksum, "%.8X", lazy ? 0 : pod_crc_pod3_entry(pod_file, i), !lazy),
 			entry->size,
 			pod_ctime(&entry->timestamp),
 			name,
@@ -691,13 +718,14 @@ bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_char_t* pattern)
 	}
 */
 	/* print file summary */
+	pod_char_t file_checksum[POD_CHECKSUM_STRING_SIZE];
 	printf("\nSummary:\n \
-	        file checksum      : 0x%.8X/% 11d\n \
+	        file checksum      : %s\n \
 	        size               : 0x%.8zX/% 11zd\n \
 		filename           : %s\n \
 		format             : %s\n \
 		comment            : %s\n \
-		data checksum      : 0x%.8X/ 0x%.8X\n \
+		data checksum      : 0x%.8X/ %s\n \
 		file entries       : 0x%.8X/% 11d\n \
 		audit entries      : 0x%.8X/% 11d\n \
 		revision           : 0x%.8X/% 11d\n \
@@ -713,13 +741,13 @@ bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_char_t* pattern)
 		pad_120            : 0x%.8X/% 11d\n \
 		pad_124            : 0x%.8X/% 11d\n \
 		data_offset        : 0x%.8X/% 11d\n",
-		pod_file->checksum, pod_file->checksum,
+		pod_checksum_str(file_checksum, "0x%.8X/% 11d", pod_file->checksum, pod_file->checksum_valid),
 		pod_file->size, pod_file->size,
 		pod_file->filename,
 		pod_type_desc_str(pod_type(pod_file->header->ident)),
 		pod_file->header->comment,
 		pod_file->header->checksum,
-		pod_crc_pod3(pod_file),
+		pod_checksum_str(checksum, "0x%.8X", lazy ? 0 : pod_crc_pod3(pod_file), !lazy),
 		pod_file->header->file_count,pod_file->header->file_count,
 		pod_file->header->audit_file_count,pod_file->header->audit_file_count,
 		pod_file->header->revision,pod_file->header->revision,
@@ -742,110 +770,51 @@ bool pod_file_pod3_print(pod_file_pod3_t* pod_file, pod_char_t* pattern)
 
 /* Extract POD3 file pod_file to directory dst                       */
 /* @returns true on success otherwise false and leaves errno         */
-bool pod_file_pod3_extract(pod_file_pod3_t* pod_file, pod_string_t pattern, pod_string_t dst)
+bool pod_file_pod3_extract(pod_file_pod3_t* pod_file, pod_match_t* match, pod_string_t dst)
 {
-	pod_bool_t absolute = false;
 	if (pod_file == NULL)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod3_extract(pod_file == NULL)\n");
 		return false;
 	}
 
-	if (dst == NULL) { dst = "./"; }
-
-	pod_char_t cwd[POD_SYSTEM_PATH_SIZE];
-	getcwd(cwd, sizeof(cwd));
-	printf("cwd: %s\n", cwd);
-	pod_path_t root = pod_path_system_root();
-
-	printf("root: %s\n", root);
-	pod_path_t path = NULL;
-
-	if (absolute)
-	{
-		path = pod_path_append(root, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", root, dst);
-			free(root);
-			return false;
-		}
-	}
-	else
-	{
-		path = pod_path_append(cwd, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", cwd, dst);
-			free(root);
-			return false;
-		}
-	}
-
-	printf("path: %s\n", path);
-	/* create and change to destination directory */
-	if (mkdir_p(path, ACCESSPERMS) != 0)
-	{
-		fprintf(stderr, "mkdir_p(\"%s\", \'%c\') = %s\n", dst, '/', strerror(errno));
-		return false;
-	}
-
-	if (chdir(path) != 0)
-	{
-		fprintf(stderr, "chdir(%s) = %s\n", path, strerror(errno));
+	/* entries are created relative to dst, the working directory stays */
+	pod_dest_t* dir = pod_dest_open(dst);
+	if (dir == NULL)
 		return false;
-	}
 
 	/* extract entries */
-	for (int i = 0; i < pod_file->header->file_count; i++)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_string_t filename = strdup(pod_file->path_data + pod_file->entries[i].path_offset);
-		if (!filename)
-		{
-			fprintf(stderr, "ERROR: pod_file_pod3_extract(filename == NULL)\n");
-			return false;
-		}
-		if (pattern && strstr(filename, pattern) == NULL)
-		{
-			free(filename);
+		pod_char_t* filename = pod_file->path_data + pod_file->entries[i].path_offset;
+		if (!pod_match_test(match, filename))
 			continue;
-		}
-
-		pod_string_t basename = pod_path_dirname(filename);
-		if (!basename)
-		{
-			fprintf(stderr, "ERROR: pod_path_dirname(%s) failed: %s\n", filename, strerror(errno));
-			free(filename);
-			return false;
-		}
 
 		/* open and create directories including parents */
-		if (strlen(basename) > 0 && mkdir_p(pod_path_append(path, basename), ACCESSPERMS) != 0)
+		FILE* file = pod_dest_fopen(dir, filename);
+		if (file == NULL)
 		{
-			fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", basename, strerror(errno));
+			pod_dest_close(dir);
 			return false;
 		}
-		FILE* file = fopen(filename, "wb");
-		if (file == NULL)
+
+		bool ok = pod_file_pod3_write_entry(pod_file, i, file);
+		if (fclose(file) != 0)
 		{
-			fprintf(stderr, "ERROR: pod_fopen_mkdir(%s) failed: %s\n", filename, strerror(errno));
-			return false;
+			fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", filename, strerror(errno));
+			ok = false;
 		}
-		if (fwrite(pod_file->data + pod_file->entries[i].offset, pod_file->entries[i].size, 1, file) != 1)
+		if (!ok)
 		{
-			fprintf(stderr, "ERROR: fwrite failed!\n");
-			fclose(file);
+			pod_dest_close(dir);
 			return false;
 		}
 
 		/* Debug/Info print thingy */
-		fprintf(stderr, "%s -> %s\n", filename, pod_path_append(path, filename));
-
-		/* clean up and pop */
-		fclose(file);
-		free(filename);
+		fprintf(stderr, "%s -> %s/%s\n", filename, dir->path, filename);
 	}
-	chdir(cwd);
+
+	pod_dest_close(dir);
 	return true;
 }
 
@@ -857,35 +826,32 @@ bool pod_file_pod3_write(pod_file_pod3_t* pod_file, pod_string_t filename)
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod3_write() archive is mapped read-only!\n");
+		return false;
+	}
+
 	// apply all path_data to the end of the pod_file->data.
-	// start at the end of the file and work backwards
+	// names follow each other in entry order, note where each one starts
 
+	size_t* name_offsets = malloc((pod_file->header->file_count + 1) * sizeof(size_t));
+	if (!name_offsets) {
+		fprintf(stderr, "ERROR: allocating name offsets!\n");
+		return false;
+	}
 	pod_file->path_data_size = 0;
-	for (int i = pod_file->header->file_count - 1; i >= 0; i--)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_entry_pod3_t* entry = &pod_file->entries[i];
-
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
-
-		size_t name_size = strlen(name) + 1;
-		pod_file->path_data_size += name_size;
+		name_offsets[i] = pod_file->path_data_size;
+		pod_file->path_data_size += strlen(pod_file->path_data + pod_file->path_data_size) + 1;
 	}
 
 	size_t new_total_size = pod_file->size + pod_file->path_data_size + pod_file->header->file_count * POD_DIR_ENTRY_POD3_SIZE;
 	void* new_data = realloc(pod_file->data, new_total_size);
 	if (!new_data) {
 		fprintf(stderr, "ERROR: extending data entries!\n");
+		free(name_offsets);
 		return false;
 	}
 	pod_file->data = new_data;
@@ -909,24 +875,14 @@ bool pod_file_pod3_write(pod_file_pod3_t* pod_file, pod_string_t filename)
 	{
 		pod_entry_pod3_t* entry = &pod_file->entries[i];
 
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
+		pod_char_t* name = pod_file->path_data + name_offsets[i];
 
 		size_t name_size = strlen(name) + 1;
 		entry->path_offset = path_data_size2;
 		memcpy(pod_file->data + pod_file->size + path_data_size2, name, name_size);
 		path_data_size2 += name_size;
 	}
+	free(name_offsets);
 	pod_file->size += pod_file->path_data_size;
 	pod_file->path_data = (pod_char_t*)(pod_file->data + pod_file->size - pod_file->path_data_size);
 	pod_file->header->size_index = pod_file->path_data_size;
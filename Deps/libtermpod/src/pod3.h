@@ -85,9 +85,13 @@ typedef struct pod_file_pod3_s
 	pod_string_t filename;
 	pod_size_t size;
 	pod_number_t checksum;
+	pod_bool_t checksum_valid; /* false if a mapped or lazy open skipped the file pass */
 	pod_number_t data_offset;
 	pod_byte_t* data_start;
 	pod_zip_entry_pod3_t* zip_entries;
+	pod_store_t* store; /* NULL unless the archive is mapped */
+	pod_index_t* index; /* name lookup, built on first use */
+	pod_tree_t* tree; /* directory tree, built on first use */
 	/* end of not serialized content */
 } pod_file_pod3_t;
 bool pod_is_pod3(char* ident);
@@ -99,13 +103,16 @@ uint32_t pod_crc_pod3_audit(pod_file_pod3_t* file, pod_number_t audit_index);
 pod_bool_t pod_file_pod3_update_sizes(pod_file_pod3_t* pod_file);
 pod_checksum_t   pod_file_pod3_chksum(pod_file_pod3_t* podfile);
 pod_file_pod3_t* pod_file_pod3_create(pod_string_t filename);
+pod_file_pod3_t* pod_file_pod3_open(pod_string_t filename, pod_open_mode_t mode);
 pod_file_pod3_t* pod_file_pod3_delete(pod_file_pod3_t* podfile);
-bool pod_file_pod3_print(pod_file_pod3_t* podfile, pod_char_t* pattern);
+bool pod_file_pod3_print(pod_file_pod3_t* podfile, pod_match_t* match);
 bool pod_file_pod3_write(pod_file_pod3_t* pod_file, pod_string_t filename);
 bool pod_audit_entry_pod3_print(pod_audit_entry_pod3_t* audit);
 bool pod_file_pod3_add_entry(pod_file_pod3_t* pod_file, pod_entry_pod3_t* entry, pod_string_t filename, pod_byte_t* data);
 bool pod_file_pod3_del_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index);
 pod_entry_pod3_t* pod_file_pod3_get_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index);
+bool pod_file_pod3_stream_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context);
+bool pod_file_pod3_write_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, FILE* file);
 bool pod_file_pod3_extract_entry(pod_file_pod3_t* pod_file, pod_number_t entry_index, pod_string_t dst);
-bool pod_file_pod3_extract(pod_file_pod3_t* pod_file, pod_string_t pattern, pod_string_t dst);
+bool pod_file_pod3_extract(pod_file_pod3_t* pod_file, pod_match_t* match, pod_string_t dst);
 #endif
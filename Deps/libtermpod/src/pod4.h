@@ -87,8 +87,12 @@ typedef struct pod_file_pod4_s
 	pod_string_t filename;
 	pod_size_t size;
 	pod_number_t checksum;
+	pod_bool_t checksum_valid; /* false if a mapped or lazy open skipped the file pass */
 	pod_byte_t* data_start; 
 	pod_zip_entry_pod4_t* zip_entries;
+	pod_store_t* store; /* NULL unless the archive is mapped */
+	pod_index_t* index; /* name lookup, built on first use */
+	pod_tree_t* tree; /* directory tree, built on first use */
 	/* end of not serialized content */
 } pod_file_pod4_t;
 
@@ -100,14 +104,17 @@ uint32_t pod_crc_pod4_audit(pod_file_pod4_t* file, pod_number_t audit_index);
 pod_bool_t pod_file_pod4_update_sizes(pod_file_pod4_t* podfile);
 pod_checksum_t   pod_file_pod4_chksum(pod_file_pod4_t* pod_file);
 pod_file_pod4_t* pod_file_pod4_create(pod_string_t filename);
+pod_file_pod4_t* pod_file_pod4_open(pod_string_t filename, pod_open_mode_t mode);
 pod_file_pod4_t* pod_file_pod4_delete(pod_file_pod4_t* podfile);
-bool pod_file_pod4_print(pod_file_pod4_t* podfile, pod_char_t* pattern);
+bool pod_file_pod4_print(pod_file_pod4_t* podfile, pod_match_t* match);
 bool pod_file_pod4_write(pod_file_pod4_t* pod_file, pod_string_t filename);
 bool pod_audit_entry_pod4_print(pod_audit_entry_pod4_t* audit);
 bool pod_file_pod4_add_entry(pod_file_pod4_t* pod_file, pod_entry_pod4_t* entry, pod_string_t filename, pod_byte_t* data);
 bool pod_file_pod4_del_entry(pod_file_pod4_t* pod_file, pod_number_t entry_index);
 pod_entry_pod4_t* pod_file_pod4_get_entry(pod_file_pod4_t* pod_file, pod_number_t entry_index);
+bool pod_file_pod4_stream_entry(pod_file_pod4_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context);
+bool pod_file_pod4_write_entry(pod_file_pod4_t* pod_file, pod_number_t entry_index, FILE* file);
 bool pod_file_pod4_extract_entry(pod_file_pod4_t* pod_file, pod_number_t entry_index, pod_string_t dst);
-bool pod_file_pod4_extract(pod_file_pod4_t* pod_file, pod_string_t pattern, pod_string_t dst);
+bool pod_file_pod4_extract(pod_file_pod4_t* pod_file, pod_match_t* match, pod_string_t dst);
 #endif
 
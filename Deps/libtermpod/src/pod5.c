@@ -15,6 +15,8 @@ pod_checksum_t pod_crc_pod5(pod_file_pod5_t* file)
 		fprintf(stderr, "ERROR: pod_crc_pod5() file == NULL!");
 		return 0;
 	}
+	if(!pod_store_fetch(file->store, 0, file->size))
+		return 0;
 	pod_byte_t* start = (pod_byte_t*)(&file->header->checksum) + POD_NUMBER_SIZE;
 	pod_size_t size = file->size - (file->header->index_offset + file->header->size_index);
 	// fprintf(stderr, "CRC of data at %p of size %lu!\n", start, size);
@@ -32,6 +34,9 @@ pod_checksum_t pod_crc_pod5_entry(pod_file_pod5_t* file, pod_number_t entry_inde
 	pod_byte_t* start = (pod_byte_t*)file->data + file->entries[entry_index].offset;
 	pod_number_t size = file->entries[entry_index].size;
 
+	if(!pod_store_fetch(file->store, file->entries[entry_index].offset, size))
+		return 0;
+
 	return pod_crc(start, size);
 }
 
@@ -66,77 +71,34 @@ pod_signed_number32_t pod_entry_pod5_adjacent_diff(const void* a, const void* b)
 
 pod_bool_t pod_file_pod5_update_sizes(pod_file_pod5_t* pod_file)
 {
-	/* check arguments and allocate memory */
-	size_t num_entries = pod_file->header->file_count;
-
-	if(pod_file->gap_sizes)
-		free(pod_file->gap_sizes);
-
-	pod_file->gap_sizes = calloc(num_entries, sizeof(pod_number_t));
-
-	if(pod_file->gap_sizes == NULL)
-	{
-		fprintf(stderr, "Unable to allocate memory for gap_sizes\n");
+	/* entry data sits between the header and index_offset */
+	pod_layout_t* layout = pod_layout_create(pod_file->entries, pod_file->header->file_count, sizeof(pod_entry_pod5_t),
+						 offsetof(pod_entry_pod5_t, offset), offsetof(pod_entry_pod5_t, size),
+						 POD_HEADER_POD5_SIZE, pod_file->header->index_offset);
+	if(layout == NULL)
 		return false;
-	}
-
-	pod_number_t* offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* min_indices = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* ordered_offsets = calloc(num_entries, sizeof(pod_number_t));
-	pod_number_t* offset_sizes = calloc(num_entries, sizeof(pod_number_t));
-
-	/* sort offset indices and accumulate entry size */
-	for(pod_number_t i = 0; i < num_entries; i++)
-		offsets[i] = pod_file->entries[i].offset;
-
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		for(pod_number_t j = i; j < num_entries; j++)
-		{
-			if(offsets[j] <= offsets[i])
-				min_indices[i] = j;
-		}
-	}
-
-	pod_file->entry_data_size = 0;
-	for(pod_number_t i = 0; i < num_entries; i++)
-	{
-		ordered_offsets[i] = offsets[min_indices[i]];
-		offset_sizes[i] = pod_file->entries[min_indices[i]].size;
-		pod_file->entry_data_size += offset_sizes[i];
-	}
-
-	/* find gap sizes */ 
-	for(pod_number_t i = 1; i < num_entries; i++)
-	{
-		pod_file->gap_sizes[i] = ordered_offsets[i] - (ordered_offsets[i - 1] + offset_sizes[i - 1]);
-		pod_file->gap_sizes[0] += pod_file->gap_sizes[i];
-	}
-
-	/* check data start */
-	pod_file->data_start = pod_file->data + offsets[min_indices[0]];
-
-	/* cleanup */
-	free(offset_sizes);
-	free(ordered_offsets);
-	free(min_indices);
-	free(offsets);
 
+	free(pod_file->gap_sizes);
+	pod_file->gap_sizes = layout->gap_sizes;
+	pod_file->entry_data_size = layout->entry_data_size;
+	pod_file->data_start = pod_file->data + layout->data_start;
+	layout->gap_sizes = NULL;
 
-	/* compare accumulated entry sizes + gap_sizes[0] to index_offset - header */
-	pod_size_t size = pod_file->entry_data_size + pod_file->gap_sizes[0];
-	pod_size_t expected_size = pod_file->header->index_offset - POD_HEADER_POD5_SIZE;
-	pod_size_t sum_size = expected_size + POD_HEADER_POD5_SIZE + pod_file->header->size_index;
-	/* status output */
-	fprintf(stderr, "data_start: %lu/%lu\n", pod_file->entry_data - pod_file->data, pod_file->data_start - pod_file->data);
-	fprintf(stderr, "accumulated_size: %lu/%lu\n", size, expected_size);
-	fprintf(stderr, "index_offset + size_index: %u + %u = %lu\n", pod_file->header->index_offset, pod_file->header->size_index,
-	sum_size);
+	pod_bool_t valid = layout->valid;
+	if(!valid)
+		fprintf(stderr, "ERROR: %s entry data %u-%u exceeds %zu-%zu!\n", pod_file->filename, layout->data_start, layout->data_end,
+			(pod_size_t)POD_HEADER_POD5_SIZE, (pod_size_t)pod_file->header->index_offset);
 
-	return size == expected_size;
+	pod_layout_delete(layout);
+	return valid;
 }
 
 pod_file_pod5_t* pod_file_pod5_create(pod_string_t filename)
+{
+	return pod_file_pod5_open(filename, POD_OPEN_READ);
+}
+
+pod_file_pod5_t* pod_file_pod5_open(pod_string_t filename, pod_open_mode_t mode)
 {
 	pod_file_pod5_t* pod_file = calloc(1, sizeof(pod_file_pod5_t));
 
@@ -180,59 +142,37 @@ pod_file_pod5_t* pod_file_pod5_create(pod_string_t filename)
 		return pod_file;
 	}
 
-	struct stat sb;
-	if(stat(filename, &sb) != 0 || sb.st_size == 0)
-	{
-		perror("stat");
-		return NULL;
-	}
-
 	pod_file->filename = strdup(filename);
-	pod_file->size = sb.st_size;
-
-	FILE* file = fopen(filename, "rb");
-
-	if(!file)
-	{
-		fprintf(stderr, "ERROR: Could not open POD file: %s\n", filename);
-		return NULL;
-	}
-
-	pod_file->data = calloc(1, pod_file->size);
+	pod_file->data = pod_store_load(filename, mode, &pod_file->store, &pod_file->size);
 
 	if(!pod_file->data)
 	{
-		fprintf(stderr, "ERROR: Could not allocate memory of size %zu for file %s!\n", pod_file->size, filename);
-		fclose(file);
+		fprintf(stderr, "ERROR: Could not load POD file %s!\n", filename);
 		pod_file_pod5_delete(pod_file);
 		return NULL;
 	}
-	if(fread(pod_file->data, POD_BYTE_SIZE, POD_IDENT_SIZE, file) != POD_IDENT_SIZE * POD_BYTE_SIZE)
-	{
-		fprintf(stderr, "ERROR: Could not read file magic %s!\n", filename);
-		fclose(file);
-		pod_file_pod5_delete(pod_file);
-		return NULL;
-	}
-	if(fread(pod_file->data + POD_NUMBER_SIZE, POD_NUMBER_SIZE, 1, file) != 1)
-	{
-		fprintf(stderr, "ERROR: Could not read file checksum %s!\n", filename);
-		fclose(file);
-		pod_file_pod5_delete(pod_file);
-		return NULL;
-	}
-	if(fread(pod_file->data + 8, POD_BYTE_SIZE, pod_file->size - 8, file) != (pod_file->size - 8 )* POD_BYTE_SIZE)
+
+	pod_file->header = (pod_header_pod5_t*)pod_file->data;
+
+	/* lazy archives only read the header and the directory, path table and */
+	/* audit trail which all follow index_offset                            */
+	if(!pod_store_fetch(pod_file->store, 0, POD_HEADER_POD5_SIZE) ||
+	   pod_file->header->index_offset > pod_file->size ||
+	   !pod_store_fetch(pod_file->store, pod_file->header->index_offset, pod_file->size - pod_file->header->index_offset))
 	{
-		fprintf(stderr, "ERROR: Could not read file %s!\n", filename);
-		fclose(file);
-		pod_file_pod5_delete(pod_file);
-		return NULL;
+		fprintf(stderr, "ERROR: Could not read POD5 directory of %s!\n", filename);
+		return pod_file_pod5_delete(pod_file);
 	}
 
-	fclose(file);
-	pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
+	/* warm opens take checksum, layout and name index from the sidecar, */
+	/* mapped archives skip the whole file pass                          */
+	pod_cache_t* cache = pod_cache_load(filename, pod_file->data, POD_HEADER_POD5_SIZE, pod_file->header->file_count);
+	pod_file->checksum_valid = cache != NULL || pod_file->store == NULL;
+	if(cache != NULL)
+		pod_file->checksum = cache->checksum;
+	else if(pod_file->store == NULL)
+		pod_file->checksum = pod_crc(pod_file->data, pod_file->size);
 
-	pod_file->header = (pod_header_pod5_t*)pod_file->data;
 	pod_file->entry_data = (pod_byte_t*)(pod_file->data + POD_HEADER_POD5_SIZE);
 	pod_file->entries = (pod_entry_pod5_t*)(pod_file->data + pod_file->header->index_offset);
 	pod_number_t num_entries = pod_file->header->file_count;
@@ -275,7 +215,17 @@ pod_file_pod5_t* pod_file_pod5_create(pod_string_t filename)
 		pod_file->audit_data_size = pod_file->header->audit_file_count * POD_AUDIT_ENTRY_POD5_SIZE;
 	}
 
-	if(!pod_file_pod5_update_sizes(pod_file))
+	if(cache != NULL)
+	{
+		pod_file->gap_sizes = cache->gap_sizes;
+		pod_file->data_start = pod_file->data + cache->data_start;
+		pod_file->entry_data_size = cache->entry_data_size;
+		pod_file->index = cache->index;
+		cache->gap_sizes = NULL;
+		cache->index = NULL;
+		cache = pod_cache_delete(cache);
+	}
+	else if(!pod_file_pod5_update_sizes(pod_file))
 	{
 		fprintf(stderr, "ERROR: Could not update POD5 file entry sizes\n");
 		pod_file_pod5_delete(pod_file);
@@ -293,6 +243,16 @@ bool pod_file_pod5_add_entry(pod_file_pod5_t* pod_file, pod_entry_pod5_t* entry,
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_add_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	size_t new_entry_size = POD_DIR_ENTRY_POD5_SIZE;
 	size_t new_entry_data_size = entry->size;
 	size_t new_path_data_size = strlen(filename) + 1;
@@ -345,6 +305,16 @@ bool pod_file_pod5_del_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_del_entry() archive is mapped read-only!\n");
+		return false;
+	}
+
+	/* entry indices change, rebuild on next lookup */
+	pod_file->index = pod_index_delete(pod_file->index);
+	pod_file->tree = pod_tree_delete(pod_file->tree);
+
 	if (entry_index >= pod_file->header->file_count)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod5_del_entry(entry_index >= pod_file->header->file_count)\n");
@@ -385,6 +355,62 @@ pod_entry_pod5_t* pod_file_pod5_get_entry(pod_file_pod5_t* pod_file, pod_number_
 	return &pod_file->entries[entry_index];
 }
 
+bool pod_file_pod5_stream_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context)
+{
+	if (pod_file == NULL || sink == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_stream_entry(pod_file == NULL || sink == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_stream_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	pod_entry_pod5_t* entry = &pod_file->entries[entry_index];
+	if (!pod_store_fetch(pod_file->store, entry->offset, entry->size))
+		return false;
+
+	pod_byte_t* data = pod_file->data + entry->offset;
+	if (entry->compression_level > 0)
+	{
+		pod_char_t* name = pod_file->path_data + entry->path_offset;
+		pod_size_t written = 0;
+		if (pod_inflate_stream(data, entry->size, entry->uncompressed, name, sink, context, &written))
+			return true;
+		/* nothing inflated, the entry is stored as is after all */
+		if (written > 0)
+			return false;
+	}
+
+	return sink(context, data, entry->size);
+}
+
+bool pod_file_pod5_write_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, FILE* file)
+{
+	if (pod_file == NULL || file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_write_entry(pod_file == NULL || file == NULL)\n");
+		return false;
+	}
+
+	if (entry_index >= pod_file->header->file_count)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_write_entry(entry_index >= pod_file->header->file_count)\n");
+		return false;
+	}
+
+	/* stored bytes go from the archive fd to file inside the kernel */
+	pod_entry_pod5_t* entry = &pod_file->entries[entry_index];
+	pod_ssize_t copied = entry->compression_level == 0 ? pod_store_copy(pod_file->store, entry->offset, entry->size, file) : 0;
+	if (copied != 0)
+		return copied > 0;
+
+	return pod_file_pod5_stream_entry(pod_file, entry_index, pod_sink_file, file);
+}
+
 bool pod_file_pod5_extract_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, pod_string_t dst)
 {
 	if (pod_file == NULL)
@@ -407,30 +433,13 @@ bool pod_file_pod5_extract_entry(pod_file_pod5_t* pod_file, pod_number_t entry_i
 		return false;
 	}
 
-	pod_entry_pod5_t* entry = &pod_file->entries[entry_index];
-
-	pod_char_t* name = pod_file->path_data + entry->path_offset;
-	pod_byte_t* data = entry->compression_level > 0 ? pod_decompress(pod_file->data + entry->offset, entry->size, entry->uncompressed, name, NULL) : NULL;
-
-	if (data == NULL) {
-		if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
-		{
-			fprintf(stderr, "ERROR: pod_file_pod5_extract_entry() fwrite failed!\n");
-			fclose(file);
-			return false;
-		}
-	}
-	else {
-		if (fwrite(data, entry->uncompressed, 1, file) != 1)
-		{
-			fprintf(stderr, "ERROR: pod_file_pod5_extract_entry() fwrite failed!\n");
-			fclose(file);
-			return false;
-		}
+	bool ok = pod_file_pod5_write_entry(pod_file, entry_index, file);
+	if (fclose(file) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_extract_entry(fclose(%s) failed: %s\n", dst, strerror(errno));
+		ok = false;
 	}
-
-	fclose(file);
-	return true;
+	return ok;
 }
 
 pod_file_pod5_t* pod_file_pod5_delete(pod_file_pod5_t* podfile)
@@ -442,6 +451,13 @@ pod_file_pod5_t* pod_file_pod5_delete(pod_file_pod5_t* podfile)
 			free(podfile->gap_sizes);
 			podfile->gap_sizes = NULL;
 		}
+		podfile->index = pod_index_delete(podfile->index);
+		podfile->tree = pod_tree_delete(podfile->tree);
+		if(podfile->store)
+		{
+			podfile->store = pod_store_close(podfile->store);
+			podfile->data = NULL;
+		}
 		if(podfile->data)
 		{
 			free(podfile->data);
@@ -480,7 +496,7 @@ bool pod_audit_entry_pod5_print(pod_audit_entry_pod5_t* audit)
 	return true;
 }
 
-bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_char_t* pattern)
+bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_match_t* match)
 {
 	if(pod_file == NULL)
 	{
@@ -488,19 +504,23 @@ bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_char_t* pattern)
 		return false;
 	}
 
+	/* lazy archives list without touching entry data */
+	pod_bool_t lazy = pod_store_is_lazy(pod_file->store);
+	pod_char_t checksum[POD_CHECKSUM_STRING_SIZE];
+
 	/* print entries */
 	printf("\nEntries:\n");
 	for(pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
 		pod_entry_pod5_t* entry = &pod_file->entries[i];
 		pod_char_t* name = pod_file->path_data + entry->path_offset;
-		if (pattern && strstr(name, pattern) == NULL)
+		if (!pod_match_test(match, name))
 			continue;
-		printf("%10u %10u %.8X/%.8X %10u/%10u %u %s %s %10u\n",
+		printf("%10u %10u %.8X/%s %10u/%10u %u %s %s %10u\n",
 		       	i,
 			entry->offset,
 			entry->checksum,
-			pod_crc_pod5_entry(pod_file, i),
+			pod_checksum_str(checksum, "%.8X", lazy ? 0 : pod_crc_pod5_entry(pod_file, i), !lazy),
 			entry->size,
 			entry->uncompressed,
 			entry->compression_level,
@@ -523,13 +543,14 @@ bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_char_t* pattern)
 	}
 
 	/* print file summary */
+	pod_char_t file_checksum[POD_CHECKSUM_STRING_SIZE];
 	printf("\nSummary:\n \
-	        file checksum      : 0x%.8X/% 11d\n \
+	        file checksum      : %s\n \
 	        size               : 0x%.8zX/% 11zd\n \
 		filename           : %s\n \
 		format             : %s\n \
 		comment            : %s\n \
-		data checksum      : 0x%.8X/ 0x%.8X\n \
+		data checksum      : 0x%.8X/ %s\n \
 		file entries       : 0x%.8X/% 11d\n \
 		audit entries      : 0x%.8X/% 11d\n \
 		revision           : 0x%.8X/% 11d\n \
@@ -543,13 +564,13 @@ bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_char_t* pattern)
 		flag1              : 0x%.8X/% 11d\n \
 		unknown1           : 0x%.8X/% 11d\n \
 		next_archive       : %s\n",
-		pod_file->checksum, pod_file->checksum,
+		pod_checksum_str(file_checksum, "0x%.8X/% 11d", pod_file->checksum, pod_file->checksum_valid),
 		pod_file->size, pod_file->size,
 		pod_file->filename,
 		pod_type_desc_str(pod_type(pod_file->header->ident)),
 		pod_file->header->comment,
 		pod_file->header->checksum,
-		pod_crc_pod5(pod_file),
+		pod_checksum_str(checksum, "0x%.8X", lazy ? 0 : pod_crc_pod5(pod_file), !lazy),
 		pod_file->header->file_count,pod_file->header->file_count,
 		pod_file->header->audit_file_count,pod_file->header->audit_file_count,
 		pod_file->header->revision,pod_file->header->revision,
@@ -569,124 +590,51 @@ bool pod_file_pod5_print(pod_file_pod5_t* pod_file, pod_char_t* pattern)
 
 /* Extract POD5 file pod_file to directory dst                       */
 /* @returns true on success otherwise false and leaves errno         */
-bool pod_file_pod5_extract(pod_file_pod5_t* pod_file, pod_string_t pattern, pod_string_t dst)
+bool pod_file_pod5_extract(pod_file_pod5_t* pod_file, pod_match_t* match, pod_string_t dst)
 {
-	pod_bool_t absolute = false;
 	if (pod_file == NULL)
 	{
 		fprintf(stderr, "ERROR: pod_file_pod5_extract(pod_file == NULL)\n");
 		return false;
 	}
 
-	if (dst == NULL) { dst = "./"; }
-
-	pod_char_t cwd[POD_SYSTEM_PATH_SIZE];
-	getcwd(cwd, sizeof(cwd));
-	printf("cwd: %s\n", cwd);
-	pod_path_t root = pod_path_system_root();
-
-	printf("root: %s\n", root);
-	pod_path_t path = NULL;
-
-	if (absolute)
-	{
-		path = pod_path_append(root, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", root, dst);
-			free(root);
-			return false;
-		}
-	}
-	else
-	{
-		path = pod_path_append(cwd, dst);
-		if (!path)
-		{
-			fprintf(stderr, "ERROR: pod_path_append(%s,%s)\n", cwd, dst);
-			free(root);
-			return false;
-		}
-	}
-
-	printf("path: %s\n", path);
-	/* create and change to destination directory */
-	if (mkdir_p(path, ACCESSPERMS) != 0)
-	{
-		fprintf(stderr, "mkdir_p(\"%s\", \'%c\') = %s\n", dst, '/', strerror(errno));
-		return false;
-	}
-
-	if (chdir(path) != 0)
-	{
-		fprintf(stderr, "chdir(%s) = %s\n", path, strerror(errno));
+	/* entries are created relative to dst, the working directory stays */
+	pod_dest_t* dir = pod_dest_open(dst);
+	if (dir == NULL)
 		return false;
-	}
 
 	/* extract entries */
-	for (int i = 0; i < pod_file->header->file_count; i++)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_string_t filename = strdup(pod_file->path_data + pod_file->entries[i].path_offset);
-		if (!filename)
-		{
-			fprintf(stderr, "ERROR: pod_file_pod5_extract(filename == NULL)\n");
-			return false;
-		}
-		if (pattern && strstr(filename, pattern) == NULL)
-		{
-			free(filename);
+		pod_char_t* filename = pod_file->path_data + pod_file->entries[i].path_offset;
+		if (!pod_match_test(match, filename))
 			continue;
-		}
 
-		pod_string_t basename = pod_path_dirname(filename);
-		if (!basename)
+		/* open and create directories including parents */
+		FILE* file = pod_dest_fopen(dir, filename);
+		if (file == NULL)
 		{
-			fprintf(stderr, "ERROR: pod_path_dirname(%s) failed: %s\n", filename, strerror(errno));
-			free(filename);
+			pod_dest_close(dir);
 			return false;
 		}
 
-		/* open and create directories including parents */
-		if (strlen(basename) > 0 && mkdir_p(pod_path_append(path, basename), ACCESSPERMS) != 0)
+		bool ok = pod_file_pod5_write_entry(pod_file, i, file);
+		if (fclose(file) != 0)
 		{
-			fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", basename, strerror(errno));
-			return false;
+			fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", filename, strerror(errno));
+			ok = false;
 		}
-		FILE* file = fopen(filename, "wb");
-		if (file == NULL)
+		if (!ok)
 		{
-			fprintf(stderr, "ERROR: pod_fopen_mkdir(%s) failed: %s\n", filename, strerror(errno));
+			pod_dest_close(dir);
 			return false;
 		}
-		pod_entry_pod5_t* entry = &pod_file->entries[i];
-
-		pod_byte_t* data = pod_decompress(pod_file->data + entry->offset, entry->size, entry->uncompressed, filename, NULL);
-
-		if (data == NULL) {
-			if (fwrite(pod_file->data + entry->offset, entry->size, 1, file) != 1)
-			{
-				fprintf(stderr, "ERROR: pod_file_pod5_extract() fwrite failed!\n");
-				fclose(file);
-				return false;
-			}
-		}
-		else {
-			if (fwrite(data, entry->uncompressed, 1, file) != 1)
-			{
-				fprintf(stderr, "ERROR: pod_file_pod5_extract() fwrite failed!\n");
-				fclose(file);
-				return false;
-			}
-		}
 
 		/* Debug/Info print thingy */
-		fprintf(stderr, "%s -> %s\n", filename, pod_path_append(path, filename));
-
-		/* clean up and pop */
-		fclose(file);
-		free(filename);
+		fprintf(stderr, "%s -> %s/%s\n", filename, dir->path, filename);
 	}
-	chdir(cwd);
+
+	pod_dest_close(dir);
 	return true;
 }
 
@@ -698,35 +646,32 @@ bool pod_file_pod5_write(pod_file_pod5_t* pod_file, pod_string_t filename)
 		return false;
 	}
 
+	if (pod_file->store != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_file_pod5_write() archive is mapped read-only!\n");
+		return false;
+	}
+
 	// apply all path_data to the end of the pod_file->data.
-	// start at the end of the file and work backwards
+	// names follow each other in entry order, note where each one starts
 
+	size_t* name_offsets = malloc((pod_file->header->file_count + 1) * sizeof(size_t));
+	if (!name_offsets) {
+		fprintf(stderr, "ERROR: allocating name offsets!\n");
+		return false;
+	}
 	pod_file->path_data_size = 0;
-	for (int i = pod_file->header->file_count - 1; i >= 0; i--)
+	for (pod_number_t i = 0; i < pod_file->header->file_count; i++)
 	{
-		pod_entry_pod5_t* entry = &pod_file->entries[i];
-
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
-
-		size_t name_size = strlen(name) + 1;
-		pod_file->path_data_size += name_size;
+		name_offsets[i] = pod_file->path_data_size;
+		pod_file->path_data_size += strlen(pod_file->path_data + pod_file->path_data_size) + 1;
 	}
 
 	size_t new_total_size = pod_file->size + pod_file->path_data_size + pod_file->header->file_count * POD_DIR_ENTRY_POD5_SIZE;
 	void* new_data = realloc(pod_file->data, new_total_size);
 	if (!new_data) {
 		fprintf(stderr, "ERROR: extending data entries!\n");
+		free(name_offsets);
 		return false;
 	}
 	pod_file->data = new_data;
@@ -750,24 +695,14 @@ bool pod_file_pod5_write(pod_file_pod5_t* pod_file, pod_string_t filename)
 	{
 		pod_entry_pod5_t* entry = &pod_file->entries[i];
 
-		pod_char_t* name = NULL;
-		size_t name_cursor = 0;
-		for (int j = 0; j < i + 1; j++)
-		{
-			size_t name_size = strlen(pod_file->path_data + name_cursor) + 1;
-			if (j == i)
-			{
-				name = pod_file->path_data + name_cursor;
-				break;
-			}
-			name_cursor += name_size;
-		}
+		pod_char_t* name = pod_file->path_data + name_offsets[i];
 
 		size_t name_size = strlen(name) + 1;
 		entry->path_offset = path_data_size2;
 		memcpy(pod_file->data + pod_file->size + path_data_size2, name, name_size);
 		path_data_size2 += name_size;
 	}
+	free(name_offsets);
 	pod_file->size += pod_file->path_data_size;
 	pod_file->path_data = (pod_char_t*)(pod_file->data + pod_file->size - pod_file->path_data_size);
 	pod_file->header->size_index = pod_file->path_data_size;
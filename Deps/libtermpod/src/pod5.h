@@ -85,8 +85,12 @@ typedef struct pod_file_pod5_s
 	pod_string_t filename;
 	pod_size_t size;
 	pod_number_t checksum;
+	pod_bool_t checksum_valid; /* false if a mapped or lazy open skipped the file pass */
 	pod_byte_t* data_start;
 	pod_zip_entry_pod5_t* zip_entries;
+	pod_store_t* store; /* NULL unless the archive is mapped */
+	pod_index_t* index; /* name lookup, built on first use */
+	pod_tree_t* tree; /* directory tree, built on first use */
 	/* end of not serialized content */
 } pod_file_pod5_t;
 
@@ -98,13 +102,16 @@ uint32_t pod_crc_pod5_audit(pod_file_pod5_t* file, pod_number_t audit_index);
 pod_bool_t pod_file_pod5_update_sizes(pod_file_pod5_t* pod_file);
 pod_checksum_t   pod_file_pod5_chksum(pod_file_pod5_t* podfile);
 pod_file_pod5_t* pod_file_pod5_create(pod_string_t filename);
+pod_file_pod5_t* pod_file_pod5_open(pod_string_t filename, pod_open_mode_t mode);
 pod_file_pod5_t*  pod_file_pod5_delete(pod_file_pod5_t* podfile);
-bool pod_file_pod5_print(pod_file_pod5_t* podfile, pod_char_t* pattern);
+bool pod_file_pod5_print(pod_file_pod5_t* podfile, pod_match_t* match);
 bool pod_file_pod5_write(pod_file_pod5_t* pod_file, pod_string_t filename);
 bool pod_audit_entry_pod5_print(pod_audit_entry_pod5_t* audit);
 bool pod_file_pod5_add_entry(pod_file_pod5_t* pod_file, pod_entry_pod5_t* entry, pod_string_t filename, pod_byte_t* data);
 bool pod_file_pod5_del_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index);
 pod_entry_pod5_t* pod_file_pod5_get_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index);
+bool pod_file_pod5_stream_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, pod_sink_t sink, void* context);
+bool pod_file_pod5_write_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, FILE* file);
 bool pod_file_pod5_extract_entry(pod_file_pod5_t* pod_file, pod_number_t entry_index, pod_string_t dst);
-bool pod_file_pod5_extract(pod_file_pod5_t* pod_file, pod_string_t pattern, pod_string_t dst);
+bool pod_file_pod5_extract(pod_file_pod5_t* pod_file, pod_match_t* match, pod_string_t dst);
 #endif
@@ -0,0 +1,261 @@
+#include "libtermpod.h"
+
+/* headers of the formats laid out here, directory and path table in front of the data */
+typedef union pod_builder_header_u
+{
+	pod_header_pod1_t pod1;
+	pod_header_pod2_t pod2;
+	pod_header_epd_t epd;
+} pod_builder_header_t;
+
+/* @returns the size of the name field for formats that keep names in the directory, 0 otherwise */
+static pod_size_t pod_builder_name_size(pod_ident_type_t type)
+{
+	switch(type)
+	{
+		case POD1:
+			return POD_DIR_ENTRY_POD1_FILENAME_SIZE;
+		case EPD:
+			return POD_DIR_ENTRY_EPD_FILENAME_SIZE;
+		default:
+			return 0;
+	}
+}
+
+pod_builder_t* pod_builder_create(pod_ident_type_t type)
+{
+	if(type <= UNKNOWN || type >= POD_IDENT_TYPE_SIZE)
+	{
+		fprintf(stderr, "ERROR: pod_builder_create() unknown file format!\n");
+		return NULL;
+	}
+
+	pod_builder_t* builder = calloc(1, sizeof(pod_builder_t));
+	if(builder == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_builder_create() could not allocate builder!\n");
+		return NULL;
+	}
+	builder->type = type;
+	return builder;
+}
+
+pod_builder_t* pod_builder_delete(pod_builder_t* builder)
+{
+	if(builder == NULL)
+		return NULL;
+
+	pod_writer_directory_free(&builder->directory);
+	free(builder->data);
+	free(builder);
+	return NULL;
+}
+
+/* @returns false if name does not fit the directory record of the format */
+static pod_bool_t pod_builder_name_fits(pod_builder_t* builder, const pod_char_t* name)
+{
+	pod_size_t name_size = pod_builder_name_size(builder->type);
+	if(name_size > 0 && strlen(name) + 1 > name_size)
+	{
+		fprintf(stderr, "ERROR: pod_builder_name_fits(%s) name exceeds the %zu bytes of a %s entry!\n", name, name_size, pod_type_str(builder->type));
+		return false;
+	}
+	return true;
+}
+
+pod_bool_t pod_builder_add(pod_builder_t* builder, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_size_t uncompressed, pod_number_t level, pod_time_t mtime)
+{
+	if(builder == NULL || name == NULL || (data == NULL && size > 0))
+	{
+		fprintf(stderr, "ERROR: pod_builder_add(builder == NULL || name == NULL || data == NULL)\n");
+		return false;
+	}
+	if(uncompressed > (pod_number_t)-1)
+	{
+		fprintf(stderr, "ERROR: pod_builder_add(%s) entry exceeds 4GB!\n", name);
+		return false;
+	}
+	if(!pod_builder_name_fits(builder, name))
+		return false;
+
+	/* the directory refuses data past 4GB, so only grow below that */
+	if(builder->data_size + size <= (pod_number_t)-1 &&
+	   !pod_writer_grow((void**)&builder->data, &builder->data_capacity, builder->data_size + size, 0x100000))
+		return false;
+
+	pod_writer_entry_t* entry = pod_writer_directory_append(&builder->directory, name, builder->data_size, size);
+	if(entry == NULL)
+		return false;
+
+	entry->size = (pod_number_t)size;
+	entry->offset = (pod_number_t)builder->data_size;
+	entry->uncompressed = (pod_number_t)uncompressed;
+	entry->level = level;
+	entry->timestamp = mtime > 0 ? (pod_number_t)mtime : 0;
+
+	if(size > 0)
+		memcpy(builder->data + builder->data_size, data, size);
+	builder->data_size += size;
+	return true;
+}
+
+pod_bool_t pod_builder_link(pod_builder_t* builder, const pod_char_t* name, pod_number_t source, pod_time_t mtime)
+{
+	if(builder == NULL || name == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_builder_link(builder == NULL || name == NULL)\n");
+		return false;
+	}
+
+	return pod_builder_name_fits(builder, name) && pod_writer_directory_link(&builder->directory, name, source, mtime);
+}
+
+/* POD3 to POD6: data first, the writer appends directory and path table */
+static pod_bool_t pod_builder_stream(pod_builder_t* builder, pod_path_t name, const pod_char_t* next_archive)
+{
+	pod_writer_t* writer = pod_writer_create(name, builder->type);
+	if(writer == NULL)
+		return false;
+
+	pod_bool_t ok = true;
+	for(pod_number_t i = 0; ok && i < builder->directory.count; i++)
+	{
+		const pod_writer_entry_t* entry = &builder->directory.entries[i];
+		const pod_char_t* name = builder->directory.path_data + entry->path_offset;
+		if(entry->source != i)
+			ok = pod_writer_link(writer, name, entry->source, (pod_time_t)entry->timestamp);
+		else
+			ok = pod_writer_add(writer, name, builder->data + entry->offset,
+					    entry->size, entry->uncompressed, entry->level, (pod_time_t)entry->timestamp);
+	}
+
+	ok = ok && pod_writer_finish(writer, next_archive);
+	pod_writer_delete(writer);
+	return ok;
+}
+
+static pod_bool_t pod_builder_put(FILE* output, pod_path_t name, const void* data, pod_size_t size)
+{
+	if(size > 0 && fwrite(data, 1, size, output) != size)
+	{
+		fprintf(stderr, "ERROR: pod_builder_write(%s) could not write %zu bytes: %s\n", name, size, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+/* directory record of entry for POD1, POD2 and EPD with the data at data_start */
+static pod_bool_t pod_builder_put_entry(pod_builder_t* builder, FILE* output, pod_path_t name, const pod_writer_entry_t* entry, pod_size_t data_start)
+{
+	const pod_char_t* path = builder->directory.path_data + entry->path_offset;
+	pod_number_t offset = (pod_number_t)(data_start + entry->offset);
+	pod_number_t checksum = entry->size > 0 ? pod_crc(builder->data + entry->offset, entry->size) : 0;
+
+	switch(builder->type)
+	{
+		case POD1:
+		{
+			pod_entry_pod1_t record;
+			memset(&record, 0, sizeof(record));
+			strcpy(record.name, path);
+			record.size = entry->size;
+			record.offset = offset;
+			return pod_builder_put(output, name, &record, POD_DIR_ENTRY_POD1_SIZE);
+		}
+		case POD2:
+		{
+			pod_entry_pod2_t record = { entry->path_offset, entry->size, offset, (pod_time_t)entry->timestamp, checksum };
+			return pod_builder_put(output, name, &record, POD_DIR_ENTRY_POD2_SIZE);
+		}
+		case EPD:
+		{
+			pod_entry_epd_t record;
+			memset(&record, 0, sizeof(record));
+			strcpy(record.name, path);
+			record.size = entry->size;
+			record.offset = offset;
+			record.timestamp = entry->timestamp;
+			record.checksum = checksum;
+			return pod_builder_put(output, name, &record, POD_DIR_ENTRY_EPD_SIZE);
+		}
+		default:
+			return false;
+	}
+}
+
+/* POD1, POD2 and EPD: header, directory, POD2 path table, then the data */
+static pod_bool_t pod_builder_front(pod_builder_t* builder, pod_path_t name)
+{
+	pod_builder_header_t header;
+	memset(&header, 0, sizeof(header));
+	pod_size_t header_size = 0;
+	pod_size_t entry_size = 0;
+	pod_size_t path_size = 0;
+
+	switch(builder->type)
+	{
+		case POD1:
+			header.pod1.file_count = builder->directory.count;
+			header_size = POD_HEADER_POD1_SIZE;
+			entry_size = POD_DIR_ENTRY_POD1_SIZE;
+			break;
+		case POD2:
+			memcpy(header.pod2.ident, POD_IDENT[POD2], POD_IDENT_SIZE);
+			header.pod2.file_count = builder->directory.count;
+			header_size = POD_HEADER_POD2_SIZE;
+			entry_size = POD_DIR_ENTRY_POD2_SIZE;
+			path_size = builder->directory.path_data_size;
+			break;
+		case EPD:
+			memcpy(header.epd.ident, POD_IDENT[EPD], POD_IDENT_SIZE);
+			header.epd.file_count = builder->directory.count;
+			header_size = POD_HEADER_EPD_SIZE;
+			entry_size = POD_DIR_ENTRY_EPD_SIZE;
+			break;
+		default:
+			return false;
+	}
+
+	pod_size_t data_start = header_size + builder->directory.count * entry_size + path_size;
+	if(data_start + builder->data_size > (pod_number_t)-1)
+	{
+		fprintf(stderr, "ERROR: pod_builder_write(%s) archive would exceed 4GB!\n", name);
+		return false;
+	}
+
+	FILE* output = fopen(name, "wb");
+	if(output == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_builder_write(%s) could not open output: %s\n", name, strerror(errno));
+		return false;
+	}
+	setvbuf(output, NULL, _IOFBF, POD_WRITER_BUFFER_SIZE);
+
+	pod_bool_t ok = pod_builder_put(output, name, &header, header_size);
+	for(pod_number_t i = 0; ok && i < builder->directory.count; i++)
+		ok = pod_builder_put_entry(builder, output, name, &builder->directory.entries[i], data_start);
+	ok = ok && pod_builder_put(output, name, builder->directory.path_data, path_size) &&
+	     pod_builder_put(output, name, builder->data, builder->data_size);
+
+	if(fclose(output) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_builder_write(%s) fclose failed: %s\n", name, strerror(errno));
+		ok = false;
+	}
+	if(!ok)
+		remove(name);
+	return ok;
+}
+
+pod_bool_t pod_builder_write(pod_builder_t* builder, pod_path_t name, const pod_char_t* next_archive)
+{
+	if(builder == NULL || name == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_builder_write(builder == NULL || name == NULL)\n");
+		return false;
+	}
+
+	if(pod_writer_supports(builder->type))
+		return pod_builder_stream(builder, name, next_archive);
+	return pod_builder_front(builder, name);
+}
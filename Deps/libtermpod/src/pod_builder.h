@@ -0,0 +1,30 @@
+#ifndef _POD_BUILDER_H
+#define _POD_BUILDER_H
+
+/* archive of any format assembled in memory and written in one pass.   */
+/* Entry data, directory records and the path string pool grow by       */
+/* doubling, each record keeps the offset of its name in the pool, so   */
+/* adding is amortised constant and writing never searches for a name.  */
+/* Formats with their directory behind the data go out through a        */
+/* pod_writer_t, the others are laid out here once the sizes are known. */
+typedef struct pod_builder_s
+{
+	pod_ident_type_t type;
+	pod_writer_directory_t directory; /* record offsets are into data */
+	pod_byte_t* data;
+	pod_size_t data_size;
+	pod_size_t data_capacity;
+} pod_builder_t;
+
+pod_builder_t* pod_builder_create(pod_ident_type_t type);
+pod_builder_t* pod_builder_delete(pod_builder_t* builder);
+/* copy size stored bytes of data as entry name, compressed by level from */
+/* uncompressed bytes or stored as is with level 0                        */
+pod_bool_t pod_builder_add(pod_builder_t* builder, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_size_t uncompressed, pod_number_t level, pod_time_t mtime);
+/* add entry name sharing the data of entry source */
+pod_bool_t pod_builder_link(pod_builder_t* builder, const pod_char_t* name, pod_number_t source, pod_time_t mtime);
+/* write the archive to name; next_archive chains POD5 and POD6 volumes */
+/* and may be NULL                                                      */
+pod_bool_t pod_builder_write(pod_builder_t* builder, pod_path_t name, const pod_char_t* next_archive);
+
+#endif
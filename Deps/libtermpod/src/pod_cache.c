@@ -0,0 +1,244 @@
+#include "pod_common.h"
+
+static pod_bool_t pod_cache_enabled = false;
+
+void pod_cache_enable(pod_bool_t enable)
+{
+	pod_cache_enabled = enable;
+}
+
+pod_bool_t pod_cache_is_enabled()
+{
+	return pod_cache_enabled;
+}
+
+/* @returns archive name with POD_CACHE_SUFFIX appended, owned by caller */
+static pod_string_t pod_cache_filename(pod_string_t archive)
+{
+	pod_size_t len = strlen(archive);
+	pod_string_t name = malloc(len + sizeof(POD_CACHE_SUFFIX));
+	if(name == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_cache_filename() could not allocate name for %s!\n", archive);
+		return NULL;
+	}
+	memcpy(name, archive, len);
+	memcpy(name + len, POD_CACHE_SUFFIX, sizeof(POD_CACHE_SUFFIX));
+	return name;
+}
+
+/* @returns true if the body read into cache only refers within itself and */
+/* the archive, lookups index names and slots without further checks       */
+static pod_bool_t pod_cache_valid(const pod_cache_header_t* head, const pod_cache_t* cache)
+{
+	const pod_index_t* index = cache->index;
+	for(pod_number_t i = 0; i < head->gap_count; i++)
+	{
+		if(cache->gap_sizes[i] > head->archive_size)
+			return false;
+	}
+
+	pod_number_t used = 0;
+	for(pod_size_t i = 0; i < index->capacity; i++)
+	{
+		if(index->slots[i].entry > head->entries)
+			return false;
+		if(index->slots[i].entry != 0)
+			used++;
+	}
+	if(used != head->index_count)
+		return false;
+
+	/* every name ends inside the pool once the pool ends with a NUL */
+	if(head->names_size > 0 && index->names[head->names_size - 1] != '\0')
+		return false;
+	for(pod_number_t i = 0; i < head->entries; i++)
+	{
+		if(index->name_offsets[i] >= head->names_size && (head->names_size > 0 || head->index_count > 0))
+			return false;
+	}
+	return true;
+}
+
+pod_cache_t* pod_cache_load(pod_string_t archive, pod_byte_t* header, pod_size_t header_size, pod_number_t entries)
+{
+	if(!pod_cache_enabled || archive == NULL || header == NULL)
+		return NULL;
+
+	struct stat sb;
+	if(stat(archive, &sb) != 0)
+		return NULL;
+
+	pod_string_t name = pod_cache_filename(archive);
+	if(name == NULL)
+		return NULL;
+
+	FILE* file = fopen(name, "rb");
+	free(name);
+	if(file == NULL)
+		return NULL;
+
+	struct stat sidecar;
+	pod_cache_header_t head;
+	if(fstat(fileno(file), &sidecar) != 0 ||
+	   fread(&head, sizeof(head), 1, file) != 1 ||
+	   memcmp(head.ident, POD_CACHE_IDENT, POD_IDENT_SIZE) != 0 ||
+	   head.version != POD_CACHE_VERSION ||
+	   head.archive_size != (uint64_t)sb.st_size ||
+	   head.archive_mtime != (int64_t)sb.st_mtime ||
+	   head.header_checksum != pod_crc(header, header_size))
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	/* the body has to fill the sidecar exactly and describe this directory; */
+	/* every entry lies within the archive, so sizes sum to at most that     */
+	if(head.entries != entries ||
+	   (head.gap_count != 0 && head.gap_count != entries) ||
+	   head.index_count > entries ||
+	   head.data_start > head.archive_size ||
+	   (entries > 0 ? head.entry_data_size / entries > head.archive_size : head.entry_data_size > 0) ||
+	   head.index_capacity > (uint64_t)sidecar.st_size ||
+	   head.names_size > (uint64_t)sidecar.st_size ||
+	   sizeof(head) + head.gap_count * sizeof(pod_number_t) + head.index_capacity * sizeof(pod_index_slot_t) +
+	   head.entries * sizeof(pod_number_t) + head.names_size != (uint64_t)sidecar.st_size)
+	{
+		fprintf(stderr, "WARNING: pod_cache_load() ignoring corrupt index of %s\n", archive);
+		fclose(file);
+		return NULL;
+	}
+
+	pod_cache_t* cache = calloc(1, sizeof(pod_cache_t));
+	if(cache == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_cache_load() could not allocate cache!\n");
+		fclose(file);
+		return NULL;
+	}
+
+	/* gap_sizes always span the directory, formats without gaps ignore them */
+	cache->checksum = head.checksum;
+	cache->entries = head.entries;
+	cache->data_start = head.data_start;
+	cache->entry_data_size = head.entry_data_size;
+	cache->gap_count = head.gap_count;
+	cache->gap_sizes = calloc(entries > 0 ? entries : 1, sizeof(pod_number_t));
+	cache->index = pod_index_create(head.entries);
+
+	/* the slot count follows from the entry count, anything else is stale */
+	if(cache->gap_sizes == NULL || cache->index == NULL ||
+	   cache->index->capacity != head.index_capacity ||
+	   (cache->index->names = malloc(head.names_size > 0 ? head.names_size : 1)) == NULL)
+	{
+		fclose(file);
+		return pod_cache_delete(cache);
+	}
+
+	cache->index->count = head.index_count;
+	cache->index->names_size = head.names_size;
+	cache->index->names_used = head.names_size;
+
+	if(fread(cache->gap_sizes, sizeof(pod_number_t), head.gap_count, file) != head.gap_count ||
+	   fread(cache->index->slots, sizeof(pod_index_slot_t), head.index_capacity, file) != head.index_capacity ||
+	   fread(cache->index->name_offsets, sizeof(pod_number_t), head.entries, file) != head.entries ||
+	   fread(cache->index->names, sizeof(pod_char_t), head.names_size, file) != head.names_size)
+	{
+		fprintf(stderr, "WARNING: pod_cache_load() ignoring truncated index of %s\n", archive);
+		fclose(file);
+		return pod_cache_delete(cache);
+	}
+	fclose(file);
+
+	if(!pod_cache_valid(&head, cache))
+	{
+		fprintf(stderr, "WARNING: pod_cache_load() ignoring corrupt index of %s\n", archive);
+		return pod_cache_delete(cache);
+	}
+	return cache;
+}
+
+pod_bool_t pod_cache_save(pod_string_t archive, pod_size_t header_size, pod_cache_t* cache)
+{
+	if(archive == NULL || cache == NULL || cache->index == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_cache_save() invalid arguments!\n");
+		return false;
+	}
+
+	struct stat sb;
+	if(stat(archive, &sb) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_cache_save() stat(%s) failed: %s\n", archive, strerror(errno));
+		return false;
+	}
+
+	/* loaders may patch header fields in memory, hash what is on disk */
+	pod_byte_t* header = malloc(header_size);
+	FILE* src = fopen(archive, "rb");
+	if(header == NULL || src == NULL || fread(header, header_size, 1, src) != 1)
+	{
+		fprintf(stderr, "ERROR: pod_cache_save() could not read header of %s!\n", archive);
+		if(src)
+			fclose(src);
+		free(header);
+		return false;
+	}
+	fclose(src);
+
+	pod_cache_header_t head = { 0 };
+	memcpy(head.ident, POD_CACHE_IDENT, POD_IDENT_SIZE);
+	head.version = POD_CACHE_VERSION;
+	head.archive_size = sb.st_size;
+	head.archive_mtime = sb.st_mtime;
+	head.header_checksum = pod_crc(header, header_size);
+	head.checksum = cache->checksum;
+	head.entries = cache->entries;
+	head.data_start = cache->data_start;
+	head.gap_count = cache->gap_sizes ? cache->gap_count : 0;
+	head.index_count = cache->index->count;
+	head.entry_data_size = cache->entry_data_size;
+	head.index_capacity = cache->index->capacity;
+	head.names_size = cache->index->names_used;
+	free(header);
+
+	pod_string_t name = pod_cache_filename(archive);
+	if(name == NULL)
+		return false;
+
+	FILE* file = fopen(name, "wb");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_cache_save() fopen(%s) failed: %s\n", name, strerror(errno));
+		free(name);
+		return false;
+	}
+
+	if(fwrite(&head, sizeof(head), 1, file) != 1 ||
+	   fwrite(cache->gap_sizes, sizeof(pod_number_t), head.gap_count, file) != head.gap_count ||
+	   fwrite(cache->index->slots, sizeof(pod_index_slot_t), head.index_capacity, file) != head.index_capacity ||
+	   fwrite(cache->index->name_offsets, sizeof(pod_number_t), head.entries, file) != head.entries ||
+	   fwrite(cache->index->names, sizeof(pod_char_t), head.names_size, file) != head.names_size)
+	{
+		fprintf(stderr, "ERROR: pod_cache_save() could not write %s!\n", name);
+		fclose(file);
+		remove(name);
+		free(name);
+		return false;
+	}
+
+	fclose(file);
+	free(name);
+	return true;
+}
+
+pod_cache_t* pod_cache_delete(pod_cache_t* cache)
+{
+	if(cache == NULL)
+		return NULL;
+
+	free(cache->gap_sizes);
+	pod_index_delete(cache->index);
+	free(cache);
+	return NULL;
+}
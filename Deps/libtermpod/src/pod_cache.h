@@ -0,0 +1,51 @@
+#ifndef _POD_CACHE_H
+#define _POD_CACHE_H
+
+#define POD_CACHE_SUFFIX                     ".podidx"                /* sidecar next to the archive    */
+#define POD_CACHE_IDENT                      "PIDX"                   /* sidecar file magic             */
+#define POD_CACHE_VERSION                    2                        /* bump on layout changes         */
+
+/* on disk header of a .podidx sidecar, followed by gap_sizes[gap_count],   */
+/* slots[index_capacity], name_offsets[entries] and names[names_size]       */
+typedef struct pod_cache_header_s
+{
+	pod_char_t ident[POD_IDENT_SIZE];
+	pod_number_t version;
+	uint64_t archive_size;
+	int64_t archive_mtime;
+	pod_number_t header_checksum; /* crc of the archive header bytes */
+	pod_number_t checksum;        /* crc of the whole archive */
+	pod_number_t entries;
+	pod_number_t data_start;      /* offset of the first entry */
+	pod_number_t gap_count;
+	pod_number_t index_count;
+	uint64_t entry_data_size;
+	uint64_t index_capacity;
+	uint64_t names_size;
+} pod_cache_header_t;
+
+/* warm open state of an archive, gap_sizes are in ascending offset order   */
+typedef struct pod_cache_s
+{
+	pod_number_t checksum;
+	pod_number_t entries;
+	pod_number_t data_start;
+	pod_size_t entry_data_size;
+	pod_number_t* gap_sizes;
+	pod_number_t gap_count;
+	pod_index_t* index;
+} pod_cache_t;
+
+/* sidecars are neither read nor written unless enabled */
+void pod_cache_enable(pod_bool_t enable);
+pod_bool_t pod_cache_is_enabled();
+
+/* @returns the sidecar of archive if it matches size, mtime, header and   */
+/* the entries of the directory and its body is consistent, otherwise NULL; */
+/* stale, corrupt or missing sidecars are not an error                     */
+pod_cache_t* pod_cache_load(pod_string_t archive, pod_byte_t* header, pod_size_t header_size, pod_number_t entries);
+/* write cache next to archive, the header checksum is taken from disk     */
+pod_bool_t pod_cache_save(pod_string_t archive, pod_size_t header_size, pod_cache_t* cache);
+pod_cache_t* pod_cache_delete(pod_cache_t* cache);
+
+#endif
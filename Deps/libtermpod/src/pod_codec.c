@@ -0,0 +1,379 @@
+#include "pod_common.h"
+#include "zlib.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+#ifdef POD_HAVE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+struct pod_codec_s
+{
+	z_stream inflate;
+	z_stream deflate;
+	pod_bool_t inflate_ready;
+	pod_bool_t deflate_ready;
+	int level;              /* level the deflate stream is set to */
+	pod_byte_t* buffer;     /* whole entries of one-shot backends */
+	pod_size_t buffer_size;
+#ifdef POD_HAVE_LIBDEFLATE
+	struct libdeflate_decompressor* libdeflate;
+#endif
+};
+
+static pod_bool_t pod_codec_zlib_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name);
+#ifdef POD_HAVE_LIBDEFLATE
+static pod_bool_t pod_codec_libdeflate_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name);
+#endif
+
+static const pod_codec_backend_t pod_codec_backends[] =
+{
+	{ "zlib", false, pod_codec_zlib_inflate },
+#ifdef POD_HAVE_LIBDEFLATE
+	{ "libdeflate", true, pod_codec_libdeflate_inflate },
+#endif
+};
+
+static const pod_codec_backend_t* pod_codec_selected = &pod_codec_backends[0];
+
+pod_number_t pod_codec_backend_count()
+{
+	return sizeof(pod_codec_backends) / sizeof(pod_codec_backends[0]);
+}
+
+const pod_codec_backend_t* pod_codec_backend_get(pod_number_t index)
+{
+	return index < pod_codec_backend_count() ? &pod_codec_backends[index] : NULL;
+}
+
+const pod_codec_backend_t* pod_codec_backend()
+{
+	return pod_codec_selected;
+}
+
+pod_bool_t pod_codec_backend_select(const pod_char_t* name)
+{
+	for(pod_number_t i = 0; i < pod_codec_backend_count(); i++)
+	{
+		if(name != NULL && strcmp(pod_codec_backends[i].name, name) == 0)
+		{
+			pod_codec_selected = &pod_codec_backends[i];
+			return true;
+		}
+	}
+
+	fprintf(stderr, "ERROR: pod_codec_backend_select() unknown inflate backend %s!\n", name ? name : "(null)");
+	return false;
+}
+
+pod_codec_t* pod_codec_create()
+{
+	pod_codec_t* codec = calloc(1, sizeof(pod_codec_t));
+	if(codec == NULL)
+		fprintf(stderr, "ERROR: pod_codec_create() could not allocate codec!\n");
+	return codec;
+}
+
+pod_codec_t* pod_codec_delete(pod_codec_t* codec)
+{
+	if(codec == NULL)
+		return NULL;
+
+	if(codec->inflate_ready)
+		inflateEnd(&codec->inflate);
+	if(codec->deflate_ready)
+		deflateEnd(&codec->deflate);
+#ifdef POD_HAVE_LIBDEFLATE
+	if(codec->libdeflate)
+		libdeflate_free_decompressor(codec->libdeflate);
+#endif
+	free(codec->buffer);
+	free(codec);
+	return NULL;
+}
+
+#ifdef _WIN32
+static DWORD pod_codec_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE pod_codec_once = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI pod_codec_thread_exit(PVOID codec)
+{
+	pod_codec_delete(codec);
+}
+
+static BOOL CALLBACK pod_codec_key_create(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+	pod_codec_key = FlsAlloc(pod_codec_thread_exit);
+	return pod_codec_key != FLS_OUT_OF_INDEXES;
+}
+#else
+static pthread_key_t pod_codec_key;
+static pthread_once_t pod_codec_once = PTHREAD_ONCE_INIT;
+static pod_bool_t pod_codec_key_ready = false;
+
+static void pod_codec_thread_exit(void* codec)
+{
+	pod_codec_delete(codec);
+}
+
+static void pod_codec_key_create()
+{
+	pod_codec_key_ready = pthread_key_create(&pod_codec_key, pod_codec_thread_exit) == 0;
+}
+#endif
+
+pod_codec_t* pod_codec_thread()
+{
+	pod_codec_t* codec = NULL;
+#ifdef _WIN32
+	if(!InitOnceExecuteOnce(&pod_codec_once, pod_codec_key_create, NULL, NULL))
+	{
+		fprintf(stderr, "ERROR: pod_codec_thread() FlsAlloc failed!\n");
+		return NULL;
+	}
+	codec = FlsGetValue(pod_codec_key);
+	if(codec == NULL && (codec = pod_codec_create()) != NULL)
+		FlsSetValue(pod_codec_key, codec);
+#else
+	pthread_once(&pod_codec_once, pod_codec_key_create);
+	if(!pod_codec_key_ready)
+	{
+		fprintf(stderr, "ERROR: pod_codec_thread() pthread_key_create failed!\n");
+		return NULL;
+	}
+	codec = pthread_getspecific(pod_codec_key);
+	if(codec == NULL && (codec = pod_codec_create()) != NULL)
+		pthread_setspecific(pod_codec_key, codec);
+#endif
+	return codec;
+}
+
+/* @returns the inflate stream of codec ready for a new entry */
+static z_stream* pod_codec_inflate_begin(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_string_t name)
+{
+	if(codec == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate(codec == NULL) for %s!\n", name);
+		return NULL;
+	}
+
+	z_stream* stream = &codec->inflate;
+	if(codec->inflate_ready)
+	{
+		if(inflateReset(stream) != Z_OK)
+		{
+			inflateEnd(stream);
+			codec->inflate_ready = false;
+		}
+	}
+	if(!codec->inflate_ready)
+	{
+		memset(stream, 0, sizeof(z_stream));
+		if(inflateInit(stream) != Z_OK)
+		{
+			fprintf(stderr, "ERROR: pod_codec_inflate() failed to initialize decompression for %s!\n", name);
+			return NULL;
+		}
+		codec->inflate_ready = true;
+	}
+
+	stream->next_in = data;
+	stream->avail_in = size;
+	return stream;
+}
+
+pod_bool_t pod_codec_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_number_t uncompressed_size, pod_string_t name, pod_sink_t sink, void* context, pod_size_t* written)
+{
+	*written = 0;
+
+	/* entries up to POD_CODEC_ONESHOT_SIZE go through a one-shot backend */
+	/* in a reused buffer, larger ones always stream so memory is bounded */
+	if(codec != NULL && pod_codec_selected->one_shot && uncompressed_size <= POD_CODEC_ONESHOT_SIZE)
+	{
+		if(codec->buffer_size < uncompressed_size || codec->buffer == NULL)
+		{
+			pod_byte_t* buffer = realloc(codec->buffer, uncompressed_size > 0 ? uncompressed_size : 1);
+			if(buffer == NULL)
+			{
+				fprintf(stderr, "ERROR: pod_codec_inflate() could not allocate %u bytes for %s!\n", uncompressed_size, name);
+				return false;
+			}
+			codec->buffer = buffer;
+			codec->buffer_size = uncompressed_size;
+		}
+
+		if(!pod_codec_selected->inflate(codec, data, size, codec->buffer, uncompressed_size, name))
+			return false;
+		if(uncompressed_size > 0 && !sink(context, codec->buffer, uncompressed_size))
+			return false;
+		*written = uncompressed_size;
+		return true;
+	}
+
+	z_stream* stream = pod_codec_inflate_begin(codec, data, size, name);
+	if(stream == NULL)
+		return false;
+
+	/* one window on the stack serves the whole entry, each full window goes */
+	/* to the sink as is so nothing is copied and memory stays bounded       */
+	pod_byte_t window[POD_INFLATE_WINDOW_SIZE];
+	int ret;
+
+	do
+	{
+		stream->next_out = window;
+		stream->avail_out = sizeof(window);
+
+		ret = inflate(stream, Z_NO_FLUSH);
+		pod_size_t produced = sizeof(window) - stream->avail_out;
+		if(ret != Z_OK && ret != Z_STREAM_END)
+			break;
+
+		if(*written + produced > uncompressed_size)
+		{
+			fprintf(stderr, "ERROR: pod_codec_inflate() %s inflates past %u bytes!\n", name, uncompressed_size);
+			return false;
+		}
+		if(produced > 0 && !sink(context, window, produced))
+			return false;
+		*written += produced;
+	} while(ret == Z_OK);
+
+	if(ret != Z_STREAM_END || *written != uncompressed_size)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate() failed to decompress data for %s!\n", name);
+		return false;
+	}
+
+	return true;
+}
+
+static pod_bool_t pod_codec_zlib_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name)
+{
+	z_stream* stream = pod_codec_inflate_begin(codec, data, size, name);
+	if(stream == NULL)
+		return false;
+
+	/* inflate straight into buffer, it never grows past buffer_size */
+	stream->next_out = buffer;
+	stream->avail_out = buffer_size;
+
+	int ret;
+	do
+	{
+		ret = inflate(stream, Z_FINISH);
+	} while(ret == Z_OK);
+
+	if(ret != Z_STREAM_END || stream->avail_out != 0)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate_buffer() failed to decompress data for %s!\n", name);
+		return false;
+	}
+
+	return true;
+}
+
+#ifdef POD_HAVE_LIBDEFLATE
+static pod_bool_t pod_codec_libdeflate_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name)
+{
+	if(codec->libdeflate == NULL && (codec->libdeflate = libdeflate_alloc_decompressor()) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate_buffer() could not allocate libdeflate decompressor for %s!\n", name);
+		return false;
+	}
+
+	/* a NULL actual size makes libdeflate insist on exactly buffer_size */
+	if(libdeflate_zlib_decompress(codec->libdeflate, data, size, buffer, buffer_size, NULL) != LIBDEFLATE_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate_buffer() failed to decompress data for %s!\n", name);
+		return false;
+	}
+
+	return true;
+}
+#endif
+
+pod_bool_t pod_codec_inflate_buffer(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name)
+{
+	return pod_codec_inflate_buffer_with(codec, pod_codec_selected, data, size, buffer, buffer_size, name);
+}
+
+pod_bool_t pod_codec_inflate_buffer_with(pod_codec_t* codec, const pod_codec_backend_t* backend, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name)
+{
+	if(codec == NULL || backend == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_codec_inflate_buffer(codec == NULL || backend == NULL) for %s!\n", name);
+		return false;
+	}
+	return backend->inflate(codec, data, size, buffer, buffer_size, name);
+}
+
+pod_byte_t* pod_codec_deflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_number_t level, pod_string_t name, pod_number_t* result_size)
+{
+	if(codec == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_codec_deflate(codec == NULL) for %s!\n", name);
+		return NULL;
+	}
+
+	z_stream* stream = &codec->deflate;
+	if(codec->deflate_ready)
+	{
+		/* a reset keeps the level, switching it before any input is free */
+		if(deflateReset(stream) != Z_OK || (codec->level != (int)level && deflateParams(stream, level, Z_DEFAULT_STRATEGY) != Z_OK))
+		{
+			deflateEnd(stream);
+			codec->deflate_ready = false;
+		}
+		else
+		{
+			codec->level = level;
+		}
+	}
+	if(!codec->deflate_ready)
+	{
+		memset(stream, 0, sizeof(z_stream));
+		if(deflateInit(stream, level) != Z_OK)
+		{
+			fprintf(stderr, "ERROR: pod_codec_deflate() failed to initialize compression for %s!\n", name);
+			return NULL;
+		}
+		codec->deflate_ready = true;
+		codec->level = level;
+	}
+
+	/* the bound fits incompressible data too, so one call finishes it */
+	uLong bound = deflateBound(stream, size);
+	pod_byte_t* compressed = malloc(bound > 0 ? bound : 1);
+	if(compressed == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_codec_deflate() could not allocate %lu bytes for %s!\n", bound, name);
+		return NULL;
+	}
+
+	stream->next_in = data;
+	stream->avail_in = size;
+	stream->next_out = compressed;
+	stream->avail_out = bound;
+
+	int ret;
+	do
+	{
+		ret = deflate(stream, Z_FINISH);
+	} while(ret == Z_OK);
+
+	if(ret != Z_STREAM_END)
+	{
+		fprintf(stderr, "ERROR: pod_codec_deflate() failed to compress data for %s!\n", name);
+		free(compressed);
+		return NULL;
+	}
+
+	if(result_size)
+		*result_size = stream->total_out;
+
+	return compressed;
+}
@@ -0,0 +1,50 @@
+#ifndef _POD_CODEC_H
+#define _POD_CODEC_H
+
+#define POD_CODEC_ONESHOT_SIZE               0x100000                 /* largest entry inflated one-shot */
+
+/* reusable zlib streams, opaque so only pod_codec.c sees zlib.h; each     */
+/* stream is initialised on first use and reset between entries instead of */
+/* being rebuilt, so small entries do not pay for zlib's setup every time  */
+/* a codec must only be used by one thread at a time                       */
+typedef struct pod_codec_s pod_codec_t;
+
+/* inflate backend, zlib is the default and always present, others are   */
+/* compiled in when found (POD_HAVE_LIBDEFLATE); one-shot backends decode */
+/* a whole entry into a buffer of its known uncompressed size             */
+typedef struct pod_codec_backend_s
+{
+	const pod_char_t* name;
+	pod_bool_t one_shot;
+	/* @returns true if data inflates to exactly buffer_size bytes */
+	pod_bool_t (*inflate)(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name);
+} pod_codec_backend_t;
+
+pod_number_t pod_codec_backend_count();
+const pod_codec_backend_t* pod_codec_backend_get(pod_number_t index);
+/* the backend every codec inflates with, select it before extracting */
+const pod_codec_backend_t* pod_codec_backend();
+/* @returns false and keeps the current backend if name is unknown */
+pod_bool_t pod_codec_backend_select(const pod_char_t* name);
+
+pod_codec_t* pod_codec_create();
+pod_codec_t* pod_codec_delete(pod_codec_t* codec);
+/* @returns the codec of the calling thread, created on first use and */
+/* deleted when the thread exits                                      */
+pod_codec_t* pod_codec_thread();
+
+/* inflate data into sink one POD_INFLATE_WINDOW_SIZE window at a time      */
+/* with zlib, or in one piece if a one-shot backend is selected and the     */
+/* entry is at most POD_CODEC_ONESHOT_SIZE bytes                            */
+/* @returns true if exactly uncompressed_size bytes were delivered, written */
+/* counts the bytes sink accepted so far either way                         */
+pod_bool_t pod_codec_inflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_number_t uncompressed_size, pod_string_t name, pod_sink_t sink, void* context, pod_size_t* written);
+/* inflate data into buffer with the selected or the given backend */
+/* @returns false unless it fills exactly buffer_size bytes         */
+pod_bool_t pod_codec_inflate_buffer(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name);
+pod_bool_t pod_codec_inflate_buffer_with(pod_codec_t* codec, const pod_codec_backend_t* backend, pod_byte_t* data, pod_number_t size, pod_byte_t* buffer, pod_number_t buffer_size, pod_string_t name);
+/* deflate data at level into a new buffer of *result_size bytes         */
+/* @returns NULL on failure                                               */
+pod_byte_t* pod_codec_deflate(pod_codec_t* codec, pod_byte_t* data, pod_number_t size, pod_number_t level, pod_string_t name, pod_number_t* result_size);
+
+#endif
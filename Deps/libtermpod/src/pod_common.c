@@ -1,7 +1,6 @@
 #include "pod_common.h"
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
-#include "zlib.h"
 
 #if defined(_WIN32)
 #include <io.h>
@@ -174,6 +173,15 @@ pod_string_t pod_ctime(pod_time_t* time32)
 	return  str;
 }
 
+pod_string_t pod_checksum_str(pod_char_t* buffer, const pod_char_t* format, pod_number_t checksum, pod_bool_t computed)
+{
+	if(computed)
+		snprintf(buffer, POD_CHECKSUM_STRING_SIZE, format, checksum, checksum);
+	else
+		snprintf(buffer, POD_CHECKSUM_STRING_SIZE, "not computed");
+	return buffer;
+}
+
 pod_dir_t pod_opendir_mkdir_p(const pod_string_t path, mode_t* mode)
 {
 	/* assert valid arguments */
@@ -598,87 +606,44 @@ bool dir_exists(const char* folder)
 
 pod_byte_t* pod_decompress(pod_byte_t* data, pod_number_t size, pod_number_t uncompressedSize, pod_string_t name, pod_number_t* resultSize)
 {
-	z_stream stream = { 0 };
-	stream.next_in = data;
-	stream.avail_in = size;
-
-	if (inflateInit(&stream) != Z_OK)
+	pod_byte_t* decompressed = malloc(uncompressedSize > 0 ? uncompressedSize : 1);
+	if (decompressed == NULL)
 	{
-		fprintf(stderr, "ERROR: pod_file_entry_decompress() failed to initialize decompression for %s!\n", name);
+		fprintf(stderr, "ERROR: pod_file_entry_decompress() could not allocate %u bytes for %s!\n", uncompressedSize, name);
 		return NULL;
 	}
 
-	char* decompressed = (char*)malloc(uncompressedSize);
-	uLong cursor = 0;
-
-	int ret;
-	char outbuffer[10240];
-
-	do {
-		stream.next_out = outbuffer;
-		stream.avail_out = sizeof(outbuffer);
-
-		ret = inflate(&stream, Z_NO_FLUSH);
-		if (cursor < stream.total_out) {
-			memcpy(decompressed + cursor, outbuffer, stream.total_out - cursor);
-			cursor = stream.total_out;
-		}
-	} while (ret == Z_OK);
-
-	inflateEnd(&stream);
-
-	if (ret != Z_STREAM_END) {
-		fprintf(stderr, "ERROR: pod_file_entry_decompress() failed to decompress data for %s!\n", name);
+	if (!pod_codec_inflate_buffer(pod_codec_thread(), data, size, decompressed, uncompressedSize, name))
+	{
+		free(decompressed);
 		return NULL;
 	}
 
 	if (resultSize)
-		*resultSize = stream.total_out;
+		*resultSize = uncompressedSize;
 
 	return decompressed;
 }
 
-pod_byte_t* pod_compress(pod_byte_t* data, pod_number_t compressionLevel, pod_number_t size, pod_string_t name, pod_number_t* resultSize)
+pod_bool_t pod_sink_file(void* context, const pod_byte_t* data, pod_size_t size)
 {
-	z_stream stream = { 0 };
-	stream.next_in = data;
-	stream.avail_in = size;
-
-	if (deflateInit(&stream, compressionLevel) != Z_OK)
+	if (size > 0 && fwrite(data, size, 1, (FILE*)context) != 1)
 	{
-		fprintf(stderr, "ERROR: pod_file_entry_compress() failed to initialize compression for %s!\n", name);
-		return data;
-	}
-
-	char* compressed = (char*)malloc(size);
-	uLong cursor = 0;
-
-	int ret;
-	char outbuffer[10240];
-
-	do {
-		stream.next_out = outbuffer;
-		stream.avail_out = sizeof(outbuffer);
-
-		ret = deflate(&stream, Z_FINISH);
-		memcpy(compressed + cursor, outbuffer, stream.total_out - cursor);
-		cursor = stream.total_out;
-	} while (ret == Z_OK);
-
-
-	deflateEnd(&stream);
-
-	if (ret != Z_STREAM_END) {
-		fprintf(stderr, "ERROR: pod_file_entry_compress() failed to compress data for %s!\n", name);
-		return data;
+		fprintf(stderr, "ERROR: pod_sink_file() fwrite of %zu bytes failed: %s\n", size, strerror(errno));
+		return false;
 	}
+	return true;
+}
 
-	//compressed = (char*)realloc(compressed, stream.total_out);
-
-	if (resultSize)
-		*resultSize = stream.total_out;
+pod_bool_t pod_inflate_stream(pod_byte_t* data, pod_number_t size, pod_number_t uncompressedSize, pod_string_t name, pod_sink_t sink, void* context, pod_size_t* written)
+{
+	return pod_codec_inflate(pod_codec_thread(), data, size, uncompressedSize, name, sink, context, written);
+}
 
-	return compressed;
+pod_byte_t* pod_compress(pod_byte_t* data, pod_number_t compressionLevel, pod_number_t size, pod_string_t name, pod_number_t* resultSize)
+{
+	pod_byte_t* compressed = pod_codec_deflate(pod_codec_thread(), data, size, compressionLevel, name, resultSize);
+	return compressed ? compressed : data;
 }
 
 #ifdef _WIN32
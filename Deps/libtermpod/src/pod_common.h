@@ -39,6 +39,7 @@ typedef SSIZE_T ssize_t;
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdbool.h>
@@ -113,8 +114,18 @@ typedef quad_t pod_file_block_t  __attribute__ ((__vector_size__(POD_FILE_BLOCK_
 #define POD_PATH_NULL                        '\0'
 #define POD_SYSTEM_PATH_SIZE                 1024                          /* default system path length     */
 #define POD_UMASK                            0755                          /* default UMASK privileges       */
+#define POD_INFLATE_WINDOW_SIZE              65536                         /* streamed inflate window size   */
+#define POD_READ_RUN_SIZE                    0x1000000                     /* batched reads fetched at once  */
+#define POD_READ_RUN_GAP                     0x10000                       /* gap still joined into one run  */
+#define POD_READAHEAD_SIZE                   0x800000                      /* archive read ahead of workers  */
+#define POD_SYNC_COMPARE_SIZE                0x10000                       /* existing output read at once   */
+#define POD_CHECKSUM_STRING_SIZE             32                            /* longest printed checksum       */
 extern char *rotorchar;
 pod_string_t pod_ctime(pod_time_t* time32);
+/* checksum printed with format, which may use it twice, into buffer of */
+/* POD_CHECKSUM_STRING_SIZE bytes, or "not computed" if the open or the */
+/* listing skipped reading the data it covers                           */
+pod_string_t pod_checksum_str(pod_char_t* buffer, const pod_char_t* format, pod_number_t checksum, pod_bool_t computed);
 
 enum pod_string_size_t
 {
@@ -139,6 +150,15 @@ typedef enum pod_ident_type_t pod_ident_type_t;
 #define POD_IDENT_SIZE                       POD_STRING_4             /* file magic ident length        */
 #define POD_IDENT_TYPE_SIZE                  (EPD + 1)                /* number of POD format types     */
 
+enum pod_open_mode_t
+{
+	POD_OPEN_READ,   /* read the whole archive into memory             */
+	POD_OPEN_MMAP,   /* map the archive, pages load on demand          */
+	POD_OPEN_LAZY,   /* read directory only, fetch entry data on use   */
+	POD_OPEN_MODE_SIZE,
+};
+typedef enum pod_open_mode_t pod_open_mode_t;
+
 
 
 /* pod_header_t element sizes */
@@ -404,12 +424,37 @@ typedef struct pod_dir_entry_s {
 	pod_number_t file_checksum;
 } pod_dir_entry_t;
 
+/* receives the data of an entry piece by piece in order, @returns false to stop */
+typedef pod_bool_t (*pod_sink_t)(void* context, const pod_byte_t* data, pod_size_t size);
+
 #include "pod_crc.h"
+#include "pod_pool.h"
+#include "pod_store.h"
+#include "pod_index.h"
+#include "pod_tree.h"
+#include "pod_layout.h"
+#include "pod_cache.h"
+#include "pod_match.h"
+#include "pod_dest.h"
+#include "pod_codec.h"
+#include "pod_uring.h"
+#include "pod_tar.h"
+#include "pod_scan.h"
+#include "pod_policy.h"
+#include "pod_pack.h"
+#include "pod_writer.h"
+#include "pod_builder.h"
 
 bool file_exists(const char* file);
 bool dir_exists(const char* folder);
 
 pod_byte_t* pod_decompress(pod_byte_t* data, pod_number_t size, pod_number_t uncompressedSize, pod_string_t name, pod_number_t* resultSize);
+/* pod_sink_t appending to the FILE* context */
+pod_bool_t pod_sink_file(void* context, const pod_byte_t* data, pod_size_t size);
+/* pod_codec_inflate() with the codec of the calling thread */
+pod_bool_t pod_inflate_stream(pod_byte_t* data, pod_number_t size, pod_number_t uncompressedSize, pod_string_t name, pod_sink_t sink, void* context, pod_size_t* written);
+/* pod_codec_deflate() with the codec of the calling thread, @returns data */
+/* itself if it could not be compressed                                   */
 pod_byte_t* pod_compress(pod_byte_t* data, pod_number_t compressionLevel, pod_number_t size, pod_string_t name, pod_number_t* resultSize);
 
 pod_string_t pod_path_dirname(pod_string_t path);
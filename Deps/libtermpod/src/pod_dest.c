@@ -0,0 +1,514 @@
+#include "pod_common.h"
+#ifdef _WIN32
+#include <io.h>
+#include <sys/utime.h>
+#endif
+
+#define POD_DEST_MIN_SLOTS 64
+
+pod_dest_t* pod_dest_open(pod_path_t dst)
+{
+	if(dst == NULL || dst[0] == '\0')
+		dst = ".";
+
+	pod_dest_t* dir = calloc(1, sizeof(pod_dest_t));
+	if(dir == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_dest_open() could not allocate directory!\n");
+		return NULL;
+	}
+#ifndef _WIN32
+	dir->fd = -1;
+#endif
+
+	dir->path = strdup(dst);
+	dir->lock = pod_mutex_create();
+	dir->capacity = POD_DEST_MIN_SLOTS;
+	dir->hashes = calloc(dir->capacity, sizeof(pod_number_t));
+	dir->names = calloc(dir->capacity, sizeof(pod_string_t));
+	if(dir->path == NULL || dir->lock == NULL || dir->hashes == NULL || dir->names == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_dest_open() could not allocate directory cache!\n");
+		return pod_dest_close(dir);
+	}
+
+	if(mkdir_p(dst, ACCESSPERMS) != 0)
+	{
+		fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", dst, strerror(errno));
+		return pod_dest_close(dir);
+	}
+
+#ifndef _WIN32
+	dir->fd = open(dst, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if(dir->fd < 0)
+	{
+		fprintf(stderr, "ERROR: open(%s) failed: %s\n", dst, strerror(errno));
+		return pod_dest_close(dir);
+	}
+#endif
+	return dir;
+}
+
+pod_dest_t* pod_dest_close(pod_dest_t* dir)
+{
+	if(dir == NULL)
+		return NULL;
+
+#ifndef _WIN32
+	if(dir->fd >= 0)
+		close(dir->fd);
+#endif
+	for(pod_size_t i = 0; dir->names && i < dir->capacity; i++)
+		free(dir->names[i]);
+	free(dir->names);
+	free(dir->hashes);
+	pod_mutex_delete(dir->lock);
+	free(dir->path);
+	free(dir);
+	return NULL;
+}
+
+pod_bool_t pod_dest_relative(const pod_char_t* name, pod_char_t* relative, pod_size_t size)
+{
+	pod_size_t len = 0;
+	const pod_char_t* p = name;
+
+	while(*p)
+	{
+		while(*p == '\\' || *p == '/')
+			p++;
+		if(*p == '\0')
+			break;
+
+		const pod_char_t* start = p;
+		while(*p && *p != '\\' && *p != '/')
+			p++;
+		pod_size_t component = p - start;
+
+		/* never leave the destination */
+		if((component == 1 && start[0] == '.') || (component == 2 && start[0] == '.' && start[1] == '.') ||
+		   (component >= 2 && start[1] == ':'))
+		{
+			fprintf(stderr, "ERROR: pod_dest_relative() refusing unsafe name %s!\n", name);
+			return false;
+		}
+
+		if(len + (len > 0) + component + 1 > size)
+		{
+			fprintf(stderr, "ERROR: pod_dest_relative() name %s too long!\n", name);
+			return false;
+		}
+		if(len > 0)
+			relative[len++] = '/';
+		memcpy(relative + len, start, component);
+		len += component;
+	}
+
+	if(len == 0)
+	{
+		fprintf(stderr, "ERROR: pod_dest_relative() empty name %s!\n", name);
+		return false;
+	}
+	relative[len] = '\0';
+	return true;
+}
+
+static pod_number_t pod_dest_hash(const pod_char_t* name)
+{
+	pod_number_t hash = 0x811c9dc5;
+	for(; *name; name++)
+		hash = (hash ^ (unsigned char)*name) * 0x01000193;
+	return hash ? hash : 1;
+}
+
+/* @returns the slot of name or the empty slot it belongs in, lock held */
+static pod_size_t pod_dest_slot(pod_dest_t* dir, const pod_char_t* name, pod_number_t hash)
+{
+	pod_size_t mask = dir->capacity - 1;
+	pod_size_t slot = hash & mask;
+	while(dir->hashes[slot] != 0 && (dir->hashes[slot] != hash || strcmp(dir->names[slot], name) != 0))
+		slot = (slot + 1) & mask;
+	return slot;
+}
+
+/* remember name as made, lock held; a full cache only costs extra mkdirs */
+static void pod_dest_remember(pod_dest_t* dir, const pod_char_t* name, pod_number_t hash)
+{
+	if((dir->count + 1) * 2 > dir->capacity)
+	{
+		pod_size_t capacity = dir->capacity * 2;
+		pod_number_t* hashes = calloc(capacity, sizeof(pod_number_t));
+		pod_string_t* names = calloc(capacity, sizeof(pod_string_t));
+		if(hashes == NULL || names == NULL)
+		{
+			free(hashes);
+			free(names);
+			return;
+		}
+
+		for(pod_size_t i = 0; i < dir->capacity; i++)
+		{
+			if(dir->hashes[i] == 0)
+				continue;
+			pod_size_t slot = dir->hashes[i] & (capacity - 1);
+			while(hashes[slot] != 0)
+				slot = (slot + 1) & (capacity - 1);
+			hashes[slot] = dir->hashes[i];
+			names[slot] = dir->names[i];
+		}
+
+		free(dir->hashes);
+		free(dir->names);
+		dir->hashes = hashes;
+		dir->names = names;
+		dir->capacity = capacity;
+	}
+
+	pod_size_t slot = pod_dest_slot(dir, name, hash);
+	if(dir->hashes[slot] != 0 || (dir->names[slot] = strdup(name)) == NULL)
+		return;
+	dir->hashes[slot] = hash;
+	dir->count++;
+}
+
+/* create one directory whose parent exists, lock held */
+static pod_bool_t pod_dest_mkdir(pod_dest_t* dir, const pod_char_t* relative)
+{
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	if(snprintf(path, sizeof(path), "%s/%s", dir->path, relative) >= (int)sizeof(path))
+	{
+		fprintf(stderr, "ERROR: pod_dest_mkdir() path %s/%s too long!\n", dir->path, relative);
+		return false;
+	}
+	if(mkdir_p(path, ACCESSPERMS) != 0)
+	{
+		fprintf(stderr, "ERROR: mkdir_p(%s) failed: %s\n", path, strerror(errno));
+		return false;
+	}
+#else
+	if(mkdirat(dir->fd, relative, ACCESSPERMS) != 0 && errno != EEXIST)
+	{
+		fprintf(stderr, "ERROR: mkdirat(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		return false;
+	}
+#endif
+	return true;
+}
+
+/* make relative, a '/' separated path, and its parents; relative is */
+/* modified while walking the parents and restored before returning */
+static pod_bool_t pod_dest_make_relative(pod_dest_t* dir, pod_char_t* relative)
+{
+	pod_bool_t ok = true;
+	pod_mutex_lock(dir->lock);
+
+	/* most files land in a directory that already exists */
+	pod_number_t hash = pod_dest_hash(relative);
+	if(dir->hashes[pod_dest_slot(dir, relative, hash)] != 0)
+	{
+		pod_mutex_unlock(dir->lock);
+		return true;
+	}
+
+	for(pod_char_t* p = relative; ok; p++)
+	{
+		if(*p != '/' && *p != '\0')
+			continue;
+
+		pod_char_t c = *p;
+		*p = '\0';
+		pod_number_t prefix = pod_dest_hash(relative);
+		if(dir->hashes[pod_dest_slot(dir, relative, prefix)] == 0)
+		{
+			ok = pod_dest_mkdir(dir, relative);
+			if(ok)
+				pod_dest_remember(dir, relative, prefix);
+		}
+		*p = c;
+
+		if(c == '\0')
+			break;
+	}
+
+	pod_mutex_unlock(dir->lock);
+	return ok;
+}
+
+pod_bool_t pod_dest_make(pod_dest_t* dir, const pod_char_t* name)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	if(dir == NULL || name == NULL || !pod_dest_relative(name, relative, sizeof(relative)))
+		return false;
+	return pod_dest_make_relative(dir, relative);
+}
+
+pod_bool_t pod_dest_prepare(pod_dest_t* dir, const pod_char_t* name, pod_char_t* relative, pod_size_t size)
+{
+	if(dir == NULL || name == NULL || !pod_dest_relative(name, relative, size))
+		return false;
+
+	pod_char_t* slash = strrchr(relative, '/');
+	if(slash != NULL)
+	{
+		*slash = '\0';
+		pod_bool_t ok = pod_dest_make_relative(dir, relative);
+		*slash = '/';
+		if(!ok)
+			return false;
+	}
+	return true;
+}
+
+FILE* pod_dest_fopen(pod_dest_t* dir, const pod_char_t* name)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	if(!pod_dest_prepare(dir, name, relative, sizeof(relative)))
+		return NULL;
+
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	if(snprintf(path, sizeof(path), "%s/%s", dir->path, relative) >= (int)sizeof(path))
+	{
+		fprintf(stderr, "ERROR: pod_dest_fopen() path %s/%s too long!\n", dir->path, relative);
+		return NULL;
+	}
+	FILE* file = fopen(path, "wb");
+	if(file == NULL)
+		fprintf(stderr, "ERROR: fopen(%s) failed: %s\n", path, strerror(errno));
+	return file;
+#else
+	int fd = openat(dir->fd, relative, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if(fd < 0)
+	{
+		fprintf(stderr, "ERROR: openat(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		return NULL;
+	}
+
+	FILE* file = fdopen(fd, "wb");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: fdopen(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		close(fd);
+	}
+	return file;
+#endif
+}
+
+#ifdef _WIN32
+/* full path of relative for the calls without an *at() variant here */
+static pod_bool_t pod_dest_path(pod_dest_t* dir, const pod_char_t* relative, pod_char_t* path, pod_size_t size)
+{
+	if(snprintf(path, size, "%s/%s", dir->path, relative) >= (int)size)
+	{
+		fprintf(stderr, "ERROR: pod_dest_path() path %s/%s too long!\n", dir->path, relative);
+		return false;
+	}
+	return true;
+}
+#endif
+
+pod_bool_t pod_dest_stat(pod_dest_t* dir, const pod_char_t* name, pod_size_t* size, pod_time_t* mtime)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	if(dir == NULL || name == NULL || !pod_dest_relative(name, relative, sizeof(relative)))
+		return false;
+
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	struct _stat64 st;
+	if(!pod_dest_path(dir, relative, path, sizeof(path)) || _stat64(path, &st) != 0 || (st.st_mode & _S_IFREG) == 0)
+		return false;
+#else
+	struct stat st;
+	if(fstatat(dir->fd, relative, &st, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISREG(st.st_mode))
+		return false;
+#endif
+	*size = st.st_size;
+	*mtime = st.st_mtime;
+	return true;
+}
+
+FILE* pod_dest_fopen_read(pod_dest_t* dir, const pod_char_t* name)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	if(dir == NULL || name == NULL || !pod_dest_relative(name, relative, sizeof(relative)))
+		return NULL;
+
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	if(!pod_dest_path(dir, relative, path, sizeof(path)))
+		return NULL;
+	FILE* file = fopen(path, "rb");
+	if(file == NULL)
+		fprintf(stderr, "ERROR: fopen(%s) failed: %s\n", path, strerror(errno));
+	return file;
+#else
+	int fd = openat(dir->fd, relative, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+	if(fd < 0)
+	{
+		fprintf(stderr, "ERROR: openat(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		return NULL;
+	}
+
+	FILE* file = fdopen(fd, "rb");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: fdopen(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		close(fd);
+	}
+	return file;
+#endif
+}
+
+pod_bool_t pod_dest_touch(pod_dest_t* dir, const pod_char_t* name, pod_time_t mtime)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE];
+	if(dir == NULL || name == NULL || !pod_dest_relative(name, relative, sizeof(relative)))
+		return false;
+
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	struct _utimbuf times = { mtime, mtime };
+	if(!pod_dest_path(dir, relative, path, sizeof(path)))
+		return false;
+	if(_utime(path, &times) != 0)
+	{
+		fprintf(stderr, "ERROR: _utime(%s) failed: %s\n", path, strerror(errno));
+		return false;
+	}
+#else
+	struct timespec times[2] = { { mtime, 0 }, { mtime, 0 } };
+	if(utimensat(dir->fd, relative, times, AT_SYMLINK_NOFOLLOW) != 0)
+	{
+		fprintf(stderr, "ERROR: utimensat(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		return false;
+	}
+#endif
+	return true;
+}
+
+static int pod_dest_compare(const void* a, const void* b)
+{
+	return strcmp(*(const pod_char_t* const*)a, *(const pod_char_t* const*)b);
+}
+
+static pod_bool_t pod_dest_kept(const pod_char_t* relative, const pod_char_t** keep, pod_size_t count)
+{
+	return bsearch(&relative, keep, count, sizeof(pod_char_t*), pod_dest_compare) != NULL;
+}
+
+static pod_bool_t pod_dest_remove(pod_dest_t* dir, const pod_char_t* relative, pod_bool_t directory)
+{
+#ifdef _WIN32
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	if(!pod_dest_path(dir, relative, path, sizeof(path)))
+		return false;
+	if((directory ? _rmdir(path) : remove(path)) != 0)
+#else
+	if(unlinkat(dir->fd, relative, directory ? AT_REMOVEDIR : 0) != 0)
+#endif
+	{
+		/* directories still holding kept files stay */
+		if(directory && (errno == ENOTEMPTY || errno == EEXIST))
+			return false;
+		fprintf(stderr, "ERROR: pod_dest_remove(%s/%s) failed: %s\n", dir->path, relative, strerror(errno));
+		return false;
+	}
+	fprintf(stderr, "%s/%s removed\n", dir->path, relative);
+	return true;
+}
+
+/* prune the directory relative, which holds len bytes and is restored */
+/* before returning; *removed counts the files and directories removed */
+static pod_bool_t pod_dest_prune_relative(pod_dest_t* dir, pod_char_t* relative, pod_size_t len, const pod_char_t** keep, pod_size_t count, pod_ssize_t* removed)
+{
+	pod_bool_t ok = true;
+	pod_size_t sep = len > 0;
+
+#ifdef _WIN32
+	pod_char_t pattern[POD_SYSTEM_PATH_SIZE];
+	struct _finddata_t found;
+	if(snprintf(pattern, sizeof(pattern), "%s/%s%s*", dir->path, relative, sep ? "/" : "") >= (int)sizeof(pattern))
+	{
+		fprintf(stderr, "ERROR: pod_dest_prune() path %s/%s too long!\n", dir->path, relative);
+		return false;
+	}
+	intptr_t handle = _findfirst(pattern, &found);
+	if(handle == -1)
+		return true;
+	do
+	{
+		const pod_char_t* child = found.name;
+		pod_bool_t directory = (found.attrib & _A_SUBDIR) != 0;
+		pod_bool_t regular = !directory;
+#else
+	int fd = len > 0 ? openat(dir->fd, relative, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC) : dup(dir->fd);
+	DIR* listing = fd >= 0 ? fdopendir(fd) : NULL;
+	if(listing == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_dest_prune() could not list %s/%s: %s\n", dir->path, relative, strerror(errno));
+		if(fd >= 0)
+			close(fd);
+		return false;
+	}
+	/* a listing opened on dup() shares its offset with dir->fd */
+	rewinddir(listing);
+	for(struct dirent* found = readdir(listing); found != NULL; found = readdir(listing))
+	{
+		const pod_char_t* child = found->d_name;
+		struct stat st;
+		if(fstatat(dirfd(listing), child, &st, AT_SYMLINK_NOFOLLOW) != 0)
+			continue;
+		pod_bool_t directory = S_ISDIR(st.st_mode);
+		pod_bool_t regular = S_ISREG(st.st_mode);
+#endif
+		if(strcmp(child, ".") == 0 || strcmp(child, "..") == 0 || (!directory && !regular))
+			continue;
+
+		pod_size_t child_size = strlen(child);
+		if(len + sep + child_size >= POD_SYSTEM_PATH_SIZE)
+		{
+			fprintf(stderr, "ERROR: pod_dest_prune() path of %s/%s too long!\n", relative, child);
+			ok = false;
+			continue;
+		}
+		relative[len] = '/';
+		memcpy(relative + len + sep, child, child_size + 1);
+
+		if(directory)
+		{
+			ok = pod_dest_prune_relative(dir, relative, len + sep + child_size, keep, count, removed) && ok;
+			if(pod_dest_remove(dir, relative, true))
+				(*removed)++;
+		}
+		else if(!pod_dest_kept(relative, keep, count))
+		{
+			if(pod_dest_remove(dir, relative, false))
+				(*removed)++;
+			else
+				ok = false;
+		}
+		relative[len] = '\0';
+#ifdef _WIN32
+	} while(_findnext(handle, &found) == 0);
+	_findclose(handle);
+#else
+	}
+	closedir(listing);
+#endif
+	return ok;
+}
+
+pod_ssize_t pod_dest_prune(pod_dest_t* dir, const pod_char_t* subdir, const pod_char_t** keep, pod_size_t count)
+{
+	pod_char_t relative[POD_SYSTEM_PATH_SIZE] = "";
+	if(dir == NULL || subdir == NULL || (subdir[0] != '\0' && !pod_dest_relative(subdir, relative, sizeof(relative))))
+		return -1;
+
+	qsort(keep, count, sizeof(pod_char_t*), pod_dest_compare);
+	pod_ssize_t removed = 0;
+	if(!pod_dest_prune_relative(dir, relative, strlen(relative), keep, count, &removed))
+		return -1;
+	return removed;
+}
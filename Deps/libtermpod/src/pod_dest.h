@@ -0,0 +1,48 @@
+#ifndef _POD_DEST_H
+#define _POD_DEST_H
+
+/* extraction destination, entries are created relative to it without     */
+/* changing the working directory; on POSIX through a directory fd with    */
+/* openat/mkdirat, elsewhere by prefixing the destination path. Every      */
+/* directory made below it is remembered so it costs one mkdir per run.    */
+/* all calls may come from several threads at once                         */
+typedef struct pod_dest_s
+{
+	pod_string_t path;
+#ifndef _WIN32
+	int fd;
+#endif
+	pod_mutex_t* lock;
+	pod_number_t* hashes;   /* made directories, 0 marks an empty slot */
+	pod_string_t* names;
+	pod_size_t capacity;    /* power of two */
+	pod_size_t count;
+} pod_dest_t;
+
+/* open dst, creating it with parents, NULL or "" is the working directory */
+pod_dest_t* pod_dest_open(pod_path_t dst);
+pod_dest_t* pod_dest_close(pod_dest_t* dir);
+/* convert an entry name to a path relative to dir using '/' only         */
+/* @returns false for names that are empty, absolute or contain ".."      */
+pod_bool_t pod_dest_relative(const pod_char_t* name, pod_char_t* relative, pod_size_t size);
+/* create directory name below dir with all parents, each at most once */
+pod_bool_t pod_dest_make(pod_dest_t* dir, const pod_char_t* name);
+/* create the parents of entry name below dir and store its path relative */
+/* to dir in relative, for callers opening it themselves                  */
+pod_bool_t pod_dest_prepare(pod_dest_t* dir, const pod_char_t* name, pod_char_t* relative, pod_size_t size);
+/* create the parents of entry name below dir and open it for writing */
+FILE* pod_dest_fopen(pod_dest_t* dir, const pod_char_t* name);
+/* @returns true if entry name is a regular file below dir, with its size */
+/* and modification time                                                  */
+pod_bool_t pod_dest_stat(pod_dest_t* dir, const pod_char_t* name, pod_size_t* size, pod_time_t* mtime);
+/* open the existing entry name below dir for reading */
+FILE* pod_dest_fopen_read(pod_dest_t* dir, const pod_char_t* name);
+/* set the modification time of entry name below dir */
+pod_bool_t pod_dest_touch(pod_dest_t* dir, const pod_char_t* name, pod_time_t mtime);
+/* remove every file below subdir of dir whose '/' separated path relative */
+/* to dir is not in keep, and the directories that leaves empty; keep is   */
+/* sorted in place                                                          */
+/* @returns the number of files and directories removed, -1 on errors      */
+pod_ssize_t pod_dest_prune(pod_dest_t* dir, const pod_char_t* subdir, const pod_char_t** keep, pod_size_t count);
+
+#endif
@@ -0,0 +1,134 @@
+#include "pod_common.h"
+
+#define POD_INDEX_FNV_OFFSET 0x811c9dc5
+#define POD_INDEX_FNV_PRIME  0x01000193
+#define POD_INDEX_MIN_SLOTS  16
+
+pod_number_t pod_index_hash(const pod_char_t* name)
+{
+	pod_number_t hash = POD_INDEX_FNV_OFFSET;
+	for(; *name; name++)
+	{
+		hash ^= (unsigned char)pod_index_fold(*name);
+		hash *= POD_INDEX_FNV_PRIME;
+	}
+	return hash;
+}
+
+/* compare a stored normalised name against a raw lookup name */
+static pod_bool_t pod_index_equal(const pod_char_t* normalised, const pod_char_t* name)
+{
+	for(; *normalised && *name; normalised++, name++)
+	{
+		if(*normalised != pod_index_fold(*name))
+			return false;
+	}
+	return *normalised == *name;
+}
+
+pod_index_t* pod_index_create(pod_number_t entries)
+{
+	pod_index_t* index = calloc(1, sizeof(pod_index_t));
+	if(index == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_index_create() could not allocate index!\n");
+		return NULL;
+	}
+
+	/* keep the load factor at or below one half */
+	index->capacity = POD_INDEX_MIN_SLOTS;
+	while(index->capacity < (pod_size_t)entries * 2)
+		index->capacity <<= 1;
+
+	index->entries = entries;
+	index->slots = calloc(index->capacity, sizeof(pod_index_slot_t));
+	index->name_offsets = calloc(entries > 0 ? entries : 1, sizeof(pod_number_t));
+	if(index->slots == NULL || index->name_offsets == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_index_create() could not allocate %zu slots!\n", index->capacity);
+		return pod_index_delete(index);
+	}
+
+	return index;
+}
+
+pod_index_t* pod_index_delete(pod_index_t* index)
+{
+	if(index == NULL)
+		return NULL;
+
+	free(index->slots);
+	free(index->names);
+	free(index->name_offsets);
+	free(index);
+	return NULL;
+}
+
+pod_bool_t pod_index_insert(pod_index_t* index, const pod_char_t* name, pod_number_t entry_index)
+{
+	if(index == NULL || name == NULL || entry_index >= index->entries)
+	{
+		fprintf(stderr, "ERROR: pod_index_insert() invalid arguments!\n");
+		return false;
+	}
+
+	pod_number_t hash = pod_index_hash(name);
+	pod_size_t mask = index->capacity - 1;
+	pod_size_t slot = hash & mask;
+
+	while(index->slots[slot].entry != 0)
+	{
+		pod_index_slot_t* s = &index->slots[slot];
+		if(s->hash == hash && pod_index_equal(index->names + index->name_offsets[s->entry - 1], name))
+			return true;
+		slot = (slot + 1) & mask;
+	}
+
+	/* append the normalised name to the name pool */
+	pod_size_t len = strlen(name) + 1;
+	if(index->names_used + len > index->names_size)
+	{
+		pod_size_t size = index->names_size ? index->names_size : POD_INDEX_MIN_SLOTS * POD_STRING_32;
+		while(size < index->names_used + len)
+			size <<= 1;
+
+		pod_char_t* names = realloc(index->names, size);
+		if(names == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_index_insert() could not grow name pool to %zu bytes!\n", size);
+			return false;
+		}
+		index->names = names;
+		index->names_size = size;
+	}
+
+	pod_char_t* dst = index->names + index->names_used;
+	for(pod_size_t i = 0; i < len; i++)
+		dst[i] = pod_index_fold(name[i]);
+
+	index->name_offsets[entry_index] = index->names_used;
+	index->names_used += len;
+
+	index->slots[slot].hash = hash;
+	index->slots[slot].entry = entry_index + 1;
+	index->count++;
+	return true;
+}
+
+pod_ssize_t pod_index_find(pod_index_t* index, const pod_char_t* name)
+{
+	if(index == NULL || name == NULL)
+		return -1;
+
+	pod_number_t hash = pod_index_hash(name);
+	pod_size_t mask = index->capacity - 1;
+
+	for(pod_size_t slot = hash & mask; index->slots[slot].entry != 0; slot = (slot + 1) & mask)
+	{
+		pod_index_slot_t* s = &index->slots[slot];
+		if(s->hash == hash && pod_index_equal(index->names + index->name_offsets[s->entry - 1], name))
+			return s->entry - 1;
+	}
+
+	return -1;
+}
@@ -0,0 +1,39 @@
+#ifndef _POD_INDEX_H
+#define _POD_INDEX_H
+
+/* open addressing hash table from entry name to entry index                 */
+/* names are normalised to lower case with '\' and '/' treated as equal so   */
+/* "Data\Tex\A.RAW" and "data/tex/a.raw" resolve to the same entry           */
+typedef struct pod_index_slot_s
+{
+	pod_number_t hash;
+	pod_number_t entry; /* entry index + 1, 0 marks an empty slot */
+} pod_index_slot_t;
+
+typedef struct pod_index_s
+{
+	pod_index_slot_t* slots;
+	pod_size_t capacity; /* power of two */
+	pod_number_t count;
+	pod_char_t* names; /* normalised names back to back */
+	pod_size_t names_size;
+	pod_size_t names_used;
+	pod_number_t* name_offsets; /* per entry index into names */
+	pod_number_t entries;
+} pod_index_t;
+
+/* @returns c the way names are normalised for lookups */
+static inline pod_char_t pod_index_fold(pod_char_t c)
+{
+	return c == '\\' ? '/' : (pod_char_t)tolower((unsigned char)c);
+}
+
+pod_number_t pod_index_hash(const pod_char_t* name);
+pod_index_t* pod_index_create(pod_number_t entries);
+pod_index_t* pod_index_delete(pod_index_t* index);
+/* add name for entry_index, the first entry of duplicate names wins */
+pod_bool_t pod_index_insert(pod_index_t* index, const pod_char_t* name, pod_number_t entry_index);
+/* @returns the entry index of name or -1 if there is none */
+pod_ssize_t pod_index_find(pod_index_t* index, const pod_char_t* name);
+
+#endif
@@ -0,0 +1,134 @@
+#include "pod_common.h"
+
+typedef struct pod_layout_span_s
+{
+	pod_number_t offset;
+	pod_number_t size;
+	pod_number_t entry;
+} pod_layout_span_t;
+
+static inline pod_number_t pod_layout_field(const void* entries, pod_size_t stride, pod_number_t i, pod_size_t at)
+{
+	pod_number_t value;
+	memcpy(&value, (const pod_byte_t*)entries + i * stride + at, sizeof(value));
+	return value;
+}
+
+static int pod_layout_span_compare(const void* a, const void* b)
+{
+	const pod_layout_span_t* x = a;
+	const pod_layout_span_t* y = b;
+	if(x->offset != y->offset)
+		return x->offset < y->offset ? -1 : 1;
+	return x->entry < y->entry ? -1 : x->entry > y->entry;
+}
+
+/* @returns spans of all entries sorted by offset, owned by caller */
+static pod_layout_span_t* pod_layout_spans(const void* entries, pod_number_t count, pod_size_t stride, pod_size_t offset_at, pod_size_t size_at)
+{
+	pod_layout_span_t* spans = malloc((count > 0 ? count : 1) * sizeof(pod_layout_span_t));
+	if(spans == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_layout_spans() could not allocate %u spans!\n", count);
+		return NULL;
+	}
+
+	for(pod_number_t i = 0; i < count; i++)
+	{
+		spans[i].offset = pod_layout_field(entries, stride, i, offset_at);
+		spans[i].size = pod_layout_field(entries, stride, i, size_at);
+		spans[i].entry = i;
+	}
+
+	qsort(spans, count, sizeof(pod_layout_span_t), pod_layout_span_compare);
+	return spans;
+}
+
+pod_number_t* pod_layout_order(const void* entries, pod_number_t count, pod_size_t stride, pod_size_t offset_at, pod_size_t size_at)
+{
+	pod_layout_span_t* spans = pod_layout_spans(entries, count, stride, offset_at, size_at);
+	if(spans == NULL)
+		return NULL;
+
+	pod_number_t* order = malloc((count > 0 ? count : 1) * sizeof(pod_number_t));
+	if(order == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_layout_order() could not allocate %u indices!\n", count);
+		free(spans);
+		return NULL;
+	}
+
+	for(pod_number_t i = 0; i < count; i++)
+		order[i] = spans[i].entry;
+
+	free(spans);
+	return order;
+}
+
+pod_layout_t* pod_layout_create(const void* entries, pod_number_t count, pod_size_t stride, pod_size_t offset_at, pod_size_t size_at, pod_size_t start, pod_size_t end)
+{
+	pod_layout_t* layout = calloc(1, sizeof(pod_layout_t));
+	if(layout == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_layout_create() could not allocate layout!\n");
+		return NULL;
+	}
+
+	layout->count = count;
+	layout->order = malloc((count > 0 ? count : 1) * sizeof(pod_number_t));
+	layout->gap_sizes = calloc(count > 0 ? count : 1, sizeof(pod_number_t));
+	pod_layout_span_t* spans = pod_layout_spans(entries, count, stride, offset_at, size_at);
+	if(layout->order == NULL || layout->gap_sizes == NULL || spans == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_layout_create() could not allocate %u entries!\n", count);
+		free(spans);
+		return pod_layout_delete(layout);
+	}
+
+	layout->data_start = count > 0 ? spans[0].offset : start;
+	layout->valid = layout->data_start >= start;
+
+	/* one pass in offset order, end tracks the furthest byte covered so far */
+	pod_size_t covered = start;
+	for(pod_number_t i = 0; i < count; i++)
+	{
+		pod_size_t offset = spans[i].offset;
+		pod_size_t stop = offset + spans[i].size;
+
+		layout->order[i] = spans[i].entry;
+		layout->entry_data_size += spans[i].size;
+
+		if(offset >= covered)
+		{
+			pod_number_t gap = offset - covered;
+			if(i > 0)
+				layout->gap_sizes[i] = gap;
+			layout->gap_sizes[0] += gap;
+		}
+		else
+			layout->shared_size += (stop < covered ? stop : covered) - offset;
+
+		if(stop > covered)
+			covered = stop;
+	}
+
+	layout->data_end = covered;
+	if(covered > end)
+		layout->valid = false;
+	else
+		layout->gap_sizes[0] += end - covered;
+
+	free(spans);
+	return layout;
+}
+
+pod_layout_t* pod_layout_delete(pod_layout_t* layout)
+{
+	if(layout == NULL)
+		return NULL;
+
+	free(layout->order);
+	free(layout->gap_sizes);
+	free(layout);
+	return NULL;
+}
@@ -0,0 +1,30 @@
+#ifndef _POD_LAYOUT_H
+#define _POD_LAYOUT_H
+
+/* entry data of an archive sorted by offset                                 */
+/* gap_sizes[i] is the unused space in front of the i-th entry by offset,    */
+/* gap_sizes[0] holds the total including the space before the first and     */
+/* behind the last entry; bytes shared by overlapping entries are counted    */
+/* once in shared_size so entry_data_size - shared_size + gap_sizes[0]       */
+/* always covers the data region                                             */
+typedef struct pod_layout_s
+{
+	pod_number_t* order;        /* entry indices by ascending offset */
+	pod_number_t* gap_sizes;    /* count entries, at least one */
+	pod_number_t count;
+	pod_size_t entry_data_size; /* sum of all entry sizes */
+	pod_size_t shared_size;
+	pod_number_t data_start;    /* offset of the first entry, start if empty */
+	pod_number_t data_end;      /* end of the last entry, start if empty */
+	pod_bool_t valid;           /* all entries lie within start and end */
+} pod_layout_t;
+
+/* @returns entry indices of count entries sorted by offset, owned by caller */
+/* entries are stride bytes apart with offset and size fields at offset_at   */
+/* and size_at; equal offsets keep directory order                          */
+pod_number_t* pod_layout_order(const void* entries, pod_number_t count, pod_size_t stride, pod_size_t offset_at, pod_size_t size_at);
+/* analyse entries whose data is expected between start and end */
+pod_layout_t* pod_layout_create(const void* entries, pod_number_t count, pod_size_t stride, pod_size_t offset_at, pod_size_t size_at, pod_size_t start, pod_size_t end);
+pod_layout_t* pod_layout_delete(pod_layout_t* layout);
+
+#endif
@@ -0,0 +1,955 @@
+#include "pod_common.h"
+
+#define POD_MATCH_NFA_SET    0
+#define POD_MATCH_NFA_SPLIT  1
+#define POD_MATCH_NFA_EMPTY  2
+#define POD_MATCH_NFA_ACCEPT 3
+
+#define POD_MATCH_DFA_SLOTS  (POD_MATCH_DFA_MAX_STATES * 2)
+
+typedef struct pod_match_frag_s
+{
+	pod_number_t start;
+	pod_number_t end; /* empty state whose out is still open */
+} pod_match_frag_t;
+
+typedef struct pod_match_parser_s
+{
+	pod_match_t* match;
+	const pod_char_t* expr;
+	const pod_char_t* p;
+	const pod_char_t* error;
+} pod_match_parser_t;
+
+static inline void pod_match_set_bit(pod_byte_t* set, pod_byte_t c)
+{
+	set[c >> 3] |= (pod_byte_t)(1 << (c & 7));
+}
+
+static inline pod_bool_t pod_match_has_bit(const pod_byte_t* set, pod_byte_t c)
+{
+	return (set[c >> 3] >> (c & 7)) & 1;
+}
+
+pod_match_t* pod_match_create()
+{
+	pod_match_t* match = calloc(1, sizeof(pod_match_t));
+	if(match == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_create() could not allocate matcher!\n");
+		return NULL;
+	}
+	return match;
+}
+
+static void pod_match_dfa_clear(pod_match_t* match)
+{
+	for(pod_number_t i = 0; i < match->dfa_count; i++)
+		free(match->dfa[i].nfa);
+	match->dfa_count = 0;
+	if(match->dfa_slots)
+		memset(match->dfa_slots, 0, POD_MATCH_DFA_SLOTS * sizeof(pod_number_t));
+}
+
+pod_match_t* pod_match_delete(pod_match_t* match)
+{
+	if(match == NULL)
+		return NULL;
+
+	for(pod_number_t i = 0; i < match->literal_count; i++)
+		free(match->literals[i]);
+	free(match->literals);
+	free(match->literal_flags);
+	free(match->ac_next);
+	free(match->ac_flags);
+	free(match->nfa);
+	free(match->sets);
+	free(match->starts);
+	pod_match_dfa_clear(match);
+	free(match->dfa);
+	free(match->dfa_slots);
+	free(match->marks);
+	free(match->stack);
+	free(match->closure);
+	free(match);
+	return NULL;
+}
+
+/* @returns index of a new nfa state or POD_MATCH_NONE if out of memory */
+static pod_number_t pod_match_nfa_add(pod_match_t* match, pod_byte_t type, pod_number_t out, pod_number_t out1, pod_number_t set)
+{
+	if(match->nfa_count == match->nfa_capacity)
+	{
+		pod_number_t capacity = match->nfa_capacity ? match->nfa_capacity * 2 : 64;
+		pod_match_nfa_state_t* nfa = realloc(match->nfa, capacity * sizeof(pod_match_nfa_state_t));
+		if(nfa == NULL)
+			return POD_MATCH_NONE;
+		match->nfa = nfa;
+		match->nfa_capacity = capacity;
+	}
+
+	pod_match_nfa_state_t* state = &match->nfa[match->nfa_count];
+	state->type = type;
+	state->out = out;
+	state->out1 = out1;
+	state->set = set;
+	return match->nfa_count++;
+}
+
+/* @returns index of a new empty character set or POD_MATCH_NONE */
+static pod_number_t pod_match_set_add(pod_match_t* match)
+{
+	if(match->set_count == match->set_capacity)
+	{
+		pod_number_t capacity = match->set_capacity ? match->set_capacity * 2 : 64;
+		pod_byte_t (*sets)[32] = realloc(match->sets, capacity * sizeof(*sets));
+		if(sets == NULL)
+			return POD_MATCH_NONE;
+		match->sets = sets;
+		match->set_capacity = capacity;
+	}
+
+	memset(match->sets[match->set_count], 0, sizeof(match->sets[0]));
+	return match->set_count++;
+}
+
+/* --- regular expression to NFA ------------------------------------------ */
+
+static pod_bool_t pod_match_parse_fail(pod_match_parser_t* parser, const pod_char_t* error)
+{
+	if(parser->error == NULL)
+		parser->error = error;
+	return false;
+}
+
+/* set -> empty fragment consuming one character of set */
+static pod_bool_t pod_match_frag_set(pod_match_parser_t* parser, pod_number_t set, pod_match_frag_t* frag)
+{
+	pod_number_t end = pod_match_nfa_add(parser->match, POD_MATCH_NFA_EMPTY, POD_MATCH_NONE, POD_MATCH_NONE, 0);
+	pod_number_t start = pod_match_nfa_add(parser->match, POD_MATCH_NFA_SET, end, POD_MATCH_NONE, set);
+	if(end == POD_MATCH_NONE || start == POD_MATCH_NONE)
+		return pod_match_parse_fail(parser, "out of memory");
+	frag->start = start;
+	frag->end = end;
+	return true;
+}
+
+static pod_bool_t pod_match_frag_empty(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	pod_number_t state = pod_match_nfa_add(parser->match, POD_MATCH_NFA_EMPTY, POD_MATCH_NONE, POD_MATCH_NONE, 0);
+	if(state == POD_MATCH_NONE)
+		return pod_match_parse_fail(parser, "out of memory");
+	frag->start = state;
+	frag->end = state;
+	return true;
+}
+
+/* frag -> frag* */
+static pod_bool_t pod_match_frag_star(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	pod_number_t end = pod_match_nfa_add(parser->match, POD_MATCH_NFA_EMPTY, POD_MATCH_NONE, POD_MATCH_NONE, 0);
+	pod_number_t split = pod_match_nfa_add(parser->match, POD_MATCH_NFA_SPLIT, frag->start, end, 0);
+	if(end == POD_MATCH_NONE || split == POD_MATCH_NONE)
+		return pod_match_parse_fail(parser, "out of memory");
+	parser->match->nfa[frag->end].out = split;
+	frag->start = split;
+	frag->end = end;
+	return true;
+}
+
+/* @returns character set of an escape sequence such as \d, \. or \\ */
+static pod_bool_t pod_match_escape(pod_match_parser_t* parser, pod_byte_t* set)
+{
+	pod_byte_t c = (pod_byte_t)*parser->p;
+	if(c == '\0')
+		return pod_match_parse_fail(parser, "trailing backslash");
+	parser->p++;
+
+	switch(c)
+	{
+		case 'd':
+			for(pod_byte_t i = '0'; i <= '9'; i++)
+				pod_match_set_bit(set, i);
+			break;
+		case 'w':
+			for(pod_number_t i = 0; i < 256; i++)
+				if(isalnum((int)i) || i == '_')
+					pod_match_set_bit(set, (pod_byte_t)i);
+			break;
+		case 's':
+			pod_match_set_bit(set, ' ');
+			pod_match_set_bit(set, '\t');
+			break;
+		default:
+			pod_match_set_bit(set, c);
+			break;
+	}
+	return true;
+}
+
+/* parse the inside of [...] into set, the opening bracket is consumed */
+static pod_bool_t pod_match_parse_class(pod_match_parser_t* parser, pod_byte_t* set)
+{
+	pod_bool_t negate = false;
+	if(*parser->p == '^')
+	{
+		negate = true;
+		parser->p++;
+	}
+
+	pod_byte_t chars[32] = { 0 };
+	pod_bool_t first = true;
+	while(*parser->p != ']' || first)
+	{
+		if(*parser->p == '\0')
+			return pod_match_parse_fail(parser, "missing ]");
+		first = false;
+
+		if(*parser->p == '\\')
+		{
+			parser->p++;
+			if(!pod_match_escape(parser, chars))
+				return false;
+			continue;
+		}
+
+		pod_byte_t low = (pod_byte_t)*parser->p++;
+		pod_byte_t high = low;
+		if(parser->p[0] == '-' && parser->p[1] != ']' && parser->p[1] != '\0')
+		{
+			high = (pod_byte_t)parser->p[1];
+			parser->p += 2;
+			if(high < low)
+				return pod_match_parse_fail(parser, "invalid range");
+		}
+		for(pod_number_t c = low; c <= high; c++)
+			pod_match_set_bit(chars, (pod_byte_t)c);
+	}
+	parser->p++;
+
+	/* names are folded before matching, so fold the class the same way */
+	for(pod_number_t c = 0; c < 256; c++)
+	{
+		if(pod_match_has_bit(chars, (pod_byte_t)c))
+			pod_match_set_bit(chars, (pod_byte_t)pod_index_fold((pod_char_t)c));
+	}
+
+	for(pod_number_t i = 0; i < sizeof(chars); i++)
+		set[i] = negate ? (pod_byte_t)~chars[i] : chars[i];
+	return true;
+}
+
+static pod_bool_t pod_match_parse_alt(pod_match_parser_t* parser, pod_match_frag_t* frag);
+
+static pod_bool_t pod_match_parse_atom(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	pod_byte_t c = (pod_byte_t)*parser->p;
+
+	switch(c)
+	{
+		case '(':
+			parser->p++;
+			if(!pod_match_parse_alt(parser, frag))
+				return false;
+			if(*parser->p != ')')
+				return pod_match_parse_fail(parser, "missing )");
+			parser->p++;
+			return true;
+		case '*':
+		case '+':
+		case '?':
+			return pod_match_parse_fail(parser, "nothing to repeat");
+		case '^':
+		case '$':
+			return pod_match_parse_fail(parser, "anchors are only supported at either end");
+		default:
+			break;
+	}
+
+	pod_number_t set = pod_match_set_add(parser->match);
+	if(set == POD_MATCH_NONE)
+		return pod_match_parse_fail(parser, "out of memory");
+	pod_byte_t* bits = parser->match->sets[set];
+
+	parser->p++;
+	if(c == '.')
+	{
+		memset(bits, 0xFF, sizeof(parser->match->sets[0]));
+	}
+	else if(c == '[')
+	{
+		if(!pod_match_parse_class(parser, bits))
+			return false;
+	}
+	else if(c == '\\')
+	{
+		pod_byte_t chars[32] = { 0 };
+		if(!pod_match_escape(parser, chars))
+			return false;
+		for(pod_number_t i = 0; i < 256; i++)
+		{
+			if(pod_match_has_bit(chars, (pod_byte_t)i))
+				pod_match_set_bit(bits, (pod_byte_t)pod_index_fold((pod_char_t)i));
+		}
+	}
+	else
+	{
+		pod_match_set_bit(bits, (pod_byte_t)pod_index_fold((pod_char_t)c));
+	}
+
+	return pod_match_frag_set(parser, set, frag);
+}
+
+static pod_bool_t pod_match_parse_repeat(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	if(!pod_match_parse_atom(parser, frag))
+		return false;
+
+	for(;;)
+	{
+		pod_char_t op = *parser->p;
+		if(op != '*' && op != '+' && op != '?')
+			return true;
+		parser->p++;
+
+		pod_number_t start = frag->start;
+		if(op == '*')
+		{
+			if(!pod_match_frag_star(parser, frag))
+				return false;
+			continue;
+		}
+
+		pod_number_t end = pod_match_nfa_add(parser->match, POD_MATCH_NFA_EMPTY, POD_MATCH_NONE, POD_MATCH_NONE, 0);
+		pod_number_t split = pod_match_nfa_add(parser->match, POD_MATCH_NFA_SPLIT, start, end, 0);
+		if(end == POD_MATCH_NONE || split == POD_MATCH_NONE)
+			return pod_match_parse_fail(parser, "out of memory");
+
+		if(op == '+')
+		{
+			/* start ... end -> split -> (start | end) */
+			parser->match->nfa[frag->end].out = split;
+		}
+		else
+		{
+			/* split -> (start ... end | end) */
+			parser->match->nfa[frag->end].out = end;
+			frag->start = split;
+		}
+		frag->end = end;
+	}
+}
+
+static pod_bool_t pod_match_parse_concat(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	if(!pod_match_frag_empty(parser, frag))
+		return false;
+
+	while(*parser->p != '\0' && *parser->p != '|' && *parser->p != ')')
+	{
+		pod_match_frag_t next;
+		if(!pod_match_parse_repeat(parser, &next))
+			return false;
+		parser->match->nfa[frag->end].out = next.start;
+		frag->end = next.end;
+	}
+	return true;
+}
+
+static pod_bool_t pod_match_parse_alt(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	if(!pod_match_parse_concat(parser, frag))
+		return false;
+
+	while(*parser->p == '|')
+	{
+		parser->p++;
+		pod_match_frag_t other;
+		if(!pod_match_parse_concat(parser, &other))
+			return false;
+
+		pod_number_t end = pod_match_nfa_add(parser->match, POD_MATCH_NFA_EMPTY, POD_MATCH_NONE, POD_MATCH_NONE, 0);
+		pod_number_t split = pod_match_nfa_add(parser->match, POD_MATCH_NFA_SPLIT, frag->start, other.start, 0);
+		if(end == POD_MATCH_NONE || split == POD_MATCH_NONE)
+			return pod_match_parse_fail(parser, "out of memory");
+		parser->match->nfa[frag->end].out = end;
+		parser->match->nfa[other.end].out = end;
+		frag->start = split;
+		frag->end = end;
+	}
+	return true;
+}
+
+/* any* fragment used for unanchored ends */
+static pod_bool_t pod_match_frag_any(pod_match_parser_t* parser, pod_match_frag_t* frag)
+{
+	pod_number_t set = pod_match_set_add(parser->match);
+	if(set == POD_MATCH_NONE)
+		return pod_match_parse_fail(parser, "out of memory");
+	memset(parser->match->sets[set], 0xFF, sizeof(parser->match->sets[0]));
+	return pod_match_frag_set(parser, set, frag) && pod_match_frag_star(parser, frag);
+}
+
+static pod_bool_t pod_match_add_regex(pod_match_t* match, const pod_char_t* expr, pod_byte_t flags)
+{
+	pod_size_t len = strlen(expr);
+	pod_bool_t anchor_start = len > 0 && expr[0] == '^';
+	pod_bool_t anchor_end = false;
+	if(len > (pod_size_t)anchor_start && expr[len - 1] == '$')
+	{
+		/* an odd number of backslashes in front escapes the dollar */
+		pod_size_t escapes = 0;
+		while(len - 1 - escapes > 0 && expr[len - 2 - escapes] == '\\')
+			escapes++;
+		anchor_end = (escapes & 1) == 0;
+	}
+
+	pod_size_t body_len = len - anchor_start - anchor_end;
+	pod_char_t* body = malloc(body_len + 1);
+	if(body == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_regex() could not allocate pattern!\n");
+		return false;
+	}
+	memcpy(body, expr + anchor_start, body_len);
+	body[body_len] = '\0';
+
+	pod_number_t nfa_count = match->nfa_count;
+	pod_number_t set_count = match->set_count;
+	pod_match_parser_t parser = { match, body, body, NULL };
+	pod_match_frag_t frag, any;
+
+	if(pod_match_parse_alt(&parser, &frag) && *parser.p != '\0')
+		pod_match_parse_fail(&parser, "unmatched )");
+
+	if(parser.error == NULL && !anchor_start && pod_match_frag_any(&parser, &any))
+	{
+		match->nfa[any.end].out = frag.start;
+		frag.start = any.start;
+	}
+	if(parser.error == NULL && !anchor_end && pod_match_frag_any(&parser, &any))
+	{
+		match->nfa[frag.end].out = any.start;
+		frag.end = any.end;
+	}
+
+	pod_number_t accept = POD_MATCH_NONE;
+	if(parser.error == NULL)
+	{
+		accept = pod_match_nfa_add(match, POD_MATCH_NFA_ACCEPT, POD_MATCH_NONE, flags, 0);
+		if(accept == POD_MATCH_NONE)
+			pod_match_parse_fail(&parser, "out of memory");
+	}
+
+	pod_number_t* starts = NULL;
+	if(parser.error == NULL)
+	{
+		starts = realloc(match->starts, (match->start_count + 1) * sizeof(pod_number_t));
+		if(starts == NULL)
+			pod_match_parse_fail(&parser, "out of memory");
+	}
+
+	if(parser.error != NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_regex() \"%s\" at offset %u: %s\n", expr, (pod_number_t)(parser.p - body + anchor_start), parser.error);
+		match->nfa_count = nfa_count;
+		match->set_count = set_count;
+		free(body);
+		return false;
+	}
+
+	match->nfa[frag.end].out = accept;
+	match->starts = starts;
+	match->starts[match->start_count++] = frag.start;
+	free(body);
+	return true;
+}
+
+/* --- globs --------------------------------------------------------------- */
+
+static pod_bool_t pod_match_add_glob(pod_match_t* match, const pod_char_t* glob, pod_byte_t flags)
+{
+	pod_size_t len = strlen(glob);
+	/* worst case every character becomes "[^/]*" plus the anchors */
+	pod_char_t* expr = malloc(len * 5 + 16);
+	if(expr == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_glob() could not allocate pattern!\n");
+		return false;
+	}
+
+	pod_char_t* out = expr;
+	*out++ = '^';
+	if(strpbrk(glob, "/\\") == NULL)
+	{
+		memcpy(out, "(.*/)?", 6);
+		out += 6;
+	}
+
+	for(const pod_char_t* p = glob; *p; p++)
+	{
+		switch(*p)
+		{
+			case '*':
+				if(p[1] != '*')
+				{
+					memcpy(out, "[^/]*", 5);
+					out += 5;
+					break;
+				}
+				while(p[1] == '*')
+					p++;
+				/* a whole ** component may also match no directory at all */
+				if((p[1] == '/' || p[1] == '\\') && (out[-1] == '/' || out[-1] == '^'))
+				{
+					memcpy(out, "(.*/)?", 6);
+					out += 6;
+					p++;
+				}
+				else
+				{
+					memcpy(out, ".*", 2);
+					out += 2;
+				}
+				break;
+			case '?':
+				memcpy(out, "[^/]", 4);
+				out += 4;
+				break;
+			case '[':
+			{
+				const pod_char_t* close = p + 1;
+				if(*close == '!' || *close == '^')
+					close++;
+				if(*close == ']')
+					close++;
+				while(*close && *close != ']')
+					close++;
+				if(*close == '\0')
+				{
+					*out++ = '\\';
+					*out++ = '[';
+					break;
+				}
+
+				*out++ = '[';
+				p++;
+				if(*p == '!' || *p == '^')
+				{
+					*out++ = '^';
+					p++;
+				}
+				for(; p < close; p++)
+				{
+					if(*p == '\\')
+						*out++ = '/';
+					else
+						*out++ = *p;
+				}
+				*out++ = ']';
+				break;
+			}
+			case '\\':
+			case '/':
+				*out++ = '/';
+				break;
+			case '.':
+			case '+':
+			case '(':
+			case ')':
+			case '|':
+			case '^':
+			case '$':
+			case '{':
+			case '}':
+			case ']':
+				*out++ = '\\';
+				*out++ = *p;
+				break;
+			default:
+				*out++ = *p;
+				break;
+		}
+	}
+	*out++ = '$';
+	*out = '\0';
+
+	pod_bool_t ok = pod_match_add_regex(match, expr, flags);
+	free(expr);
+	return ok;
+}
+
+/* --- substrings ---------------------------------------------------------- */
+
+static pod_bool_t pod_match_add_literal(pod_match_t* match, const pod_char_t* literal, pod_byte_t flags)
+{
+	pod_char_t** literals = realloc(match->literals, (match->literal_count + 1) * sizeof(pod_char_t*));
+	if(literals != NULL)
+		match->literals = literals;
+	pod_byte_t* literal_flags = realloc(match->literal_flags, (match->literal_count + 1) * sizeof(pod_byte_t));
+	if(literal_flags != NULL)
+		match->literal_flags = literal_flags;
+	pod_char_t* copy = strdup(literal);
+
+	if(literals == NULL || literal_flags == NULL || copy == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_literal() could not allocate \"%s\"!\n", literal);
+		free(copy);
+		return false;
+	}
+
+	for(pod_char_t* c = copy; *c; c++)
+		*c = pod_index_fold(*c);
+
+	match->literals[match->literal_count] = copy;
+	match->literal_flags[match->literal_count] = flags;
+	match->literal_count++;
+	return true;
+}
+
+/* build the Aho-Corasick goto table, missing edges fall back to the longest */
+/* suffix so scanning a name is one table lookup per character              */
+static pod_bool_t pod_match_ac_compile(pod_match_t* match)
+{
+	free(match->ac_next);
+	free(match->ac_flags);
+	match->ac_next = NULL;
+	match->ac_flags = NULL;
+	match->ac_count = 0;
+
+	if(match->literal_count == 0)
+		return true;
+
+	pod_size_t capacity = 1;
+	for(pod_number_t i = 0; i < match->literal_count; i++)
+		capacity += strlen(match->literals[i]);
+
+	match->ac_next = calloc(capacity, sizeof(*match->ac_next));
+	match->ac_flags = calloc(capacity, sizeof(pod_byte_t));
+	pod_number_t* fail = calloc(capacity, sizeof(pod_number_t));
+	pod_number_t* queue = malloc(capacity * sizeof(pod_number_t));
+	if(match->ac_next == NULL || match->ac_flags == NULL || fail == NULL || queue == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_ac_compile() could not allocate %zu states!\n", capacity);
+		free(fail);
+		free(queue);
+		return false;
+	}
+
+	/* trie, 0 is the root and never a child */
+	match->ac_count = 1;
+	for(pod_number_t i = 0; i < match->literal_count; i++)
+	{
+		pod_number_t node = 0;
+		for(const pod_char_t* c = match->literals[i]; *c; c++)
+		{
+			pod_byte_t b = (pod_byte_t)*c;
+			if(match->ac_next[node][b] == 0)
+				match->ac_next[node][b] = match->ac_count++;
+			node = match->ac_next[node][b];
+		}
+		match->ac_flags[node] |= match->literal_flags[i];
+	}
+
+	pod_size_t head = 0, tail = 0;
+	for(pod_number_t c = 0; c < 256; c++)
+	{
+		if(match->ac_next[0][c] != 0)
+			queue[tail++] = match->ac_next[0][c];
+	}
+
+	while(head < tail)
+	{
+		pod_number_t node = queue[head++];
+		for(pod_number_t c = 0; c < 256; c++)
+		{
+			pod_number_t child = match->ac_next[node][c];
+			if(child == 0)
+			{
+				match->ac_next[node][c] = match->ac_next[fail[node]][c];
+				continue;
+			}
+			fail[child] = match->ac_next[fail[node]][c];
+			match->ac_flags[child] |= match->ac_flags[fail[child]];
+			queue[tail++] = child;
+		}
+	}
+
+	free(fail);
+	free(queue);
+	return true;
+}
+
+/* --- lazy DFA ------------------------------------------------------------ */
+
+static int pod_match_number_compare(const void* a, const void* b)
+{
+	pod_number_t x = *(const pod_number_t*)a;
+	pod_number_t y = *(const pod_number_t*)b;
+	return x < y ? -1 : x > y;
+}
+
+/* add the epsilon closure of state to match->closure */
+static void pod_match_closure(pod_match_t* match, pod_number_t state, pod_number_t* count)
+{
+	pod_number_t depth = 0;
+	match->stack[depth++] = state;
+
+	while(depth > 0)
+	{
+		pod_number_t s = match->stack[--depth];
+		if(s == POD_MATCH_NONE || match->marks[s] == match->mark)
+			continue;
+		match->marks[s] = match->mark;
+
+		pod_match_nfa_state_t* nfa = &match->nfa[s];
+		switch(nfa->type)
+		{
+			case POD_MATCH_NFA_SPLIT:
+				match->stack[depth++] = nfa->out1;
+				/* fall through */
+			case POD_MATCH_NFA_EMPTY:
+				match->stack[depth++] = nfa->out;
+				break;
+			default:
+				match->closure[(*count)++] = s;
+				break;
+		}
+	}
+}
+
+/* @returns dfa index of the set in match->closure, adding it if needed */
+static pod_number_t pod_match_dfa_state(pod_match_t* match, pod_number_t count)
+{
+	qsort(match->closure, count, sizeof(pod_number_t), pod_match_number_compare);
+
+	pod_number_t hash = 0x811c9dc5;
+	for(pod_number_t i = 0; i < count; i++)
+		hash = (hash ^ match->closure[i]) * 0x01000193;
+
+	pod_number_t mask = POD_MATCH_DFA_SLOTS - 1;
+	pod_number_t slot = hash & mask;
+	for(; match->dfa_slots[slot] != 0; slot = (slot + 1) & mask)
+	{
+		pod_match_dfa_state_t* dfa = &match->dfa[match->dfa_slots[slot] - 1];
+		if(dfa->hash == hash && dfa->count == count && memcmp(dfa->nfa, match->closure, count * sizeof(pod_number_t)) == 0)
+			return match->dfa_slots[slot] - 1;
+	}
+
+	pod_match_dfa_state_t* dfa = &match->dfa[match->dfa_count];
+	dfa->nfa = malloc((count > 0 ? count : 1) * sizeof(pod_number_t));
+	if(dfa->nfa == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_dfa_state() could not allocate %u states!\n", count);
+		return POD_MATCH_NONE;
+	}
+	memcpy(dfa->nfa, match->closure, count * sizeof(pod_number_t));
+	memset(dfa->next, 0xFF, sizeof(dfa->next));
+	dfa->count = count;
+	dfa->hash = hash;
+	dfa->flags = 0;
+	for(pod_number_t i = 0; i < count; i++)
+	{
+		if(match->nfa[match->closure[i]].type == POD_MATCH_NFA_ACCEPT)
+			dfa->flags |= match->nfa[match->closure[i]].out1;
+	}
+
+	match->dfa_slots[slot] = match->dfa_count + 1;
+	return match->dfa_count++;
+}
+
+static pod_number_t pod_match_dfa_start(pod_match_t* match)
+{
+	pod_number_t count = 0;
+	match->mark++;
+	for(pod_number_t i = 0; i < match->start_count; i++)
+		pod_match_closure(match, match->starts[i], &count);
+	return pod_match_dfa_state(match, count);
+}
+
+/* @returns the dfa state reached from state on c, building it on demand */
+static pod_number_t pod_match_dfa_step(pod_match_t* match, pod_number_t state, pod_byte_t c)
+{
+	pod_number_t count = 0;
+	match->mark++;
+	pod_match_dfa_state_t* dfa = &match->dfa[state];
+	for(pod_number_t i = 0; i < dfa->count; i++)
+	{
+		pod_match_nfa_state_t* nfa = &match->nfa[dfa->nfa[i]];
+		if(nfa->type == POD_MATCH_NFA_SET && pod_match_has_bit(match->sets[nfa->set], c))
+			pod_match_closure(match, nfa->out, &count);
+	}
+
+	/* the closure buffer survives a flush, only the cached states go */
+	if(match->dfa_count + 1 >= POD_MATCH_DFA_MAX_STATES)
+	{
+		pod_number_t* closure = match->closure;
+		match->closure = malloc(match->nfa_count * sizeof(pod_number_t));
+		if(match->closure == NULL)
+		{
+			match->closure = closure;
+			fprintf(stderr, "ERROR: pod_match_dfa_step() could not flush states!\n");
+			return POD_MATCH_NONE;
+		}
+		pod_match_dfa_clear(match);
+		pod_match_dfa_start(match);
+		free(match->closure);
+		match->closure = closure;
+		return pod_match_dfa_state(match, count);
+	}
+
+	pod_number_t next = pod_match_dfa_state(match, count);
+	match->dfa[state].next[c] = next;
+	return next;
+}
+
+static pod_bool_t pod_match_compile(pod_match_t* match)
+{
+	if(!pod_match_ac_compile(match))
+		return false;
+
+	pod_match_dfa_clear(match);
+	free(match->marks);
+	free(match->stack);
+	free(match->closure);
+	match->marks = NULL;
+	match->stack = NULL;
+	match->closure = NULL;
+
+	if(match->start_count > 0)
+	{
+		pod_number_t states = match->nfa_count;
+		/* every state is expanded once and pushes at most two edges */
+		match->marks = calloc(states, sizeof(pod_number_t));
+		match->stack = malloc((states * 2 + 1) * sizeof(pod_number_t));
+		match->closure = malloc(states * sizeof(pod_number_t));
+		if(match->dfa == NULL)
+			match->dfa = malloc(POD_MATCH_DFA_MAX_STATES * sizeof(pod_match_dfa_state_t));
+		if(match->dfa_slots == NULL)
+			match->dfa_slots = calloc(POD_MATCH_DFA_SLOTS, sizeof(pod_number_t));
+		if(match->marks == NULL || match->stack == NULL || match->closure == NULL || match->dfa == NULL || match->dfa_slots == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_match_compile() could not allocate automaton for %u states!\n", states);
+			return false;
+		}
+		match->mark = 0;
+		if(pod_match_dfa_start(match) == POD_MATCH_NONE)
+			return false;
+	}
+
+	match->dirty = false;
+	return true;
+}
+
+/* --- public interface ---------------------------------------------------- */
+
+pod_bool_t pod_match_add(pod_match_t* match, const pod_char_t* rule)
+{
+	if(match == NULL || rule == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add() match or rule equals NULL!\n");
+		return false;
+	}
+
+	pod_byte_t flags = POD_MATCH_INCLUDE;
+	if(rule[0] == '!')
+	{
+		flags = POD_MATCH_EXCLUDE;
+		rule++;
+	}
+
+	pod_bool_t ok;
+	if(strncmp(rule, "re:", 3) == 0)
+		ok = pod_match_add_regex(match, rule + 3, flags);
+	else if(strncmp(rule, "glob:", 5) == 0)
+		ok = pod_match_add_glob(match, rule + 5, flags);
+	else if(strpbrk(rule, "*?[") != NULL)
+		ok = pod_match_add_glob(match, rule, flags);
+	else
+		ok = pod_match_add_literal(match, rule, flags);
+
+	if(!ok)
+		return false;
+
+	if(flags == POD_MATCH_INCLUDE)
+		match->includes++;
+	match->dirty = true;
+	return true;
+}
+
+pod_bool_t pod_match_add_file(pod_match_t* match, pod_path_t filename)
+{
+	if(match == NULL || filename == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_file() match or filename equals NULL!\n");
+		return false;
+	}
+
+	FILE* file = fopen(filename, "r");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_match_add_file() fopen(%s) failed: %s\n", filename, strerror(errno));
+		return false;
+	}
+
+	pod_char_t line[POD_MATCH_LINE_SIZE];
+	pod_number_t number = 0;
+	pod_bool_t ok = true;
+	while(fgets(line, sizeof(line), file) != NULL)
+	{
+		number++;
+		pod_size_t len = strlen(line);
+		while(len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+			line[--len] = '\0';
+
+		if(len == 0 || line[0] == '#')
+			continue;
+
+		if(!pod_match_add(match, line))
+		{
+			fprintf(stderr, "ERROR: pod_match_add_file() invalid rule in %s line %u\n", filename, number);
+			ok = false;
+		}
+	}
+
+	fclose(file);
+	return ok;
+}
+
+pod_bool_t pod_match_test(pod_match_t* match, const pod_char_t* name)
+{
+	if(match == NULL)
+		return true;
+
+	if(match->dirty && !pod_match_compile(match))
+		return false;
+
+	/* both automata advance together, one pass over the name */
+	pod_byte_t flags = match->ac_count > 0 ? match->ac_flags[0] : 0;
+	pod_number_t ac = 0;
+	pod_number_t dfa = match->start_count > 0 ? 0 : POD_MATCH_NONE;
+
+	for(const pod_char_t* p = name; *p; p++)
+	{
+		pod_byte_t c = (pod_byte_t)pod_index_fold(*p);
+		if(match->ac_count > 0)
+		{
+			ac = match->ac_next[ac][c];
+			flags |= match->ac_flags[ac];
+		}
+		if(dfa != POD_MATCH_NONE)
+		{
+			pod_number_t next = match->dfa[dfa].next[c];
+			dfa = next != POD_MATCH_NONE ? next : pod_match_dfa_step(match, dfa, c);
+			if(dfa == POD_MATCH_NONE)
+				return false;
+		}
+	}
+
+	if(dfa != POD_MATCH_NONE)
+		flags |= match->dfa[dfa].flags;
+
+	if(flags & POD_MATCH_EXCLUDE)
+		return false;
+	return match->includes == 0 || (flags & POD_MATCH_INCLUDE);
+}
@@ -0,0 +1,81 @@
+#ifndef _POD_MATCH_H
+#define _POD_MATCH_H
+
+#define POD_MATCH_INCLUDE                    0x01                     /* accept bit of include rules    */
+#define POD_MATCH_EXCLUDE                    0x02                     /* accept bit of "!" rules        */
+#define POD_MATCH_NONE                       0xFFFFFFFF               /* no state / transition unknown  */
+#define POD_MATCH_DFA_MAX_STATES             4096                     /* flush the lazy DFA beyond this */
+#define POD_MATCH_LINE_SIZE                  4096                     /* longest rule in a pattern file */
+
+/* entry name filter compiled from include and exclude rules                 */
+/*   "!rule"     excludes the names matching rule                            */
+/*   "re:expr"   regular expression with . [] [^] * + ? | () ^ $ and \       */
+/*   "glob:expr" or any rule containing * ? [ is a glob, * and ? stay inside */
+/*               a path component, ** crosses them and a glob without a     */
+/*               separator is matched against the base name                 */
+/*   otherwise   a substring, all substrings share one Aho-Corasick DFA     */
+/* names are folded like pod_index (case, '\' == '/'), a name is selected if */
+/* it matches any include rule (or there are none) and no exclude rule       */
+/* globs and regexes share one NFA whose DFA is built lazily while testing,  */
+/* so a matcher must not be shared between threads                           */
+typedef struct pod_match_nfa_state_s
+{
+	pod_byte_t type;
+	pod_number_t out;
+	pod_number_t out1;  /* second edge of a split, accept bits of an accept */
+	pod_number_t set;   /* character set consumed before out */
+} pod_match_nfa_state_t;
+
+typedef struct pod_match_dfa_state_s
+{
+	pod_number_t next[256];
+	pod_number_t* nfa;  /* sorted consuming and accepting nfa states */
+	pod_number_t count;
+	pod_number_t hash;
+	pod_byte_t flags;
+} pod_match_dfa_state_t;
+
+typedef struct pod_match_s
+{
+	pod_number_t includes;
+	pod_bool_t dirty;   /* rules were added since the last compile */
+
+	/* substring rules and their Aho-Corasick goto table */
+	pod_char_t** literals;
+	pod_byte_t* literal_flags;
+	pod_number_t literal_count;
+	pod_number_t (*ac_next)[256];
+	pod_byte_t* ac_flags;
+	pod_number_t ac_count;
+
+	/* thompson NFA of all glob and regex rules */
+	pod_match_nfa_state_t* nfa;
+	pod_number_t nfa_count;
+	pod_number_t nfa_capacity;
+	pod_byte_t (*sets)[32];
+	pod_number_t set_count;
+	pod_number_t set_capacity;
+	pod_number_t* starts;
+	pod_number_t start_count;
+
+	/* lazily built DFA, state 0 is the start state */
+	pod_match_dfa_state_t* dfa;
+	pod_number_t dfa_count;
+	pod_number_t* dfa_slots; /* dfa index + 1, 0 marks an empty slot */
+	pod_number_t* marks;
+	pod_number_t mark;
+	pod_number_t* stack;
+	pod_number_t* closure;
+} pod_match_t;
+
+pod_match_t* pod_match_create();
+pod_match_t* pod_match_delete(pod_match_t* match);
+/* add one rule, @returns false and leaves match unchanged on syntax errors */
+pod_bool_t pod_match_add(pod_match_t* match, const pod_char_t* rule);
+/* add one rule per line of filename, empty lines and lines starting with # */
+/* are skipped                                                              */
+pod_bool_t pod_match_add_file(pod_match_t* match, pod_path_t filename);
+/* @returns true if name is selected, a NULL matcher selects every name */
+pod_bool_t pod_match_test(pod_match_t* match, const pod_char_t* name);
+
+#endif
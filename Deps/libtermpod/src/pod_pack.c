@@ -0,0 +1,248 @@
+#include "pod_common.h"
+
+struct pod_pack_s
+{
+	pod_scan_t* scan;
+	pod_number_t threads;
+	const pod_policy_t* policy;
+	pod_bool_t dedup;
+	pod_number_t* hashes;       /* content crc by scan entry when deduplicating */
+	pod_number_t* slots;        /* open addressing by hash, scan entry + 1 of unique contents */
+	pod_number_t slot_count;    /* power of two */
+	pod_number_t slot_used;
+	pod_pack_item_t* items;     /* the current window */
+	pod_number_t first;         /* scan entry of items[0] */
+	pod_number_t count;
+	pod_number_t next;          /* item handed out next */
+};
+
+/* pod_pool_job_t loading item index of the window, hashed when deduplicating */
+static pod_bool_t pod_pack_load_job(void* context, pod_number_t index)
+{
+	pod_pack_t* pack = context;
+	pod_pack_item_t* item = &pack->items[index];
+
+	item->ok = pod_scan_load(item->entry, &item->content);
+	if(!item->ok)
+		return false;
+
+	if(pack->dedup && item->content.size > 0)
+		item->hash = pod_crc(item->content.data, item->content.size);
+	return true;
+}
+
+pod_bool_t pod_pack_deflate(pod_pack_t* pack, pod_pack_item_t* item)
+{
+	if(pack == NULL || item == NULL || !item->ok)
+		return false;
+
+	if(pack->policy == NULL || item->packed != NULL)
+		return true;
+
+	pod_number_t level = pod_policy_level(pack->policy, item->entry->name, item->content.data, item->content.size);
+	if(level > 0)
+	{
+		item->packed = pod_codec_deflate(pod_codec_thread(), item->content.data, (pod_number_t)item->content.size, level, item->entry->name, &item->packed_size);
+		if(item->packed != NULL)
+			item->level = level;
+	}
+
+	/* stored bytes never exceed the file */
+	if(item->packed != NULL && item->packed_size >= item->content.size)
+	{
+		free(item->packed);
+		item->packed = NULL;
+		item->level = 0;
+	}
+	return true;
+}
+
+/* pod_pool_job_t deflating item index of the window unless it is a duplicate */
+static pod_bool_t pod_pack_deflate_job(void* context, pod_number_t index)
+{
+	pod_pack_t* pack = context;
+	pod_pack_item_t* item = &pack->items[index];
+	return item->duplicate != 0 || pod_pack_deflate(pack, item);
+}
+
+/* pod_pool_job_t doing both at once when nothing has to happen in between */
+static pod_bool_t pod_pack_job(void* context, pod_number_t index)
+{
+	return pod_pack_load_job(context, index) && pod_pack_deflate_job(context, index);
+}
+
+/* @returns true if scan entry first has the content of item, byte for byte; */
+/* entries of earlier windows were unloaded and are read again              */
+static pod_bool_t pod_pack_equal(pod_pack_t* pack, pod_number_t first, const pod_pack_item_t* item)
+{
+	if(first >= pack->first)
+		return memcmp(pack->items[first - pack->first].content.data, item->content.data, item->content.size) == 0;
+
+	pod_scan_data_t content;
+	if(!pod_scan_load(&pack->scan->entries[first], &content))
+		return false;
+	pod_bool_t equal = content.size == item->content.size && memcmp(content.data, item->content.data, item->content.size) == 0;
+	pod_scan_unload(&content);
+	return equal;
+}
+
+static pod_bool_t pod_pack_grow(pod_pack_t* pack)
+{
+	pod_number_t count = pack->slot_count ? pack->slot_count * 2 : 1024;
+	pod_number_t* slots = calloc(count, sizeof(pod_number_t));
+	if(slots == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_pack_grow() could not allocate %u slots!\n", count);
+		return false;
+	}
+
+	for(pod_number_t i = 0; i < pack->slot_count; i++)
+	{
+		if(pack->slots[i] == 0)
+			continue;
+		pod_number_t slot = pack->hashes[pack->slots[i] - 1] & (count - 1);
+		while(slots[slot] != 0)
+			slot = (slot + 1) & (count - 1);
+		slots[slot] = pack->slots[i];
+	}
+
+	free(pack->slots);
+	pack->slots = slots;
+	pack->slot_count = count;
+	return true;
+}
+
+/* mark the items of the window equal to an earlier file, in scan order so */
+/* the first copy is always the one that gets stored                       */
+static void pod_pack_dedup(pod_pack_t* pack)
+{
+	for(pod_number_t i = 0; i < pack->count; i++)
+	{
+		pod_pack_item_t* item = &pack->items[i];
+		if(!item->ok || item->content.size == 0)
+			continue;
+
+		pod_number_t entry = pack->first + i;
+		pack->hashes[entry] = item->hash;
+
+		pod_number_t mask = pack->slot_count - 1;
+		pod_number_t slot = item->hash & mask;
+		for(; pack->slots[slot] != 0; slot = (slot + 1) & mask)
+		{
+			pod_number_t first = pack->slots[slot] - 1;
+			if(pack->hashes[first] == item->hash && pack->scan->entries[first].size == item->content.size &&
+			   pod_pack_equal(pack, first, item))
+			{
+				item->duplicate = first + 1;
+				break;
+			}
+		}
+		if(item->duplicate != 0)
+			continue;
+
+		/* keep the table at most half full, without room later files */
+		/* are simply stored again                                     */
+		pack->slots[slot] = entry + 1;
+		if(++pack->slot_used * 2 > pack->slot_count && !pod_pack_grow(pack))
+		{
+			pack->dedup = false;
+			return;
+		}
+	}
+}
+
+static void pod_pack_release(pod_pack_t* pack)
+{
+	for(pod_number_t i = 0; i < pack->count; i++)
+	{
+		pod_scan_unload(&pack->items[i].content);
+		free(pack->items[i].packed);
+	}
+	pack->first += pack->count;
+	pack->count = 0;
+	pack->next = 0;
+}
+
+pod_pack_t* pod_pack_create(pod_scan_t* scan, pod_number_t threads, const pod_policy_t* policy, pod_bool_t dedup)
+{
+	if(scan == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_pack_create(scan == NULL)\n");
+		return NULL;
+	}
+
+	pod_pack_t* pack = calloc(1, sizeof(pod_pack_t));
+	if(pack == NULL || (pack->items = calloc(POD_PACK_WINDOW_COUNT, sizeof(pod_pack_item_t))) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_pack_create() could not allocate %u items!\n", POD_PACK_WINDOW_COUNT);
+		free(pack);
+		return NULL;
+	}
+
+	pack->scan = scan;
+	pack->threads = threads > 0 ? threads : pod_pool_cpu_count();
+	pack->policy = policy;
+	if(dedup)
+	{
+		pack->hashes = calloc(scan->count > 0 ? scan->count : 1, sizeof(pod_number_t));
+		if(pack->hashes == NULL || !pod_pack_grow(pack))
+		{
+			fprintf(stderr, "ERROR: pod_pack_create() could not allocate %u hashes!\n", scan->count);
+			return pod_pack_delete(pack);
+		}
+		pack->dedup = true;
+	}
+	return pack;
+}
+
+pod_pack_t* pod_pack_delete(pod_pack_t* pack)
+{
+	if(pack == NULL)
+		return NULL;
+
+	pod_pack_release(pack);
+	free(pack->hashes);
+	free(pack->slots);
+	free(pack->items);
+	free(pack);
+	return NULL;
+}
+
+pod_pack_item_t* pod_pack_next(pod_pack_t* pack)
+{
+	if(pack == NULL)
+		return NULL;
+	if(pack->next < pack->count)
+		return &pack->items[pack->next++];
+
+	pod_pack_release(pack);
+	if(pack->first >= pack->scan->count)
+		return NULL;
+
+	/* a window ends before the file that would exceed its byte budget, */
+	/* but always takes at least one file however large                 */
+	pod_size_t bytes = 0;
+	while(pack->first + pack->count < pack->scan->count && pack->count < POD_PACK_WINDOW_COUNT)
+	{
+		const pod_scan_entry_t* entry = &pack->scan->entries[pack->first + pack->count];
+		if(pack->count > 0 && bytes + entry->size > POD_PACK_WINDOW_SIZE)
+			break;
+		bytes += entry->size;
+
+		pod_pack_item_t* item = &pack->items[pack->count++];
+		memset(item, 0, sizeof(pod_pack_item_t));
+		item->entry = entry;
+	}
+
+	/* failed items are reported by their ok flag in order; deduplication */
+	/* needs the whole window loaded before anything is deflated          */
+	if(pack->dedup)
+	{
+		pod_pool_run(pack->threads, pack->count, pod_pack_load_job, pack);
+		pod_pack_dedup(pack);
+		pod_pool_run(pack->threads, pack->count, pod_pack_deflate_job, pack);
+	}
+	else
+		pod_pool_run(pack->threads, pack->count, pod_pack_job, pack);
+	return &pack->items[pack->next++];
+}
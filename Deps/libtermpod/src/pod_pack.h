@@ -0,0 +1,42 @@
+#ifndef _POD_PACK_H
+#define _POD_PACK_H
+
+#define POD_PACK_WINDOW_SIZE                 0x4000000                /* file bytes loaded ahead        */
+#define POD_PACK_WINDOW_COUNT                4096                     /* files loaded ahead             */
+
+/* one scanned file made ready for an archive, its memory belongs to the */
+/* pack and stays valid until the next pod_pack_next()                   */
+typedef struct pod_pack_item_s
+{
+	const pod_scan_entry_t* entry;
+	pod_scan_data_t content;    /* the file as is */
+	pod_byte_t* packed;         /* deflated content, NULL if stored or not smaller */
+	pod_number_t packed_size;
+	pod_number_t level;         /* compression level of packed, 0 if stored */
+	pod_bool_t ok;              /* content could be loaded */
+	pod_number_t hash;          /* crc of content when deduplicating */
+	pod_number_t duplicate;     /* scan entry + 1 with the same content, 0 if unique; */
+	                            /* duplicates are not deflated                       */
+} pod_pack_item_t;
+
+/* creation pipeline feeding the files of a scan to an archive writer in  */
+/* scan order. Files are taken a window at a time, the files of a window  */
+/* are loaded and deflated on pool workers and then handed out one by one */
+/* in order, so the archive comes out the same for any number of workers. */
+/* Deduplicating packs hash every loaded file, compare files of the same  */
+/* size and hash byte for byte and only deflate the first of equal ones.  */
+typedef struct pod_pack_s pod_pack_t;
+
+/* pack the entries of scan on threads workers, 0 uses every processor; */
+/* policy picks the deflate level of each file, without one files are   */
+/* only loaded; with dedup files equal to an earlier one are handed out */
+/* as its duplicate                                                     */
+pod_pack_t* pod_pack_create(pod_scan_t* scan, pod_number_t threads, const pod_policy_t* policy, pod_bool_t dedup);
+pod_pack_t* pod_pack_delete(pod_pack_t* pack);
+/* @returns the next file in scan order, NULL after the last */
+pod_pack_item_t* pod_pack_next(pod_pack_t* pack);
+/* deflate a duplicate item on the calling thread, for writers that cannot */
+/* share the data of its first copy                                       */
+pod_bool_t pod_pack_deflate(pod_pack_t* pack, pod_pack_item_t* item);
+
+#endif
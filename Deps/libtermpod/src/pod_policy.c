@@ -0,0 +1,245 @@
+#include "pod_common.h"
+
+/* formats that are compressed already and do not shrink any further */
+static const pod_char_t* POD_POLICY_STORED[] =
+{
+	"bik", "bk2", "jpg", "jpeg", "png", "gif", "ogg", "mp3", "wma", "xma",
+	"zip", "gz", "bz2", "xz", "7z", "rar", "cab",
+};
+
+pod_policy_t* pod_policy_create()
+{
+	pod_policy_t* policy = calloc(1, sizeof(pod_policy_t));
+	if(policy == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_policy_create() could not allocate policy!\n");
+		return NULL;
+	}
+
+	for(pod_number_t i = 0; i < sizeof(POD_POLICY_STORED) / sizeof(POD_POLICY_STORED[0]); i++)
+	{
+		if(!pod_policy_add(policy, POD_POLICY_STORED[i], 0))
+			return pod_policy_delete(policy);
+	}
+	return policy;
+}
+
+pod_policy_t* pod_policy_delete(pod_policy_t* policy)
+{
+	if(policy == NULL)
+		return NULL;
+
+	free(policy->rules);
+	free(policy);
+	return NULL;
+}
+
+/* lower case copy of extension without its dot into rule sized buffer */
+static pod_bool_t pod_policy_fold(const pod_char_t* extension, pod_char_t* folded)
+{
+	if(*extension == '.')
+		extension++;
+
+	pod_size_t len = strlen(extension);
+	if(len == 0 || len >= POD_POLICY_EXTENSION_SIZE)
+		return false;
+
+	for(pod_size_t i = 0; i <= len; i++)
+		folded[i] = (pod_char_t)tolower((unsigned char)extension[i]);
+	return true;
+}
+
+static pod_policy_rule_t* pod_policy_find(const pod_policy_t* policy, const pod_char_t* folded)
+{
+	for(pod_number_t i = 0; i < policy->count; i++)
+	{
+		if(strcmp(policy->rules[i].extension, folded) == 0)
+			return &policy->rules[i];
+	}
+	return NULL;
+}
+
+pod_bool_t pod_policy_add(pod_policy_t* policy, const pod_char_t* extension, pod_number_t level)
+{
+	if(policy == NULL || extension == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_policy_add(policy == NULL || extension == NULL)\n");
+		return false;
+	}
+	if(level > 9 && level != POD_POLICY_AUTO)
+	{
+		fprintf(stderr, "ERROR: pod_policy_add(%s) level %u is not 0 to 9!\n", extension, level);
+		return false;
+	}
+
+	pod_char_t folded[POD_POLICY_EXTENSION_SIZE];
+	if(!pod_policy_fold(extension, folded))
+	{
+		fprintf(stderr, "ERROR: pod_policy_add(%s) extension is empty or too long!\n", extension);
+		return false;
+	}
+
+	/* a later rule for the same extension replaces the earlier one */
+	pod_policy_rule_t* rule = pod_policy_find(policy, folded);
+	if(rule == NULL)
+	{
+		if(policy->count == policy->capacity)
+		{
+			pod_number_t capacity = policy->capacity ? policy->capacity * 2 : 16;
+			pod_policy_rule_t* grown = realloc(policy->rules, capacity * sizeof(pod_policy_rule_t));
+			if(grown == NULL)
+			{
+				fprintf(stderr, "ERROR: pod_policy_add() could not allocate %u rules!\n", capacity);
+				return false;
+			}
+			policy->rules = grown;
+			policy->capacity = capacity;
+		}
+		rule = &policy->rules[policy->count++];
+		strcpy(rule->extension, folded);
+	}
+	rule->level = level;
+	return true;
+}
+
+pod_bool_t pod_policy_add_file(pod_policy_t* policy, pod_path_t filename)
+{
+	if(policy == NULL || filename == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_policy_add_file() policy or filename equals NULL!\n");
+		return false;
+	}
+
+	FILE* file = fopen(filename, "r");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_policy_add_file() fopen(%s) failed: %s\n", filename, strerror(errno));
+		return false;
+	}
+
+	pod_char_t line[POD_POLICY_LINE_SIZE];
+	pod_number_t number = 0;
+	pod_bool_t ok = true;
+	while(fgets(line, sizeof(line), file) != NULL)
+	{
+		number++;
+		pod_char_t extension[POD_POLICY_LINE_SIZE];
+		pod_char_t level[POD_POLICY_LINE_SIZE];
+		pod_char_t rest[2];
+
+		pod_char_t* start = line;
+		while(isspace((unsigned char)*start))
+			start++;
+		if(*start == '\0' || *start == '#')
+			continue;
+
+		pod_number_t value = 0;
+		pod_bool_t valid = sscanf(start, "%255s %255s %1s", extension, level, rest) == 2;
+		if(valid && strcmp(level, "store") == 0)
+			value = 0;
+		else if(valid && strcmp(level, "auto") == 0)
+			value = POD_POLICY_AUTO;
+		else if(valid && level[0] >= '0' && level[0] <= '9' && level[1] == '\0')
+			value = level[0] - '0';
+		else
+			valid = false;
+
+		if(!valid || !pod_policy_add(policy, extension, value))
+		{
+			fprintf(stderr, "ERROR: pod_policy_add_file() invalid rule in %s line %u\n", filename, number);
+			ok = false;
+		}
+	}
+
+	fclose(file);
+	return ok;
+}
+
+/* @returns log2(x) for x > 0 with 16 fraction bits, found bit by bit */
+/* by squaring the mantissa so the library does not need libm         */
+static uint64_t pod_policy_log2(pod_number_t x)
+{
+	uint64_t result = 0;
+	for(pod_number_t rest = x; rest >= 2; rest >>= 1)
+		result += 1 << 16;
+
+	uint64_t y = ((uint64_t)x << 16) >> (result >> 16);
+	for(uint64_t bit = 1 << 15; bit > 0; bit >>= 1)
+	{
+		y = (y * y) >> 16;
+		if(y >= 2 << 16)
+		{
+			y >>= 1;
+			result |= bit;
+		}
+	}
+	return result;
+}
+
+/* @returns the order 0 entropy of up to POD_POLICY_SAMPLE_COUNT samples */
+/* spread evenly over data in millibits per byte                         */
+static pod_number_t pod_policy_entropy(const pod_byte_t* data, pod_size_t size)
+{
+	pod_number_t counts[256] = { 0 };
+	pod_number_t total = 0;
+
+	pod_size_t sample = size < POD_POLICY_SAMPLE_SIZE ? size : POD_POLICY_SAMPLE_SIZE;
+	pod_size_t stride = size <= sample * POD_POLICY_SAMPLE_COUNT ? sample : (size - sample) / (POD_POLICY_SAMPLE_COUNT - 1);
+	for(pod_size_t offset = 0; offset + sample <= size && total < sample * POD_POLICY_SAMPLE_COUNT; offset += stride)
+	{
+		for(pod_size_t i = 0; i < sample; i++)
+			counts[data[offset + i]]++;
+		total += (pod_number_t)sample;
+	}
+
+	/* H = log2(n) - sum(c * log2(c)) / n */
+	uint64_t sum = 0;
+	for(pod_number_t i = 0; i < 256; i++)
+	{
+		if(counts[i] > 0)
+			sum += counts[i] * pod_policy_log2(counts[i]);
+	}
+	uint64_t bits = pod_policy_log2(total) - sum / total;
+	return (pod_number_t)((bits * 1000) >> 16);
+}
+
+/* @returns true if a quick deflate of the start of data shrinks it enough */
+/* to be worth deflating all of it                                         */
+static pod_bool_t pod_policy_probe(const pod_byte_t* data, pod_size_t size, const pod_char_t* name)
+{
+	pod_number_t probe = (pod_number_t)(size < POD_POLICY_PROBE_SIZE ? size : POD_POLICY_PROBE_SIZE);
+	pod_number_t result = 0;
+	pod_byte_t* packed = pod_codec_deflate(pod_codec_thread(), (pod_byte_t*)data, probe, POD_POLICY_PROBE_LEVEL, (pod_string_t)name, &result);
+	if(packed == NULL)
+		return false;
+
+	free(packed);
+	return result < probe - probe / 32;
+}
+
+pod_number_t pod_policy_level(const pod_policy_t* policy, const pod_char_t* name, const pod_byte_t* data, pod_size_t size)
+{
+	if(policy == NULL || name == NULL || data == NULL || size == 0)
+		return 0;
+
+	const pod_char_t* base = strrchr(name, POD_PATH_SEPARATOR);
+	const pod_char_t* dot = strrchr(base != NULL ? base + 1 : name, '.');
+	pod_char_t folded[POD_POLICY_EXTENSION_SIZE];
+	if(dot != NULL && pod_policy_fold(dot, folded))
+	{
+		const pod_policy_rule_t* rule = pod_policy_find(policy, folded);
+		if(rule != NULL && rule->level != POD_POLICY_AUTO)
+			return rule->level;
+	}
+
+	if(size < POD_POLICY_MIN_SIZE)
+		return 0;
+	if(pod_policy_entropy(data, size) >= POD_POLICY_ENTROPY_PROBE && !pod_policy_probe(data, size, name))
+		return 0;
+
+	if(size >= 1024 * 4)
+		return 8;
+	if(size >= 1024 * 2)
+		return 4;
+	return 2;
+}
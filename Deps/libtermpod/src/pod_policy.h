@@ -0,0 +1,46 @@
+#ifndef _POD_POLICY_H
+#define _POD_POLICY_H
+
+#define POD_POLICY_AUTO                      0xFFFFFFFF               /* level chosen from the content  */
+#define POD_POLICY_EXTENSION_SIZE            16                       /* longest extension of a rule    */
+#define POD_POLICY_LINE_SIZE                 256                      /* longest line of a policy file  */
+#define POD_POLICY_MIN_SIZE                  1024                     /* smaller files are stored       */
+#define POD_POLICY_SAMPLE_SIZE               0x1000                   /* bytes of one entropy sample    */
+#define POD_POLICY_SAMPLE_COUNT              4                        /* samples spread over a file     */
+#define POD_POLICY_ENTROPY_PROBE             7500                     /* millibits per byte to probe    */
+#define POD_POLICY_PROBE_SIZE                0x10000                  /* bytes deflated by the probe    */
+#define POD_POLICY_PROBE_LEVEL               1                        /* level of the probe             */
+
+/* deflate level of one extension, 0 stores, POD_POLICY_AUTO estimates */
+typedef struct pod_policy_rule_s
+{
+	pod_char_t extension[POD_POLICY_EXTENSION_SIZE]; /* lower case, without the dot */
+	pod_number_t level;
+} pod_policy_rule_t;
+
+/* store-or-deflate decision of the creation path for POD4 to POD6.        */
+/* An extension rule wins, already compressed media is stored by default. */
+/* Files without a rule are stored below POD_POLICY_MIN_SIZE, otherwise   */
+/* the byte entropy of a few samples is estimated; near random content   */
+/* must also shrink a level 1 deflate of its start by 1/32 or is stored, */
+/* everything else gets the level its size has always had.               */
+typedef struct pod_policy_s
+{
+	pod_policy_rule_t* rules;
+	pod_number_t count;
+	pod_number_t capacity;
+} pod_policy_t;
+
+/* @returns a policy with the built-in rules for compressed media */
+pod_policy_t* pod_policy_create();
+pod_policy_t* pod_policy_delete(pod_policy_t* policy);
+/* set the level of extension, a leading dot is ignored */
+pod_bool_t pod_policy_add(pod_policy_t* policy, const pod_char_t* extension, pod_number_t level);
+/* add one "extension level" rule per line of filename, level is 0 to 9, */
+/* store or auto; empty lines and lines starting with # are skipped      */
+pod_bool_t pod_policy_add_file(pod_policy_t* policy, pod_path_t filename);
+/* @returns the deflate level for entry name with size bytes of data, 0 stores; */
+/* safe to call from several threads                                            */
+pod_number_t pod_policy_level(const pod_policy_t* policy, const pod_char_t* name, const pod_byte_t* data, pod_size_t size);
+
+#endif
@@ -0,0 +1,190 @@
+#include "pod_common.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct pod_mutex_s
+{
+#ifdef _WIN32
+	CRITICAL_SECTION section;
+#else
+	pthread_mutex_t mutex;
+#endif
+};
+
+typedef struct pod_pool_s
+{
+	pod_mutex_t* lock;
+	pod_number_t next;
+	pod_number_t count;
+	pod_bool_t ok;
+	pod_pool_job_t job;
+	void* context;
+} pod_pool_t;
+
+pod_mutex_t* pod_mutex_create()
+{
+	pod_mutex_t* mutex = calloc(1, sizeof(pod_mutex_t));
+	if(mutex == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_mutex_create() could not allocate mutex!\n");
+		return NULL;
+	}
+
+#ifdef _WIN32
+	InitializeCriticalSection(&mutex->section);
+#else
+	if(pthread_mutex_init(&mutex->mutex, NULL) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_mutex_create() pthread_mutex_init failed!\n");
+		free(mutex);
+		return NULL;
+	}
+#endif
+	return mutex;
+}
+
+pod_mutex_t* pod_mutex_delete(pod_mutex_t* mutex)
+{
+	if(mutex == NULL)
+		return NULL;
+
+#ifdef _WIN32
+	DeleteCriticalSection(&mutex->section);
+#else
+	pthread_mutex_destroy(&mutex->mutex);
+#endif
+	free(mutex);
+	return NULL;
+}
+
+void pod_mutex_lock(pod_mutex_t* mutex)
+{
+#ifdef _WIN32
+	EnterCriticalSection(&mutex->section);
+#else
+	pthread_mutex_lock(&mutex->mutex);
+#endif
+}
+
+void pod_mutex_unlock(pod_mutex_t* mutex)
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&mutex->section);
+#else
+	pthread_mutex_unlock(&mutex->mutex);
+#endif
+}
+
+pod_number_t pod_pool_cpu_count()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (pod_number_t)count : 1;
+#endif
+}
+
+static void pod_pool_work(pod_pool_t* pool)
+{
+	for(;;)
+	{
+		pod_mutex_lock(pool->lock);
+		pod_number_t index = pool->next < pool->count ? pool->next++ : pool->count;
+		pod_mutex_unlock(pool->lock);
+
+		if(index == pool->count)
+			return;
+
+		if(!pool->job(pool->context, index))
+		{
+			pod_mutex_lock(pool->lock);
+			pool->ok = false;
+			pod_mutex_unlock(pool->lock);
+		}
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI pod_pool_thread(LPVOID pool)
+{
+	pod_pool_work(pool);
+	return 0;
+}
+#else
+static void* pod_pool_thread(void* pool)
+{
+	pod_pool_work(pool);
+	return NULL;
+}
+#endif
+
+pod_bool_t pod_pool_run(pod_number_t threads, pod_number_t count, pod_pool_job_t job, void* context)
+{
+	if(job == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_pool_run() job equals NULL!\n");
+		return false;
+	}
+
+	if(threads > POD_POOL_MAX_THREADS)
+		threads = POD_POOL_MAX_THREADS;
+	if(threads > count)
+		threads = count;
+
+	pod_pool_t pool = { NULL, 0, count, true, job, context };
+
+	/* no pool needed for a single worker */
+	if(threads <= 1)
+	{
+		for(pod_number_t i = 0; i < count; i++)
+		{
+			if(!job(context, i))
+				pool.ok = false;
+		}
+		return pool.ok;
+	}
+
+	if((pool.lock = pod_mutex_create()) == NULL)
+		return false;
+
+#ifdef _WIN32
+	HANDLE workers[POD_POOL_MAX_THREADS];
+#else
+	pthread_t workers[POD_POOL_MAX_THREADS];
+#endif
+	pod_number_t started = 0;
+	for(; started < threads - 1; started++)
+	{
+#ifdef _WIN32
+		workers[started] = CreateThread(NULL, 0, pod_pool_thread, &pool, 0, NULL);
+		if(workers[started] == NULL)
+			break;
+#else
+		if(pthread_create(&workers[started], NULL, pod_pool_thread, &pool) != 0)
+			break;
+#endif
+	}
+
+	/* fewer workers only cost speed, the caller drains the rest */
+	pod_pool_work(&pool);
+
+	for(pod_number_t i = 0; i < started; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(workers[i], INFINITE);
+		CloseHandle(workers[i]);
+#else
+		pthread_join(workers[i], NULL);
+#endif
+	}
+
+	pod_mutex_delete(pool.lock);
+	return pool.ok;
+}
@@ -0,0 +1,25 @@
+#ifndef _POD_POOL_H
+#define _POD_POOL_H
+
+#define POD_POOL_MAX_THREADS                 64                       /* upper bound of -j              */
+
+/* portable mutex, opaque so only pod_pool.c sees the system headers */
+typedef struct pod_mutex_s pod_mutex_t;
+
+pod_mutex_t* pod_mutex_create();
+pod_mutex_t* pod_mutex_delete(pod_mutex_t* mutex);
+void pod_mutex_lock(pod_mutex_t* mutex);
+void pod_mutex_unlock(pod_mutex_t* mutex);
+
+/* job callback, @returns false if job index failed */
+typedef pod_bool_t (*pod_pool_job_t)(void* context, pod_number_t index);
+
+/* @returns the number of online processors, at least one */
+pod_number_t pod_pool_cpu_count();
+/* run jobs 0 to count - 1 on up to threads workers, the calling thread      */
+/* being one of them; workers take the next free index so jobs start in     */
+/* order, every job runs once even if others fail                            */
+/* @returns true if all jobs succeeded                                       */
+pod_bool_t pod_pool_run(pod_number_t threads, pod_number_t count, pod_pool_job_t job, void* context);
+
+#endif
@@ -0,0 +1,414 @@
+#include "pod_common.h"
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+/* one directory of a level, filled by the worker that lists it */
+typedef struct pod_scan_dir_s
+{
+	pod_string_t name;  /* relative to root, '/' separated, "" is root */
+	pod_scan_entry_t* files;
+	pod_number_t count;
+	pod_number_t capacity;
+	pod_string_t* subdirs;
+	pod_number_t subdir_count;
+	pod_number_t subdir_capacity;
+} pod_scan_dir_t;
+
+typedef struct pod_scan_level_s
+{
+	pod_scan_t* scan;
+	pod_scan_dir_t* dirs;
+	pod_number_t count;
+#ifndef _WIN32
+	int fd;             /* root */
+#endif
+} pod_scan_level_t;
+
+/* @returns "parent/child", or child if parent is empty */
+static pod_string_t pod_scan_join(const pod_char_t* parent, const pod_char_t* child)
+{
+	pod_size_t parent_size = strlen(parent);
+	pod_size_t child_size = strlen(child);
+	pod_size_t sep = parent_size > 0 && parent[parent_size - 1] != '/' && parent[parent_size - 1] != '\\';
+	pod_string_t joined = malloc(parent_size + sep + child_size + 1);
+	if(joined == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_join() could not allocate path of %s!\n", child);
+		return NULL;
+	}
+	memcpy(joined, parent, parent_size);
+	if(sep)
+		joined[parent_size] = '/';
+	memcpy(joined + parent_size + sep, child, child_size + 1);
+	return joined;
+}
+
+static pod_bool_t pod_scan_add_subdir(pod_scan_dir_t* dir, const pod_char_t* child)
+{
+	if(dir->subdir_count == dir->subdir_capacity)
+	{
+		pod_number_t capacity = dir->subdir_capacity ? dir->subdir_capacity * 2 : 16;
+		pod_string_t* grown = realloc(dir->subdirs, capacity * sizeof(pod_string_t));
+		if(grown == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_scan_add_subdir() could not allocate %u directories!\n", capacity);
+			return false;
+		}
+		dir->subdirs = grown;
+		dir->subdir_capacity = capacity;
+	}
+
+	pod_string_t name = pod_scan_join(dir->name, child);
+	if(name == NULL)
+		return false;
+	dir->subdirs[dir->subdir_count++] = name;
+	return true;
+}
+
+static pod_bool_t pod_scan_add_file(pod_scan_t* scan, pod_scan_dir_t* dir, const pod_char_t* child, pod_size_t size, pod_time_t mtime)
+{
+	if(dir->count == dir->capacity)
+	{
+		pod_number_t capacity = dir->capacity ? dir->capacity * 2 : 64;
+		pod_scan_entry_t* grown = realloc(dir->files, capacity * sizeof(pod_scan_entry_t));
+		if(grown == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_scan_add_file() could not allocate %u files!\n", capacity);
+			return false;
+		}
+		dir->files = grown;
+		dir->capacity = capacity;
+	}
+
+	pod_scan_entry_t* entry = &dir->files[dir->count];
+	entry->name = pod_scan_join(dir->name, child);
+	entry->path = entry->name != NULL ? pod_scan_join(scan->root, entry->name) : NULL;
+	if(entry->path == NULL)
+	{
+		free(entry->name);
+		return false;
+	}
+	for(pod_char_t* c = entry->name; *c; c++)
+	{
+		if(*c == '/')
+			*c = POD_PATH_SEPARATOR;
+	}
+	entry->size = size;
+	entry->mtime = mtime;
+	dir->count++;
+	return true;
+}
+
+/* pod_pool_job_t listing directory index of the level */
+static pod_bool_t pod_scan_job(void* context, pod_number_t index)
+{
+	pod_scan_level_t* level = context;
+	pod_scan_dir_t* dir = &level->dirs[index];
+	pod_bool_t ok = true;
+
+#ifdef _WIN32
+	pod_char_t pattern[POD_SYSTEM_PATH_SIZE];
+	if(snprintf(pattern, sizeof(pattern), "%s/%s%s*", level->scan->root, dir->name, dir->name[0] ? "/" : "") >= (int)sizeof(pattern))
+	{
+		fprintf(stderr, "ERROR: pod_scan_job() path %s/%s too long!\n", level->scan->root, dir->name);
+		return false;
+	}
+
+	/* the listing already carries size and time, nothing is stat()ed */
+	struct __finddata64_t found;
+	intptr_t handle = _findfirst64(pattern, &found);
+	if(handle == -1)
+	{
+		fprintf(stderr, "ERROR: _findfirst64(%s) failed: %s\n", pattern, strerror(errno));
+		return false;
+	}
+	do
+	{
+		if(strcmp(found.name, ".") == 0 || strcmp(found.name, "..") == 0)
+			continue;
+		if(found.attrib & _A_SUBDIR)
+			ok = pod_scan_add_subdir(dir, found.name) && ok;
+		else
+			ok = pod_scan_add_file(level->scan, dir, found.name, found.size, found.time_write) && ok;
+	} while(ok && _findnext64(handle, &found) == 0);
+	_findclose(handle);
+#else
+	int fd = openat(level->fd, dir->name[0] ? dir->name : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	DIR* listing = fd >= 0 ? fdopendir(fd) : NULL;
+	if(listing == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_job() could not list %s/%s: %s\n", level->scan->root, dir->name, strerror(errno));
+		if(fd >= 0)
+			close(fd);
+		return false;
+	}
+
+	for(struct dirent* found = readdir(listing); ok && found != NULL; found = readdir(listing))
+	{
+		if(strcmp(found->d_name, ".") == 0 || strcmp(found->d_name, "..") == 0)
+			continue;
+
+		/* directories are known from the listing, links to files are */
+		/* followed but links to directories are not descended into   */
+		int flags = AT_SYMLINK_NOFOLLOW;
+#ifdef DT_DIR
+		if(found->d_type == DT_DIR)
+		{
+			ok = pod_scan_add_subdir(dir, found->d_name);
+			continue;
+		}
+		if(found->d_type == DT_LNK)
+			flags = 0;
+#endif
+		/* dangling links and files removed meanwhile are not part of the tree */
+		struct stat st;
+		if(fstatat(fd, found->d_name, &st, flags) != 0)
+		{
+			if(errno == ENOENT)
+				continue;
+			fprintf(stderr, "ERROR: fstatat(%s/%s%s%s) failed: %s\n", level->scan->root, dir->name, dir->name[0] ? "/" : "", found->d_name, strerror(errno));
+			ok = false;
+		}
+		else if(S_ISREG(st.st_mode))
+			ok = pod_scan_add_file(level->scan, dir, found->d_name, st.st_size, st.st_mtime);
+		else if(S_ISDIR(st.st_mode) && flags != 0)
+			ok = pod_scan_add_subdir(dir, found->d_name);
+	}
+	closedir(listing);
+#endif
+	return ok;
+}
+
+static int pod_scan_compare(const void* a, const void* b)
+{
+	return strcmp(((const pod_scan_entry_t*)a)->name, ((const pod_scan_entry_t*)b)->name);
+}
+
+/* move the files of the level into scan and its subdirectories into next */
+/* @returns false if memory ran out, the level is released either way     */
+static pod_bool_t pod_scan_collect(pod_scan_t* scan, pod_scan_level_t* level, pod_scan_dir_t** next, pod_number_t* next_count)
+{
+	pod_bool_t ok = true;
+	pod_number_t files = 0;
+	pod_number_t subdirs = 0;
+	for(pod_number_t i = 0; i < level->count; i++)
+	{
+		files += level->dirs[i].count;
+		subdirs += level->dirs[i].subdir_count;
+	}
+
+	pod_scan_entry_t* entries = realloc(scan->entries, ((pod_size_t)scan->count + files + 1) * sizeof(pod_scan_entry_t));
+	*next = calloc(subdirs > 0 ? subdirs : 1, sizeof(pod_scan_dir_t));
+	*next_count = 0;
+	if(entries != NULL)
+		scan->entries = entries;
+	if(entries == NULL || *next == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_collect() could not allocate %u files and %u directories!\n", files, subdirs);
+		ok = false;
+	}
+
+	for(pod_number_t i = 0; i < level->count; i++)
+	{
+		pod_scan_dir_t* dir = &level->dirs[i];
+		for(pod_number_t f = 0; f < dir->count; f++)
+		{
+			if(ok)
+			{
+				scan->entries[scan->count++] = dir->files[f];
+				scan->size += dir->files[f].size;
+				continue;
+			}
+			free(dir->files[f].name);
+			free(dir->files[f].path);
+		}
+		for(pod_number_t d = 0; d < dir->subdir_count; d++)
+		{
+			if(ok)
+				(*next)[(*next_count)++].name = dir->subdirs[d];
+			else
+				free(dir->subdirs[d]);
+		}
+		free(dir->files);
+		free(dir->subdirs);
+		free(dir->name);
+	}
+	free(level->dirs);
+	level->dirs = NULL;
+	level->count = 0;
+	return ok;
+}
+
+pod_scan_t* pod_scan_create(pod_path_t root, pod_number_t threads)
+{
+	if(root == NULL || root[0] == '\0')
+	{
+		fprintf(stderr, "ERROR: pod_scan_create(root == NULL)\n");
+		return NULL;
+	}
+
+	pod_scan_t* scan = calloc(1, sizeof(pod_scan_t));
+	if(scan == NULL || (scan->root = strdup(root)) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_create() could not allocate scan of %s!\n", root);
+		free(scan);
+		return NULL;
+	}
+
+#ifdef _WIN32
+	pod_scan_level_t level = { scan, calloc(1, sizeof(pod_scan_dir_t)), 1 };
+#else
+	pod_scan_level_t level = { scan, calloc(1, sizeof(pod_scan_dir_t)), 1, -1 };
+#endif
+	if(level.dirs == NULL || (level.dirs[0].name = strdup("")) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_create() could not allocate scan of %s!\n", root);
+		free(level.dirs);
+		return pod_scan_delete(scan);
+	}
+
+#ifndef _WIN32
+	level.fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if(level.fd < 0)
+	{
+		fprintf(stderr, "ERROR: open(%s) failed: %s\n", root, strerror(errno));
+		free(level.dirs[0].name);
+		free(level.dirs);
+		return pod_scan_delete(scan);
+	}
+#endif
+
+	/* a level waits for its slowest directory, but needs no queue shared */
+	/* between workers that discover directories while others drain it    */
+	pod_bool_t ok = true;
+	while(level.count > 0)
+	{
+		ok = pod_pool_run(threads > 0 ? threads : pod_pool_cpu_count(), level.count, pod_scan_job, &level) && ok;
+
+		pod_scan_dir_t* next;
+		pod_number_t next_count;
+		ok = pod_scan_collect(scan, &level, &next, &next_count) && ok;
+		level.dirs = next;
+		level.count = ok ? next_count : 0;
+		if(!ok)
+		{
+			for(pod_number_t i = 0; i < next_count; i++)
+				free(next[i].name);
+		}
+	}
+	free(level.dirs);
+#ifndef _WIN32
+	close(level.fd);
+#endif
+
+	if(!ok)
+		return pod_scan_delete(scan);
+
+	qsort(scan->entries, scan->count, sizeof(pod_scan_entry_t), pod_scan_compare);
+	return scan;
+}
+
+pod_scan_t* pod_scan_delete(pod_scan_t* scan)
+{
+	if(scan == NULL)
+		return NULL;
+
+	for(pod_number_t i = 0; i < scan->count; i++)
+	{
+		free(scan->entries[i].name);
+		free(scan->entries[i].path);
+	}
+	free(scan->entries);
+	free(scan->root);
+	free(scan);
+	return NULL;
+}
+
+pod_bool_t pod_scan_load(const pod_scan_entry_t* entry, pod_scan_data_t* data)
+{
+	if(entry == NULL || data == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_scan_load(entry == NULL || data == NULL)\n");
+		return false;
+	}
+
+	data->data = NULL;
+	data->size = entry->size;
+	data->mapped = false;
+
+#ifdef _WIN32
+	FILE* file = fopen(entry->path, "rb");
+	if(file == NULL)
+	{
+		fprintf(stderr, "ERROR: fopen(%s) failed: %s\n", entry->path, strerror(errno));
+		return false;
+	}
+
+	data->data = malloc(entry->size > 0 ? entry->size : 1);
+	pod_size_t done = data->data != NULL ? fread(data->data, 1, entry->size, file) : 0;
+	fclose(file);
+#else
+	int fd = open(entry->path, O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+	{
+		fprintf(stderr, "ERROR: open(%s) failed: %s\n", entry->path, strerror(errno));
+		return false;
+	}
+
+	if(entry->size >= POD_SCAN_MAP_SIZE)
+	{
+		void* map = mmap(NULL, entry->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(map != MAP_FAILED)
+		{
+			madvise(map, entry->size, MADV_SEQUENTIAL);
+			close(fd);
+			data->data = map;
+			data->mapped = true;
+			return true;
+		}
+	}
+
+	/* small files, and large ones that do not map, are read into one buffer */
+	data->data = malloc(entry->size > 0 ? entry->size : 1);
+	pod_size_t done = 0;
+	while(data->data != NULL && done < entry->size)
+	{
+		ssize_t got = read(fd, data->data + done, entry->size - done);
+		if(got < 0 && errno == EINTR)
+			continue;
+		if(got <= 0)
+			break;
+		done += got;
+	}
+	close(fd);
+#endif
+
+	if(data->data == NULL || done != entry->size)
+	{
+		if(data->data == NULL)
+			fprintf(stderr, "ERROR: pod_scan_load() could not allocate %zu bytes for %s!\n", entry->size, entry->path);
+		else
+			fprintf(stderr, "ERROR: pod_scan_load() read %zu of %zu bytes of %s!\n", done, entry->size, entry->path);
+		free(data->data);
+		data->data = NULL;
+		return false;
+	}
+	return true;
+}
+
+void pod_scan_unload(pod_scan_data_t* data)
+{
+	if(data == NULL || data->data == NULL)
+		return;
+
+#ifndef _WIN32
+	if(data->mapped)
+		munmap(data->data, data->size);
+	else
+#endif
+		free(data->data);
+	data->data = NULL;
+}
@@ -0,0 +1,44 @@
+#ifndef _POD_SCAN_H
+#define _POD_SCAN_H
+
+#define POD_SCAN_MAP_SIZE                    0x100000                 /* files mapped instead of read   */
+
+/* one regular file found below the scanned root */
+typedef struct pod_scan_entry_s
+{
+	pod_string_t path;  /* to open, root prefixed */
+	pod_string_t name;  /* relative to root, POD_PATH_SEPARATOR separated */
+	pod_size_t size;
+	pod_time_t mtime;
+} pod_scan_entry_t;
+
+/* files below a directory for archive creation, collected in one pass.    */
+/* The tree is walked a level at a time with the directories of a level    */
+/* listed on pool workers; every file costs one stat that yields size and  */
+/* time together. Entries are sorted by name so archives come out the same */
+/* whatever order the file system lists them in.                           */
+typedef struct pod_scan_s
+{
+	pod_string_t root;
+	pod_scan_entry_t* entries;
+	pod_number_t count;
+	pod_size_t size;    /* bytes of all entries */
+} pod_scan_t;
+
+/* contents of a scanned file */
+typedef struct pod_scan_data_s
+{
+	pod_byte_t* data;
+	pod_size_t size;
+	pod_bool_t mapped;
+} pod_scan_data_t;
+
+/* scan root on threads workers, 0 uses every processor */
+pod_scan_t* pod_scan_create(pod_path_t root, pod_number_t threads);
+pod_scan_t* pod_scan_delete(pod_scan_t* scan);
+/* map entry, or read it with one call below POD_SCAN_MAP_SIZE; the size */
+/* the scan found is used, so files must not shrink until unloaded       */
+pod_bool_t pod_scan_load(const pod_scan_entry_t* entry, pod_scan_data_t* data);
+void pod_scan_unload(pod_scan_data_t* data);
+
+#endif
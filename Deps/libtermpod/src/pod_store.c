@@ -0,0 +1,387 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* copy_file_range */
+#endif
+#include "pod_common.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+static pod_byte_t* pod_store_read(pod_string_t filename, pod_size_t size)
+{
+	FILE* file = fopen(filename, "rb");
+	if(!file)
+	{
+		fprintf(stderr, "ERROR: Could not open POD file: %s\n", filename);
+		return NULL;
+	}
+
+	pod_byte_t* data = calloc(1, size);
+	if(!data)
+	{
+		fprintf(stderr, "ERROR: Could not allocate memory of size %zu for file %s!\n", size, filename);
+		fclose(file);
+		return NULL;
+	}
+
+	if(fread(data, POD_BYTE_SIZE, size, file) != size * POD_BYTE_SIZE)
+	{
+		fprintf(stderr, "ERROR: Could not read file %s!\n", filename);
+		fclose(file);
+		free(data);
+		return NULL;
+	}
+
+	fclose(file);
+	return data;
+}
+
+static pod_bool_t pod_store_open(pod_store_t* store)
+{
+#ifdef _WIN32
+	store->file = CreateFileA(store->filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(store->file == INVALID_HANDLE_VALUE)
+	{
+		fprintf(stderr, "ERROR: CreateFileA(%s) failed with error %lu\n", store->filename, GetLastError());
+		store->file = NULL;
+		return false;
+	}
+#else
+	store->fd = open(store->filename, O_RDONLY);
+	if(store->fd < 0)
+	{
+		fprintf(stderr, "ERROR: open(%s) failed: %s\n", store->filename, strerror(errno));
+		return false;
+	}
+#endif
+	return true;
+}
+
+static pod_bool_t pod_store_map(pod_store_t* store)
+{
+	if(!pod_store_open(store))
+		return false;
+#ifdef _WIN32
+	/* copy-on-write so format loaders may patch header fields in place */
+	store->mapping = CreateFileMappingA(store->file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if(store->mapping == NULL)
+	{
+		fprintf(stderr, "ERROR: CreateFileMappingA(%s) failed with error %lu\n", store->filename, GetLastError());
+		return false;
+	}
+
+	store->data = MapViewOfFile(store->mapping, FILE_MAP_COPY, 0, 0, store->size);
+	if(store->data == NULL)
+	{
+		fprintf(stderr, "ERROR: MapViewOfFile(%s) failed with error %lu\n", store->filename, GetLastError());
+		return false;
+	}
+#else
+	/* copy-on-write so format loaders may patch header fields in place */
+	void* data = mmap(NULL, store->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, store->fd, 0);
+	if(data == MAP_FAILED)
+	{
+		fprintf(stderr, "ERROR: mmap(%s) failed: %s\n", store->filename, strerror(errno));
+		return false;
+	}
+	store->data = data;
+#endif
+	return true;
+}
+
+static pod_bool_t pod_store_reserve(pod_store_t* store)
+{
+	if(!pod_store_open(store))
+		return false;
+
+	store->loaded = calloc(store->size / POD_STORE_CHUNK_SIZE / 8 + 1, sizeof(pod_byte_t));
+	store->lock = pod_mutex_create();
+	if(store->loaded == NULL || store->lock == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate chunk map for file %s!\n", store->filename);
+		return false;
+	}
+
+	/* untouched pages of the reservation cost no physical memory */
+#ifdef _WIN32
+	store->data = VirtualAlloc(NULL, store->size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if(store->data == NULL)
+	{
+		fprintf(stderr, "ERROR: VirtualAlloc(%zu) failed with error %lu\n", store->size, GetLastError());
+		return false;
+	}
+#else
+	void* data = mmap(NULL, store->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(data == MAP_FAILED)
+	{
+		fprintf(stderr, "ERROR: mmap(%zu) failed: %s\n", store->size, strerror(errno));
+		return false;
+	}
+	store->data = data;
+#endif
+	return true;
+}
+
+static pod_bool_t pod_store_pread(pod_store_t* store, pod_size_t offset, pod_size_t size)
+{
+	while(size > 0)
+	{
+#ifdef _WIN32
+		DWORD read = 0;
+		DWORD want = size > 0x40000000 ? 0x40000000 : (DWORD)size;
+		OVERLAPPED at = { 0 };
+		at.Offset = (DWORD)((uint64_t)offset & 0xFFFFFFFF);
+		at.OffsetHigh = (DWORD)((uint64_t)offset >> 32);
+		if(!ReadFile(store->file, store->data + offset, want, &read, &at) || read == 0)
+		{
+			fprintf(stderr, "ERROR: ReadFile(%s) at %zu failed with error %lu\n", store->filename, offset, GetLastError());
+			return false;
+		}
+#else
+		ssize_t read = pread(store->fd, store->data + offset, size, offset);
+		if(read < 0 && errno == EINTR)
+			continue;
+		if(read <= 0)
+		{
+			fprintf(stderr, "ERROR: pread(%s) at %zu failed: %s\n", store->filename, offset, read < 0 ? strerror(errno) : "end of file");
+			return false;
+		}
+#endif
+		offset += read;
+		size -= read;
+	}
+	return true;
+}
+
+pod_byte_t* pod_store_load(pod_string_t filename, pod_open_mode_t mode, pod_store_t** store, pod_size_t* size)
+{
+	*store = NULL;
+
+	struct stat sb;
+	if(stat(filename, &sb) != 0 || sb.st_size == 0)
+	{
+		perror("stat");
+		return NULL;
+	}
+
+	*size = sb.st_size;
+
+	if(mode == POD_OPEN_READ)
+		return pod_store_read(filename, *size);
+
+	pod_store_t* s = calloc(1, sizeof(pod_store_t));
+	if(s == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate POD store for file %s!\n", filename);
+		return NULL;
+	}
+
+	s->mode = mode;
+	s->size = *size;
+	s->filename = strdup(filename);
+#ifndef _WIN32
+	s->fd = -1;
+#endif
+
+	switch(mode)
+	{
+		case POD_OPEN_MMAP:
+			if(!pod_store_map(s))
+			{
+				pod_store_close(s);
+				return NULL;
+			}
+			break;
+		case POD_OPEN_LAZY:
+			if(!pod_store_reserve(s))
+			{
+				pod_store_close(s);
+				return NULL;
+			}
+			break;
+		default:
+			fprintf(stderr, "ERROR: pod_store_load() unknown open mode %d!\n", mode);
+			pod_store_close(s);
+			return NULL;
+	}
+
+	*store = s;
+	return s->data;
+}
+
+pod_store_t* pod_store_close(pod_store_t* store)
+{
+	if(store == NULL)
+		return NULL;
+
+#ifdef _WIN32
+	if(store->data && store->mode == POD_OPEN_LAZY)
+		VirtualFree(store->data, 0, MEM_RELEASE);
+	else if(store->data)
+		UnmapViewOfFile(store->data);
+	if(store->mapping)
+		CloseHandle(store->mapping);
+	if(store->file)
+		CloseHandle(store->file);
+#else
+	if(store->data)
+		munmap(store->data, store->size);
+	if(store->fd >= 0)
+		close(store->fd);
+#endif
+	free(store->loaded);
+	pod_mutex_delete(store->lock);
+	free(store->filename);
+	free(store);
+	return NULL;
+}
+
+pod_bool_t pod_store_fetch(pod_store_t* store, pod_size_t offset, pod_size_t size)
+{
+	if(!pod_store_is_lazy(store) || size == 0)
+		return true;
+
+	if(offset > store->size || size > store->size - offset)
+	{
+		fprintf(stderr, "ERROR: pod_store_fetch(%zu, %zu) exceeds file %s of size %zu!\n", offset, size, store->filename, store->size);
+		return false;
+	}
+
+	pod_size_t first = offset / POD_STORE_CHUNK_SIZE;
+	pod_size_t last = (offset + size - 1) / POD_STORE_CHUNK_SIZE;
+	pod_bool_t ok = true;
+
+	/* chunks are marked only after their read, under the same lock */
+	pod_mutex_lock(store->lock);
+	for(pod_size_t chunk = first; chunk <= last; chunk++)
+	{
+		if(store->loaded[chunk / 8] & (1 << (chunk % 8)))
+			continue;
+
+		/* read a run of missing chunks with one call */
+		pod_size_t end = chunk;
+		while(end < last && !(store->loaded[(end + 1) / 8] & (1 << ((end + 1) % 8))))
+			end++;
+
+		pod_size_t start = chunk * POD_STORE_CHUNK_SIZE;
+		pod_size_t stop = (end + 1) * POD_STORE_CHUNK_SIZE;
+		if(stop > store->size)
+			stop = store->size;
+
+		if(!pod_store_pread(store, start, stop - start))
+		{
+			ok = false;
+			break;
+		}
+
+		for(; chunk <= end; chunk++)
+			store->loaded[chunk / 8] |= 1 << (chunk % 8);
+		chunk = end;
+	}
+	pod_mutex_unlock(store->lock);
+
+	return ok;
+}
+
+pod_bool_t pod_store_is_lazy(pod_store_t* store)
+{
+	return store != NULL && store->mode == POD_OPEN_LAZY;
+}
+
+void pod_store_advise(pod_store_t* store, pod_size_t offset, pod_size_t size, pod_store_advice_t advice)
+{
+#ifndef _WIN32
+	if(store == NULL || size == 0 || offset >= store->size)
+		return;
+	if(size > store->size - offset)
+		size = store->size - offset;
+
+#ifdef POSIX_FADV_WILLNEED
+	if(store->fd >= 0)
+		posix_fadvise(store->fd, offset, size, advice == POD_STORE_WILLNEED ? POSIX_FADV_WILLNEED : POSIX_FADV_DONTNEED);
+#endif
+
+	/* MADV_DONTNEED would drop the patched copy-on-write pages, so consumed */
+	/* ranges of the map are only marked as the first to reclaim            */
+	if(store->mode == POD_OPEN_MMAP)
+	{
+		pod_size_t page = (pod_size_t)sysconf(_SC_PAGESIZE);
+		pod_size_t start = offset / page * page;
+		if(advice == POD_STORE_WILLNEED)
+			madvise(store->data + start, offset + size - start, MADV_WILLNEED);
+#ifdef MADV_COLD
+		else
+			madvise(store->data + start, offset + size - start, MADV_COLD);
+#endif
+	}
+#endif
+}
+
+pod_ssize_t pod_store_copy(pod_store_t* store, pod_size_t offset, pod_size_t size, FILE* output)
+{
+#ifdef __linux__
+	if(store == NULL || store->fd < 0 || output == NULL || size == 0)
+		return 0;
+
+	if(offset > store->size || size > store->size - offset)
+	{
+		fprintf(stderr, "ERROR: pod_store_copy(%zu, %zu) exceeds file %s of size %zu!\n", offset, size, store->filename, store->size);
+		return -1;
+	}
+
+	/* whatever output buffered so far has to land before the copied bytes */
+	if(fflush(output) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_store_copy() fflush failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	/* explicit input offsets leave the shared archive fd position alone */
+	int out = fileno(output);
+	loff_t at = offset;
+	pod_size_t copied = 0;
+	pod_bool_t use_sendfile = false;
+	while(copied < size)
+	{
+		ssize_t moved;
+		if(use_sendfile)
+		{
+			off_t from = at;
+			moved = sendfile(out, store->fd, &from, size - copied);
+			at = from;
+		}
+		else
+		{
+			moved = copy_file_range(store->fd, &at, out, NULL, size - copied, 0);
+		}
+
+		if(moved < 0 && errno == EINTR)
+			continue;
+
+		/* kernels and file systems without support leave nothing written */
+		if(moved < 0 && copied == 0 && !use_sendfile &&
+		   (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP || errno == EBADF))
+		{
+			use_sendfile = true;
+			continue;
+		}
+		if(moved < 0 && copied == 0 && use_sendfile && (errno == ENOSYS || errno == EINVAL))
+			return 0;
+
+		if(moved <= 0)
+		{
+			fprintf(stderr, "ERROR: pod_store_copy(%s) at %zu failed: %s\n", store->filename, offset + copied, moved < 0 ? strerror(errno) : "end of file");
+			return -1;
+		}
+		copied += moved;
+	}
+	return copied;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,57 @@
+#ifndef _POD_STORE_H
+#define _POD_STORE_H
+
+#define POD_STORE_CHUNK_SIZE                 0x10000                  /* lazy fetch granularity         */
+
+enum pod_store_advice_t
+{
+	POD_STORE_WILLNEED,
+	POD_STORE_DONTNEED,
+};
+typedef enum pod_store_advice_t pod_store_advice_t;
+
+/* backing store of an opened POD archive image                              */
+/* POD_OPEN_READ copies the whole archive into heap memory owned by the      */
+/* pod file, POD_OPEN_MMAP maps it copy-on-write so pages load on demand.    */
+/* POD_OPEN_LAZY reserves a zeroed image of the archive size and reads       */
+/* chunks into it only when pod_store_fetch() asks for them.                 */
+typedef struct pod_store_s
+{
+	pod_open_mode_t mode;
+	pod_byte_t* data;
+	pod_size_t size;
+	pod_string_t filename;
+	pod_byte_t* loaded; /* POD_OPEN_LAZY: one bit per chunk */
+	pod_mutex_t* lock;  /* POD_OPEN_LAZY: fetches may come from several threads */
+#ifdef _WIN32
+	void* file;    /* HANDLE */
+	void* mapping; /* HANDLE */
+#else
+	int fd;
+#endif
+} pod_store_t;
+
+/* load the archive image of filename                                        */
+/* @returns the image and its size; for POD_OPEN_READ the image is heap      */
+/* memory owned by the caller and *store is NULL, otherwise the image        */
+/* belongs to *store and is released with pod_store_close()                  */
+pod_byte_t* pod_store_load(pod_string_t filename, pod_open_mode_t mode, pod_store_t** store, pod_size_t* size);
+pod_store_t* pod_store_close(pod_store_t* store);
+
+/* make size bytes at offset of the image resident                           */
+/* @returns true if the range is readable; always true unless store is lazy  */
+/* safe to call from several threads at once                                 */
+pod_bool_t pod_store_fetch(pod_store_t* store, pod_size_t offset, pod_size_t size);
+pod_bool_t pod_store_is_lazy(pod_store_t* store);
+/* hint that size bytes at offset are read soon (POD_STORE_WILLNEED) or */
+/* were consumed (POD_STORE_DONTNEED) so the kernel reads ahead or drops */
+/* them from the page cache; the image keeps its contents either way and */
+/* systems without the calls ignore the hint                             */
+void pod_store_advise(pod_store_t* store, pod_size_t offset, pod_size_t size, pod_store_advice_t advice);
+/* copy size bytes at offset of the archive to output inside the kernel     */
+/* (copy_file_range, then sendfile) without touching the image              */
+/* @returns size if copied, 0 if there is no archive fd or the kernel can  */
+/* not copy here and nothing was written, -1 on errors                      */
+pod_ssize_t pod_store_copy(pod_store_t* store, pod_size_t offset, pod_size_t size, FILE* output);
+
+#endif
@@ -0,0 +1,169 @@
+#include "pod_common.h"
+
+/* ustar header, every numeric field is NUL terminated octal */
+typedef struct pod_tar_header_s
+{
+	pod_char_t name[POD_TAR_NAME_SIZE];
+	pod_char_t mode[8];
+	pod_char_t uid[8];
+	pod_char_t gid[8];
+	pod_char_t size[12];
+	pod_char_t mtime[12];
+	pod_char_t checksum[8];
+	pod_char_t type;
+	pod_char_t linkname[100];
+	pod_char_t magic[6];
+	pod_char_t version[2];
+	pod_char_t uname[32];
+	pod_char_t gname[32];
+	pod_char_t devmajor[8];
+	pod_char_t devminor[8];
+	pod_char_t prefix[POD_TAR_PREFIX_SIZE];
+	pod_char_t pad[12];
+} pod_tar_header_t;
+
+static const pod_byte_t pod_tar_zeros[POD_TAR_BLOCK_SIZE];
+
+static pod_bool_t pod_tar_write(FILE* output, const void* data, pod_size_t size)
+{
+	if(size > 0 && fwrite(data, 1, size, output) != size)
+	{
+		fprintf(stderr, "ERROR: pod_tar_write() could not write %zu bytes: %s\n", size, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+/* zero fill up to the next block after size bytes */
+static pod_bool_t pod_tar_pad(FILE* output, pod_size_t size)
+{
+	pod_size_t rest = size % POD_TAR_BLOCK_SIZE;
+	return rest == 0 || pod_tar_write(output, pod_tar_zeros, POD_TAR_BLOCK_SIZE - rest);
+}
+
+static void pod_tar_octal(pod_char_t* field, pod_size_t field_size, uint64_t value)
+{
+	snprintf(field, field_size, "%0*llo", (int)(field_size - 1), (unsigned long long)value);
+}
+
+static pod_bool_t pod_tar_header(FILE* output, pod_char_t type, const pod_char_t* name, pod_size_t name_size, const pod_char_t* prefix, pod_size_t prefix_size, pod_size_t size, pod_time_t mtime)
+{
+	pod_tar_header_t header;
+	memset(&header, 0, sizeof(header));
+
+	memcpy(header.name, name, name_size);
+	memcpy(header.prefix, prefix, prefix_size);
+	pod_tar_octal(header.mode, sizeof(header.mode), 0644);
+	pod_tar_octal(header.uid, sizeof(header.uid), 0);
+	pod_tar_octal(header.gid, sizeof(header.gid), 0);
+	pod_tar_octal(header.size, sizeof(header.size), size);
+	pod_tar_octal(header.mtime, sizeof(header.mtime), mtime > 0 ? (uint64_t)mtime : 0);
+	header.type = type;
+	memcpy(header.magic, "ustar", 6);
+	memcpy(header.version, "00", 2);
+
+	/* the checksum is taken with its own field set to spaces */
+	memset(header.checksum, ' ', sizeof(header.checksum));
+	pod_number_t checksum = 0;
+	const unsigned char* bytes = (const unsigned char*)&header;
+	for(pod_size_t i = 0; i < sizeof(header); i++)
+		checksum += bytes[i];
+	snprintf(header.checksum, sizeof(header.checksum), "%06o", checksum);
+	header.checksum[7] = ' ';
+
+	return pod_tar_write(output, &header, sizeof(header));
+}
+
+/* @returns the length of the pax record "LEN path=NAME\n", LEN counting itself */
+static pod_size_t pod_tar_pax_size(pod_size_t name_size)
+{
+	pod_size_t body = sizeof(" path=\n") - 1 + name_size;
+	pod_size_t size = body + 1;
+	while(size != body + (pod_size_t)snprintf(NULL, 0, "%zu", size))
+		size = body + (pod_size_t)snprintf(NULL, 0, "%zu", size);
+	return size;
+}
+
+pod_bool_t pod_tar_entry_begin(pod_tar_entry_t* entry, FILE* output, const pod_char_t* name, pod_size_t size, pod_time_t mtime)
+{
+	if(entry == NULL || output == NULL || name == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_tar_entry_begin(entry == NULL || output == NULL || name == NULL)\n");
+		return false;
+	}
+
+	entry->output = output;
+	entry->name = name;
+	entry->size = size;
+	entry->written = 0;
+
+	pod_size_t len = strlen(name);
+	if(len <= POD_TAR_NAME_SIZE)
+		return pod_tar_header(output, '0', name, len, "", 0, size, mtime);
+
+	/* split at the first separator leaving a name short enough */
+	for(pod_size_t split = len - POD_TAR_NAME_SIZE - 1; split < len && split <= POD_TAR_PREFIX_SIZE; split++)
+	{
+		if(name[split] == '/' && split > 0 && split + 1 < len)
+			return pod_tar_header(output, '0', name + split + 1, len - split - 1, name, split, size, mtime);
+	}
+
+	/* pax extended header carrying the full path, the ustar name keeps its tail */
+	pod_size_t record = pod_tar_pax_size(len);
+	pod_char_t length[32];
+	snprintf(length, sizeof(length), "%zu", record);
+	const pod_char_t* tail = name + len - POD_TAR_NAME_SIZE;
+
+	return pod_tar_header(output, 'x', tail, POD_TAR_NAME_SIZE, "", 0, record, mtime) &&
+	       pod_tar_write(output, length, strlen(length)) &&
+	       pod_tar_write(output, " path=", 6) &&
+	       pod_tar_write(output, name, len) &&
+	       pod_tar_write(output, "\n", 1) &&
+	       pod_tar_pad(output, record) &&
+	       pod_tar_header(output, '0', tail, POD_TAR_NAME_SIZE, "", 0, size, mtime);
+}
+
+pod_bool_t pod_tar_sink(void* context, const pod_byte_t* data, pod_size_t size)
+{
+	pod_tar_entry_t* entry = context;
+	if(size > entry->size - entry->written)
+	{
+		fprintf(stderr, "ERROR: pod_tar_sink(%s) data exceeds the %zu bytes of its header!\n", entry->name, entry->size);
+		return false;
+	}
+	if(!pod_tar_write(entry->output, data, size))
+		return false;
+	entry->written += size;
+	return true;
+}
+
+pod_bool_t pod_tar_entry_end(pod_tar_entry_t* entry)
+{
+	pod_bool_t complete = entry->written == entry->size;
+	if(!complete)
+		fprintf(stderr, "ERROR: pod_tar_entry_end(%s) wrote %zu of %zu bytes, zero filled!\n", entry->name, entry->written, entry->size);
+
+	while(entry->written < entry->size)
+	{
+		pod_size_t chunk = entry->size - entry->written;
+		if(chunk > sizeof(pod_tar_zeros))
+			chunk = sizeof(pod_tar_zeros);
+		if(!pod_tar_write(entry->output, pod_tar_zeros, chunk))
+			return false;
+		entry->written += chunk;
+	}
+
+	return pod_tar_pad(entry->output, entry->size) && complete;
+}
+
+pod_bool_t pod_tar_close(FILE* output)
+{
+	if(!pod_tar_write(output, pod_tar_zeros, POD_TAR_BLOCK_SIZE) || !pod_tar_write(output, pod_tar_zeros, POD_TAR_BLOCK_SIZE))
+		return false;
+	if(fflush(output) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_tar_close() fflush failed: %s\n", strerror(errno));
+		return false;
+	}
+	return true;
+}
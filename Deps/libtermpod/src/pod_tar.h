@@ -0,0 +1,31 @@
+#ifndef _POD_TAR_H
+#define _POD_TAR_H
+
+#define POD_TAR_BLOCK_SIZE                   512                      /* tar record granularity         */
+#define POD_TAR_NAME_SIZE                    100                      /* ustar name field               */
+#define POD_TAR_PREFIX_SIZE                  155                      /* ustar prefix field             */
+
+/* POSIX tar (ustar) writer for streaming entries to a pipe; names that do  */
+/* not fit name and prefix get a pax path record. Entries are written in   */
+/* one pass, so the size in the header must be known before the data and   */
+/* output never needs to seek.                                             */
+typedef struct pod_tar_entry_s
+{
+	FILE* output;
+	const pod_char_t* name;
+	pod_size_t size;        /* bytes announced in the header */
+	pod_size_t written;
+} pod_tar_entry_t;
+
+/* write the header of a regular file name ('/' separated) of size bytes */
+pod_bool_t pod_tar_entry_begin(pod_tar_entry_t* entry, FILE* output, const pod_char_t* name, pod_size_t size, pod_time_t mtime);
+/* pod_sink_t for the data of a begun entry, refuses bytes beyond its size */
+pod_bool_t pod_tar_sink(void* context, const pod_byte_t* data, pod_size_t size);
+/* pad the entry to its size and the next block, the archive stays valid */
+/* even if the data came up short                                        */
+/* @returns true if exactly size bytes of data were written              */
+pod_bool_t pod_tar_entry_end(pod_tar_entry_t* entry);
+/* write the two zero blocks ending the archive and flush output */
+pod_bool_t pod_tar_close(FILE* output);
+
+#endif
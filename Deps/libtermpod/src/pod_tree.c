@@ -0,0 +1,264 @@
+#include "pod_common.h"
+
+typedef struct pod_tree_name_s
+{
+	const pod_char_t* name;
+	pod_number_t entry;
+} pod_tree_name_t;
+
+static inline pod_bool_t pod_tree_is_separator(pod_char_t c)
+{
+	return c == '\\' || c == '/';
+}
+
+/* @returns the next folded character of a name, runs of separators read */
+/* as one so "a\b" and "a//b" sort next to each other                   */
+static inline unsigned char pod_tree_next_char(const pod_char_t** name)
+{
+	const pod_char_t* p = *name;
+	if(pod_tree_is_separator(*p))
+	{
+		while(pod_tree_is_separator(p[1]))
+			p++;
+	}
+	*name = *p ? p + 1 : p;
+	return (unsigned char)pod_index_fold(*p);
+}
+
+static int pod_tree_name_compare(const void* a, const void* b)
+{
+	const pod_tree_name_t* x = a;
+	const pod_tree_name_t* y = b;
+	const pod_char_t* p = x->name;
+	const pod_char_t* q = y->name;
+	while(pod_tree_is_separator(*p))
+		p++;
+	while(pod_tree_is_separator(*q))
+		q++;
+
+	for(;;)
+	{
+		unsigned char c = pod_tree_next_char(&p);
+		unsigned char d = pod_tree_next_char(&q);
+		if(c != d)
+			return c < d ? -1 : 1;
+		if(c == '\0')
+			break;
+	}
+	return x->entry < y->entry ? -1 : x->entry > y->entry;
+}
+
+/* @returns true if the size bytes at a and b are equal once folded */
+static pod_bool_t pod_tree_name_equal(const pod_char_t* a, const pod_char_t* b, pod_number_t size)
+{
+	for(pod_number_t i = 0; i < size; i++)
+	{
+		if(pod_index_fold(a[i]) != pod_index_fold(b[i]))
+			return false;
+	}
+	return true;
+}
+
+/* @returns the next path component at or after *path and its size */
+static const pod_char_t* pod_tree_component(const pod_char_t** path, pod_number_t* size)
+{
+	const pod_char_t* p = *path;
+	while(pod_tree_is_separator(*p))
+		p++;
+
+	const pod_char_t* start = p;
+	while(*p && !pod_tree_is_separator(*p))
+		p++;
+
+	*size = (pod_number_t)(p - start);
+	*path = p;
+	return start;
+}
+
+static pod_bool_t pod_tree_grow(pod_tree_t* tree, pod_number_t* capacity)
+{
+	if(tree->count < *capacity)
+		return true;
+
+	pod_number_t grown = *capacity ? *capacity * 2 : 64;
+	pod_tree_node_t* nodes = realloc(tree->nodes, grown * sizeof(pod_tree_node_t));
+	if(nodes == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_tree_grow() could not allocate %u nodes!\n", grown);
+		return false;
+	}
+	tree->nodes = nodes;
+	*capacity = grown;
+	return true;
+}
+
+pod_tree_t* pod_tree_create(const pod_char_t* const* names, pod_number_t entries)
+{
+	pod_tree_t* tree = calloc(1, sizeof(pod_tree_t));
+	pod_tree_name_t* sorted = malloc((entries > 0 ? entries : 1) * sizeof(pod_tree_name_t));
+	if(tree == NULL || sorted == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_tree_create() could not allocate tree of %u entries!\n", entries);
+		free(tree);
+		free(sorted);
+		return NULL;
+	}
+
+	for(pod_number_t i = 0; i < entries; i++)
+	{
+		sorted[i].name = names[i] ? names[i] : "";
+		sorted[i].entry = i;
+	}
+	qsort(sorted, entries, sizeof(pod_tree_name_t), pod_tree_name_compare);
+
+	tree->entries = entries;
+	tree->order = malloc((entries > 0 ? entries : 1) * sizeof(pod_number_t));
+	pod_number_t capacity = 0;
+	pod_number_t last_capacity = 0;
+	pod_number_t* stack = NULL;
+	pod_number_t* last_child = NULL;
+	pod_number_t depth = 0;
+	pod_number_t stack_size = 0;
+
+	if(tree->order == NULL || !pod_tree_grow(tree, &capacity))
+		goto fail;
+
+	tree->nodes[POD_TREE_ROOT] = (pod_tree_node_t){ "", 0, POD_TREE_NONE, POD_TREE_NONE, POD_TREE_NONE, 0, entries, 0 };
+	tree->count = 1;
+
+	/* sorted names keep every directory contiguous, so one sweep with the */
+	/* current directory on a stack closes each node exactly once          */
+	for(pod_number_t k = 0; k < entries; k++)
+	{
+		const pod_char_t* path = sorted[k].name;
+		tree->order[k] = sorted[k].entry;
+
+		pod_number_t level = 0;
+		pod_number_t node = POD_TREE_ROOT;
+		for(;;)
+		{
+			pod_number_t size;
+			const pod_char_t* component = pod_tree_component(&path, &size);
+			const pod_char_t* rest = path;
+			pod_number_t rest_size;
+			pod_tree_component(&rest, &rest_size);
+			/* the last component is the file itself */
+			if(rest_size == 0)
+				break;
+
+			if(level < depth && tree->nodes[stack[level]].name_size == size &&
+			   pod_tree_name_equal(tree->nodes[stack[level]].name, component, size))
+			{
+				node = stack[level++];
+				continue;
+			}
+
+			/* leaving the directories below level */
+			while(depth > level)
+				tree->nodes[stack[--depth]].end = k;
+
+			if(!pod_tree_grow(tree, &capacity))
+				goto fail;
+			if(depth + 1 > stack_size)
+			{
+				stack_size = stack_size ? stack_size * 2 : 16;
+				pod_number_t* grown = realloc(stack, stack_size * sizeof(pod_number_t));
+				if(grown == NULL)
+					goto fail;
+				stack = grown;
+			}
+			if(last_capacity < capacity)
+			{
+				pod_number_t* grown = realloc(last_child, capacity * sizeof(pod_number_t));
+				if(grown == NULL)
+					goto fail;
+				if(last_capacity == 0)
+					grown[POD_TREE_ROOT] = POD_TREE_NONE;
+				last_child = grown;
+				last_capacity = capacity;
+			}
+
+			pod_number_t child = tree->count++;
+			tree->nodes[child] = (pod_tree_node_t){ component, size, node, POD_TREE_NONE, POD_TREE_NONE, k, entries, 0 };
+			last_child[child] = POD_TREE_NONE;
+			if(last_child[node] == POD_TREE_NONE)
+				tree->nodes[node].first_child = child;
+			else
+				tree->nodes[last_child[node]].next_sibling = child;
+			last_child[node] = child;
+
+			stack[depth++] = child;
+			node = child;
+			level++;
+		}
+
+		/* a file in a shallower directory also closes the deeper ones */
+		while(depth > level)
+			tree->nodes[stack[--depth]].end = k;
+		tree->nodes[node].files++;
+	}
+
+	while(depth > 0)
+		tree->nodes[stack[--depth]].end = entries;
+
+	free(stack);
+	free(last_child);
+	free(sorted);
+	return tree;
+
+fail:
+	fprintf(stderr, "ERROR: pod_tree_create() out of memory!\n");
+	free(stack);
+	free(last_child);
+	free(sorted);
+	return pod_tree_delete(tree);
+}
+
+pod_tree_t* pod_tree_delete(pod_tree_t* tree)
+{
+	if(tree == NULL)
+		return NULL;
+
+	free(tree->nodes);
+	free(tree->order);
+	free(tree);
+	return NULL;
+}
+
+pod_number_t pod_tree_find(pod_tree_t* tree, const pod_char_t* path)
+{
+	if(tree == NULL)
+		return POD_TREE_NONE;
+
+	pod_number_t node = POD_TREE_ROOT;
+	if(path == NULL)
+		return node;
+
+	for(;;)
+	{
+		pod_number_t size;
+		const pod_char_t* component = pod_tree_component(&path, &size);
+		if(size == 0)
+			return node;
+
+		pod_number_t child = tree->nodes[node].first_child;
+		while(child != POD_TREE_NONE &&
+		      (tree->nodes[child].name_size != size || !pod_tree_name_equal(tree->nodes[child].name, component, size)))
+			child = tree->nodes[child].next_sibling;
+
+		if(child == POD_TREE_NONE)
+			return POD_TREE_NONE;
+		node = child;
+	}
+}
+
+pod_number_t pod_tree_next_file(pod_tree_t* tree, pod_number_t node, pod_number_t pos, pod_number_t* child)
+{
+	while(*child != POD_TREE_NONE && pos >= tree->nodes[*child].begin)
+	{
+		if(pos < tree->nodes[*child].end)
+			pos = tree->nodes[*child].end;
+		*child = tree->nodes[*child].next_sibling;
+	}
+	return pos < tree->nodes[node].end ? pos : tree->nodes[node].end;
+}
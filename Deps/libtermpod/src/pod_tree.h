@@ -0,0 +1,42 @@
+#ifndef _POD_TREE_H
+#define _POD_TREE_H
+
+#define POD_TREE_NONE                        0xFFFFFFFF               /* no node                        */
+#define POD_TREE_ROOT                        0                        /* node of the archive root       */
+
+/* directory of an archive, files of the subtree are order[begin..end)      */
+/* and children are linked in name order so their ranges follow each other */
+typedef struct pod_tree_node_s
+{
+	const pod_char_t* name; /* component inside an entry name, not terminated */
+	pod_number_t name_size;
+	pod_number_t parent;
+	pod_number_t first_child;
+	pod_number_t next_sibling;
+	pod_number_t begin;
+	pod_number_t end;
+	pod_number_t files;     /* files directly inside this directory */
+} pod_tree_node_t;
+
+/* directory tree over entry names split at '\' and '/', compared folded    */
+/* like pod_index; every subtree is one contiguous run of order so walking */
+/* it costs its own size and not the size of the archive                   */
+typedef struct pod_tree_s
+{
+	pod_tree_node_t* nodes;
+	pod_number_t count;
+	pod_number_t* order;    /* entry indices sorted by folded name */
+	pod_number_t entries;
+} pod_tree_t;
+
+/* names must outlive the tree, nodes point into them */
+pod_tree_t* pod_tree_create(const pod_char_t* const* names, pod_number_t entries);
+pod_tree_t* pod_tree_delete(pod_tree_t* tree);
+/* @returns the node of directory path, the root for NULL or "" and */
+/* POD_TREE_NONE if there is no such directory                      */
+pod_number_t pod_tree_find(pod_tree_t* tree, const pod_char_t* path);
+/* @returns the position in order of the first file directly inside node at */
+/* or after pos, node->end if there is none, skipping subdirectories        */
+pod_number_t pod_tree_next_file(pod_tree_t* tree, pod_number_t node, pod_number_t pos, pod_number_t* child);
+
+#endif
@@ -0,0 +1,435 @@
+#include "pod_common.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#define POD_URING_FALLOCATE_SIZE 0x10000    /* smaller files are not preallocated */
+#define POD_URING_WRITE_SIZE     0x40000000 /* bytes per write request */
+#define POD_URING_CHAIN_SIZE     8          /* open, fallocate, 5 writes, close */
+#define POD_URING_BATCH_SIZE     32         /* queued requests submitted at once */
+
+static pod_bool_t pod_uring_enabled = false;
+
+void pod_uring_enable(pod_bool_t enable)
+{
+	pod_uring_enabled = enable;
+}
+
+pod_bool_t pod_uring_is_enabled()
+{
+	return pod_uring_enabled;
+}
+
+#if defined(__linux__) && defined(IORING_FEAT_LINKED_FILE)
+
+enum
+{
+	POD_URING_OPEN,
+	POD_URING_FALLOCATE,
+	POD_URING_WRITE,
+	POD_URING_CLOSE,
+	POD_URING_OPS
+};
+
+/* one file in flight, its chain owns registered file slot index */
+typedef struct pod_uring_slot_s
+{
+	pod_number_t pending;   /* requests without a completion yet */
+	pod_bool_t good;
+	pod_bool_t* ok;
+	pod_byte_t* owned;
+	pod_size_t size;
+	pod_size_t written;
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+} pod_uring_slot_t;
+
+struct pod_uring_s
+{
+	int fd;
+	pod_dest_t* dir;
+
+	void* sq_ring;
+	pod_size_t sq_ring_size;
+	void* cq_ring;
+	pod_size_t cq_ring_size;
+	struct io_uring_sqe* sqes;
+	pod_size_t sqes_size;
+	unsigned* sq_tail;
+	unsigned* sq_mask;
+	unsigned* sq_array;
+	unsigned* cq_head;
+	unsigned* cq_tail;
+	unsigned* cq_mask;
+	struct io_uring_cqe* cqes;
+	unsigned tail;          /* local sq tail, published on submit */
+	unsigned unsubmitted;
+
+	pod_uring_slot_t* slots;
+	pod_number_t* free_slots;
+	pod_number_t free_count;
+	pod_size_t inflight;    /* bytes of the files in flight */
+	pod_bool_t broken;      /* the ring failed, every later write fails */
+};
+
+static int pod_uring_setup(unsigned entries, struct io_uring_params* params)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int pod_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+	return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int pod_uring_register(int fd, unsigned opcode, const void* arg, unsigned args)
+{
+	return (int)syscall(__NR_io_uring_register, fd, opcode, arg, args);
+}
+
+pod_uring_t* pod_uring_create(pod_dest_t* dir)
+{
+	if(dir == NULL || dir->fd < 0)
+		return NULL;
+
+	pod_uring_t* ring = calloc(1, sizeof(pod_uring_t));
+	if(ring == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_uring_create() could not allocate ring!\n");
+		return NULL;
+	}
+	ring->fd = -1;
+	ring->dir = dir;
+
+	/* the writes of a chain use the slot its openat fills, so the file of */
+	/* a linked request must be looked up when it runs (5.18 and later)    */
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	ring->fd = pod_uring_setup(POD_URING_DEPTH * POD_URING_CHAIN_SIZE, &params);
+	if(ring->fd < 0 || !(params.features & IORING_FEAT_LINKED_FILE))
+		return pod_uring_delete(ring);
+
+	ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if(params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		if(ring->cq_ring_size > ring->sq_ring_size)
+			ring->sq_ring_size = ring->cq_ring_size;
+		ring->cq_ring_size = 0;
+	}
+
+	ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if(ring->sq_ring == MAP_FAILED)
+	{
+		ring->sq_ring = NULL;
+		return pod_uring_delete(ring);
+	}
+	ring->cq_ring = ring->sq_ring;
+	if(ring->cq_ring_size > 0)
+	{
+		ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if(ring->cq_ring == MAP_FAILED)
+		{
+			ring->cq_ring = NULL;
+			return pod_uring_delete(ring);
+		}
+	}
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if(ring->sqes == MAP_FAILED)
+	{
+		ring->sqes = NULL;
+		return pod_uring_delete(ring);
+	}
+
+	pod_byte_t* sq = ring->sq_ring;
+	pod_byte_t* cq = ring->cq_ring;
+	ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+	ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+	ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+	ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+	ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+	ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+	ring->tail = *ring->sq_tail;
+
+	/* every slot starts empty, openat fills it and close empties it again */
+	int files[POD_URING_DEPTH];
+	for(pod_number_t i = 0; i < POD_URING_DEPTH; i++)
+		files[i] = -1;
+	if(pod_uring_register(ring->fd, IORING_REGISTER_FILES, files, POD_URING_DEPTH) < 0)
+		return pod_uring_delete(ring);
+
+	ring->slots = calloc(POD_URING_DEPTH, sizeof(pod_uring_slot_t));
+	ring->free_slots = malloc(POD_URING_DEPTH * sizeof(pod_number_t));
+	if(ring->slots == NULL || ring->free_slots == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_uring_create() could not allocate slots!\n");
+		return pod_uring_delete(ring);
+	}
+	for(pod_number_t i = 0; i < POD_URING_DEPTH; i++)
+		ring->free_slots[i] = POD_URING_DEPTH - 1 - i;
+	ring->free_count = POD_URING_DEPTH;
+
+	return ring;
+}
+
+/* hand the queued requests to the kernel and wait for min_complete */
+static pod_bool_t pod_uring_submit(pod_uring_t* ring, unsigned min_complete)
+{
+	__atomic_store_n(ring->sq_tail, ring->tail, __ATOMIC_RELEASE);
+
+	unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+	int submitted;
+	do
+		submitted = pod_uring_enter(ring->fd, ring->unsubmitted, min_complete, flags);
+	while(submitted < 0 && errno == EINTR);
+
+	if(submitted < 0)
+	{
+		/* completions are backed up, the next reap makes room */
+		if(errno == EAGAIN || errno == EBUSY)
+			return true;
+		fprintf(stderr, "ERROR: io_uring_enter() failed: %s\n", strerror(errno));
+		ring->broken = true;
+		return false;
+	}
+	ring->unsubmitted -= (unsigned)submitted;
+	return true;
+}
+
+static void pod_uring_complete(pod_uring_t* ring, struct io_uring_cqe* cqe)
+{
+	pod_number_t index = (pod_number_t)(cqe->user_data / POD_URING_OPS);
+	pod_number_t op = (pod_number_t)(cqe->user_data % POD_URING_OPS);
+	pod_uring_slot_t* slot = &ring->slots[index];
+	int res = cqe->res;
+
+	/* requests after a failed openat are cancelled, it already reported */
+	if(res == -ECANCELED)
+		slot->good = false;
+	else if(op == POD_URING_OPEN && res < 0)
+	{
+		fprintf(stderr, "ERROR: openat(%s/%s) failed: %s\n", ring->dir->path, slot->path, strerror(-res));
+		slot->good = false;
+	}
+	else if(op == POD_URING_WRITE && res < 0)
+	{
+		fprintf(stderr, "ERROR: write(%s/%s) failed: %s\n", ring->dir->path, slot->path, strerror(-res));
+		slot->good = false;
+	}
+	else if(op == POD_URING_WRITE)
+		slot->written += (pod_size_t)res;
+	else if(op == POD_URING_CLOSE && res < 0)
+	{
+		fprintf(stderr, "ERROR: close(%s/%s) failed: %s\n", ring->dir->path, slot->path, strerror(-res));
+		slot->good = false;
+	}
+	/* fallocate is only a hint, file systems without it still get the write */
+
+	if(--slot->pending > 0)
+		return;
+
+	if(slot->good && slot->written != slot->size)
+	{
+		fprintf(stderr, "ERROR: write(%s/%s) wrote %zu of %zu bytes!\n", ring->dir->path, slot->path, slot->written, slot->size);
+		slot->good = false;
+	}
+	*slot->ok = slot->good;
+	free(slot->owned);
+	ring->inflight -= slot->size;
+	ring->free_slots[ring->free_count++] = index;
+}
+
+static void pod_uring_reap(pod_uring_t* ring)
+{
+	unsigned head = *ring->cq_head;
+	unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+	for(; head != tail; head++)
+		pod_uring_complete(ring, &ring->cqes[head & *ring->cq_mask]);
+	__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+static struct io_uring_sqe* pod_uring_sqe(pod_uring_t* ring, pod_number_t index, pod_number_t op, pod_byte_t opcode, unsigned flags)
+{
+	unsigned position = ring->tail & *ring->sq_mask;
+	struct io_uring_sqe* sqe = &ring->sqes[position];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = opcode;
+	sqe->flags = (pod_byte_t)flags;
+	sqe->user_data = (uint64_t)index * POD_URING_OPS + op;
+	ring->sq_array[position] = position;
+	ring->tail++;
+	ring->unsubmitted++;
+	ring->slots[index].pending++;
+	return sqe;
+}
+
+pod_bool_t pod_uring_write(pod_uring_t* ring, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_byte_t* owned, pod_bool_t* ok)
+{
+	if(ring == NULL || name == NULL || ok == NULL || (data == NULL && size > 0))
+	{
+		fprintf(stderr, "ERROR: pod_uring_write(ring == NULL || name == NULL || ok == NULL || data == NULL)\n");
+		free(owned);
+		return false;
+	}
+	if(size > (pod_size_t)POD_URING_WRITE_SIZE * (POD_URING_CHAIN_SIZE - 3))
+	{
+		fprintf(stderr, "ERROR: pod_uring_write(%s) %zu bytes are too many for one chain!\n", name, size);
+		free(owned);
+		return false;
+	}
+
+	*ok = false;
+	pod_char_t path[POD_SYSTEM_PATH_SIZE];
+	if(!pod_dest_prepare(ring->dir, name, path, sizeof(path)))
+	{
+		free(owned);
+		return false;
+	}
+
+	/* wait for a free slot and room in the byte budget, a single file */
+	/* larger than the budget goes alone                                */
+	while(!ring->broken && (ring->free_count == 0 || (ring->inflight > 0 && ring->inflight + size > POD_URING_INFLIGHT_SIZE)))
+	{
+		if(pod_uring_submit(ring, 1))
+			pod_uring_reap(ring);
+	}
+
+	if(ring->broken)
+	{
+		free(owned);
+		return false;
+	}
+
+	pod_number_t index = ring->free_slots[--ring->free_count];
+	pod_uring_slot_t* slot = &ring->slots[index];
+	strcpy(slot->path, path);
+	slot->pending = 0;
+	slot->good = true;
+	slot->ok = ok;
+	slot->owned = owned;
+	slot->size = size;
+	slot->written = 0;
+	ring->inflight += size;
+
+	/* open links to the rest so a failed open cancels the chain, the */
+	/* others are hard links so close still runs after a failed write */
+	struct io_uring_sqe* sqe = pod_uring_sqe(ring, index, POD_URING_OPEN, IORING_OP_OPENAT, IOSQE_IO_LINK);
+	sqe->fd = ring->dir->fd;
+	sqe->addr = (uint64_t)(uintptr_t)slot->path;
+	sqe->len = 0666;
+	sqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC;
+	sqe->file_index = index + 1;
+
+	if(size >= POD_URING_FALLOCATE_SIZE)
+	{
+		sqe = pod_uring_sqe(ring, index, POD_URING_FALLOCATE, IORING_OP_FALLOCATE, IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK);
+		sqe->fd = (int)index;
+		sqe->off = 0;
+		sqe->addr = size;
+		sqe->len = 0;
+	}
+
+	for(pod_size_t offset = 0; offset < size; offset += POD_URING_WRITE_SIZE)
+	{
+		pod_size_t chunk = size - offset < POD_URING_WRITE_SIZE ? size - offset : POD_URING_WRITE_SIZE;
+		sqe = pod_uring_sqe(ring, index, POD_URING_WRITE, IORING_OP_WRITE, IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK);
+		sqe->fd = (int)index;
+		sqe->off = offset;
+		sqe->addr = (uint64_t)(uintptr_t)(data + offset);
+		sqe->len = (unsigned)chunk;
+	}
+
+	sqe = pod_uring_sqe(ring, index, POD_URING_CLOSE, IORING_OP_CLOSE, 0);
+	sqe->file_index = index + 1;
+
+	if(ring->unsubmitted >= POD_URING_BATCH_SIZE)
+		pod_uring_submit(ring, 0);
+	pod_uring_reap(ring);
+	return true;
+}
+
+pod_bool_t pod_uring_wait(pod_uring_t* ring)
+{
+	if(ring == NULL)
+		return false;
+
+	while(!ring->broken && ring->free_count < POD_URING_DEPTH)
+	{
+		if(pod_uring_submit(ring, 1))
+			pod_uring_reap(ring);
+	}
+	return !ring->broken;
+}
+
+pod_uring_t* pod_uring_delete(pod_uring_t* ring)
+{
+	if(ring == NULL)
+		return NULL;
+
+	if(ring->slots != NULL)
+		pod_uring_wait(ring);
+
+	if(ring->sqes != NULL)
+		munmap(ring->sqes, ring->sqes_size);
+	if(ring->cq_ring != NULL && ring->cq_ring != ring->sq_ring)
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	if(ring->sq_ring != NULL)
+		munmap(ring->sq_ring, ring->sq_ring_size);
+	if(ring->fd >= 0)
+		close(ring->fd);
+
+	/* a broken ring still owns the buffers of its lost requests */
+	if(ring->slots != NULL && ring->free_count < POD_URING_DEPTH)
+	{
+		for(pod_number_t i = 0; i < POD_URING_DEPTH; i++)
+		{
+			if(ring->slots[i].pending > 0)
+				free(ring->slots[i].owned);
+		}
+	}
+
+	free(ring->slots);
+	free(ring->free_slots);
+	free(ring);
+	return NULL;
+}
+
+#else
+
+struct pod_uring_s
+{
+	pod_dest_t* dir;
+};
+
+pod_uring_t* pod_uring_create(pod_dest_t* dir)
+{
+	(void)dir;
+	return NULL;
+}
+
+pod_uring_t* pod_uring_delete(pod_uring_t* ring)
+{
+	free(ring);
+	return NULL;
+}
+
+pod_bool_t pod_uring_write(pod_uring_t* ring, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_byte_t* owned, pod_bool_t* ok)
+{
+	(void)ring;
+	(void)name;
+	(void)data;
+	(void)size;
+	(void)ok;
+	free(owned);
+	return false;
+}
+
+pod_bool_t pod_uring_wait(pod_uring_t* ring)
+{
+	return ring != NULL;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef _POD_URING_H
+#define _POD_URING_H
+
+#define POD_URING_DEPTH                      64                       /* files written at the same time */
+#define POD_URING_INFLIGHT_SIZE              0x4000000                /* bytes held by queued writes    */
+
+/* write-behind for extraction through io_uring, Linux only and opaque so  */
+/* only pod_uring.c sees the kernel headers. Every file is one linked      */
+/* chain openat -> fallocate -> write -> close into a registered file slot, */
+/* chains are queued and handed to the kernel in batches while the caller  */
+/* goes on decoding; at most POD_URING_DEPTH files and                     */
+/* POD_URING_INFLIGHT_SIZE bytes are in flight, further writes wait for    */
+/* completions. Requests belong to the thread that submitted them and die  */
+/* with it, so a ring must only be used by the thread that created it.     */
+typedef struct pod_uring_s pod_uring_t;
+
+/* extraction uses io_uring only when enabled and available */
+void pod_uring_enable(pod_bool_t enable);
+pod_bool_t pod_uring_is_enabled();
+
+/* @returns NULL if io_uring is unavailable here, callers then write */
+/* through the thread pool as before                                 */
+pod_uring_t* pod_uring_create(pod_dest_t* dir);
+/* wait for all queued writes, then release the ring */
+pod_uring_t* pod_uring_delete(pod_uring_t* ring);
+/* queue writing size bytes of data to entry name below dir, creating its   */
+/* parents now; data must stay valid until the write completes, owned is    */
+/* freed then (it may be NULL or data itself). *ok is set once the file is  */
+/* closed, so it must only be read after pod_uring_wait()                   */
+/* @returns false if the write could not be queued, owned is freed then     */
+pod_bool_t pod_uring_write(pod_uring_t* ring, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_byte_t* owned, pod_bool_t* ok);
+/* submit everything queued and wait until all of it completed */
+pod_bool_t pod_uring_wait(pod_uring_t* ring);
+
+#endif
@@ -0,0 +1,345 @@
+#include "libtermpod.h"
+
+/* header fields of every streamed format, only the on-disk size is written */
+typedef union pod_writer_header_u
+{
+	pod_header_pod3_t pod3;
+	pod_header_pod4_t pod4;
+	pod_header_pod5_t pod5;
+	pod_header_pod6_t pod6;
+} pod_writer_header_t;
+
+static pod_size_t pod_writer_header_size(pod_ident_type_t type)
+{
+	switch(type)
+	{
+		case POD3:
+			return POD_HEADER_POD3_SIZE;
+		case POD4:
+			return POD_HEADER_POD4_SIZE;
+		case POD5:
+			return POD_HEADER_POD5_SIZE;
+		case POD6:
+			return POD_HEADER_POD6_SIZE;
+		default:
+			return 0;
+	}
+}
+
+static pod_bool_t pod_writer_write(pod_writer_t* writer, const void* data, pod_size_t size)
+{
+	if(size > 0 && fwrite(data, 1, size, writer->output) != size)
+	{
+		fprintf(stderr, "ERROR: pod_writer_write(%s) could not write %zu bytes: %s\n", writer->name, size, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+pod_bool_t pod_writer_supports(pod_ident_type_t type)
+{
+	return pod_writer_header_size(type) > 0;
+}
+
+pod_writer_t* pod_writer_create(pod_path_t name, pod_ident_type_t type)
+{
+	if(name == NULL || !pod_writer_supports(type))
+	{
+		fprintf(stderr, "ERROR: pod_writer_create() needs a name and a POD3 to POD6 type!\n");
+		return NULL;
+	}
+
+	pod_writer_t* writer = calloc(1, sizeof(pod_writer_t));
+	if(writer == NULL || (writer->name = strdup(name)) == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_writer_create(%s) could not allocate writer!\n", name);
+		free(writer);
+		return NULL;
+	}
+
+	writer->type = type;
+	writer->output = fopen(name, "wb");
+	if(writer->output == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_writer_create(%s) could not open output: %s\n", name, strerror(errno));
+		writer->finished = true;
+		return pod_writer_delete(writer);
+	}
+	setvbuf(writer->output, NULL, _IOFBF, POD_WRITER_BUFFER_SIZE);
+
+	/* zeroed until pod_writer_finish() knows count and index offset. The */
+	/* POD3 and POD4 header structs run past the on-disk header and open  */
+	/* patches those fields in place, so entry data starts behind them    */
+	pod_writer_header_t header;
+	memset(&header, 0, sizeof(header));
+	writer->size = pod_writer_header_size(type);
+	if(type == POD3 || type == POD4)
+		writer->size = sizeof(pod_header_pod4_t);
+	if(!pod_writer_write(writer, &header, writer->size))
+		return pod_writer_delete(writer);
+
+	return writer;
+}
+
+pod_writer_t* pod_writer_delete(pod_writer_t* writer)
+{
+	if(writer == NULL)
+		return NULL;
+
+	if(writer->output != NULL)
+		fclose(writer->output);
+	if(!writer->finished)
+		remove(writer->name);
+
+	pod_writer_directory_free(&writer->directory);
+	free(writer->name);
+	free(writer);
+	return NULL;
+}
+
+pod_bool_t pod_writer_grow(void** buffer, pod_size_t* capacity, pod_size_t needed, pod_size_t initial)
+{
+	if(needed <= *capacity)
+		return true;
+
+	pod_size_t size = *capacity ? *capacity : initial;
+	while(size < needed)
+		size <<= 1;
+
+	void* grown = realloc(*buffer, size);
+	if(grown == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_writer_grow() could not grow buffer to %zu bytes!\n", size);
+		return false;
+	}
+	*buffer = grown;
+	*capacity = size;
+	return true;
+}
+
+pod_writer_entry_t* pod_writer_directory_append(pod_writer_directory_t* directory, const pod_char_t* name, pod_size_t data_size, pod_size_t size)
+{
+	/* offsets and sizes are 32 bit in every format */
+	pod_size_t len = strlen(name) + 1;
+	if(data_size + size > (pod_number_t)-1 || directory->path_data_size + len > (pod_number_t)-1)
+	{
+		fprintf(stderr, "ERROR: pod_writer_directory_append(%s) archive would exceed 4GB!\n", name);
+		return NULL;
+	}
+
+	if(directory->count == directory->capacity)
+	{
+		pod_number_t capacity = directory->capacity ? directory->capacity * 2 : 1024;
+		pod_writer_entry_t* grown = realloc(directory->entries, capacity * sizeof(pod_writer_entry_t));
+		if(grown == NULL)
+		{
+			fprintf(stderr, "ERROR: pod_writer_directory_append() could not allocate %u entries!\n", capacity);
+			return NULL;
+		}
+		directory->entries = grown;
+		directory->capacity = capacity;
+	}
+
+	if(!pod_writer_grow((void**)&directory->path_data, &directory->path_capacity, directory->path_data_size + len, 0x10000))
+		return NULL;
+
+	pod_writer_entry_t* entry = &directory->entries[directory->count];
+	memset(entry, 0, sizeof(pod_writer_entry_t));
+	entry->path_offset = (pod_number_t)directory->path_data_size;
+	entry->source = directory->count;
+
+	memcpy(directory->path_data + directory->path_data_size, name, len);
+	directory->path_data_size += len;
+	directory->count++;
+	return entry;
+}
+
+pod_bool_t pod_writer_directory_link(pod_writer_directory_t* directory, const pod_char_t* name, pod_number_t source, pod_time_t mtime)
+{
+	if(source >= directory->count)
+	{
+		fprintf(stderr, "ERROR: pod_writer_directory_link(%s) source %u >= count %u\n", name, source, directory->count);
+		return false;
+	}
+
+	pod_writer_entry_t* entry = pod_writer_directory_append(directory, name, 0, 0);
+	if(entry == NULL)
+		return false;
+
+	/* entries may move when the directory grows, copy by index */
+	pod_number_t path_offset = entry->path_offset;
+	*entry = directory->entries[source];
+	entry->path_offset = path_offset;
+	entry->timestamp = mtime > 0 ? (pod_number_t)mtime : 0;
+	return true;
+}
+
+void pod_writer_directory_free(pod_writer_directory_t* directory)
+{
+	free(directory->entries);
+	free(directory->path_data);
+	memset(directory, 0, sizeof(pod_writer_directory_t));
+}
+
+/* @returns false if no more entries may be added to writer */
+static pod_bool_t pod_writer_writable(pod_writer_t* writer, const pod_char_t* name)
+{
+	if(writer->output == NULL || writer->finished)
+	{
+		fprintf(stderr, "ERROR: pod_writer_writable(%s) archive %s is already finished!\n", name, writer->name);
+		return false;
+	}
+	return true;
+}
+
+pod_bool_t pod_writer_add(pod_writer_t* writer, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_size_t uncompressed, pod_number_t level, pod_time_t mtime)
+{
+	if(writer == NULL || name == NULL || (data == NULL && size > 0))
+	{
+		fprintf(stderr, "ERROR: pod_writer_add(writer == NULL || name == NULL || data == NULL)\n");
+		return false;
+	}
+	if(uncompressed > (pod_number_t)-1)
+	{
+		fprintf(stderr, "ERROR: pod_writer_add(%s) entry exceeds 4GB!\n", name);
+		return false;
+	}
+
+	if(!pod_writer_writable(writer, name))
+		return false;
+
+	pod_number_t offset = (pod_number_t)writer->size;
+	pod_writer_entry_t* entry = pod_writer_directory_append(&writer->directory, name, writer->size, size);
+	if(entry == NULL)
+		return false;
+	if(!pod_writer_write(writer, data, size))
+		return false;
+
+	entry->size = (pod_number_t)size;
+	entry->offset = offset;
+	entry->uncompressed = (pod_number_t)uncompressed;
+	entry->level = level;
+	entry->timestamp = mtime > 0 ? (pod_number_t)mtime : 0;
+	entry->checksum = size > 0 ? pod_crc((pod_byte_t*)data, size) : 0;
+	writer->size += size;
+	return true;
+}
+
+pod_bool_t pod_writer_link(pod_writer_t* writer, const pod_char_t* name, pod_number_t source, pod_time_t mtime)
+{
+	if(writer == NULL || name == NULL)
+	{
+		fprintf(stderr, "ERROR: pod_writer_link(writer == NULL || name == NULL)\n");
+		return false;
+	}
+
+	return pod_writer_writable(writer, name) && pod_writer_directory_link(&writer->directory, name, source, mtime);
+}
+
+/* serialise the directory record of entry in the layout of type */
+static pod_bool_t pod_writer_entry(pod_writer_t* writer, const pod_writer_entry_t* entry)
+{
+	switch(writer->type)
+	{
+		case POD3:
+		{
+			pod_entry_pod3_t record = { entry->path_offset, entry->size, entry->offset, entry->timestamp, entry->checksum };
+			return pod_writer_write(writer, &record, POD_DIR_ENTRY_POD3_SIZE);
+		}
+		case POD4:
+		{
+			pod_entry_pod4_t record = { entry->path_offset, entry->size, entry->offset, entry->uncompressed, entry->level, entry->timestamp, entry->checksum };
+			return pod_writer_write(writer, &record, POD_DIR_ENTRY_POD4_SIZE);
+		}
+		case POD5:
+		{
+			pod_entry_pod5_t record = { entry->path_offset, entry->size, entry->offset, entry->uncompressed, entry->level, entry->timestamp, entry->checksum };
+			return pod_writer_write(writer, &record, POD_DIR_ENTRY_POD5_SIZE);
+		}
+		case POD6:
+		{
+			pod_entry_pod6_t record = { entry->path_offset, entry->size, entry->offset, entry->uncompressed, entry->level, 0 };
+			return pod_writer_write(writer, &record, POD_DIR_ENTRY_POD6_SIZE);
+		}
+		default:
+			return false;
+	}
+}
+
+pod_bool_t pod_writer_finish(pod_writer_t* writer, const pod_char_t* next_archive)
+{
+	if(writer == NULL || writer->output == NULL || writer->finished)
+	{
+		fprintf(stderr, "ERROR: pod_writer_finish() archive is not open!\n");
+		return false;
+	}
+	if(next_archive != NULL && strlen(next_archive) >= POD_HEADER_NEXT_ARCHIVE_SIZE)
+	{
+		fprintf(stderr, "ERROR: pod_writer_finish(%s) next archive name %s is too long!\n", writer->name, next_archive);
+		return false;
+	}
+
+	pod_number_t index_offset = (pod_number_t)writer->size;
+	for(pod_number_t i = 0; i < writer->directory.count; i++)
+	{
+		if(!pod_writer_entry(writer, &writer->directory.entries[i]))
+			return false;
+	}
+	if(!pod_writer_write(writer, writer->directory.path_data, writer->directory.path_data_size))
+		return false;
+
+	pod_writer_header_t header;
+	memset(&header, 0, sizeof(header));
+	switch(writer->type)
+	{
+		case POD3:
+		case POD4:
+			/* POD3 and POD4 headers share their layout */
+			memcpy(header.pod4.ident, writer->type == POD3 ? "POD3" : "POD4", POD_IDENT_SIZE);
+			header.pod4.file_count = writer->directory.count;
+			header.pod4.index_offset = index_offset;
+			header.pod4.pad10c = 0x10c;
+			header.pod4.size_index = (pod_number_t)writer->directory.path_data_size;
+			header.pod4.pad11c = 0xFFFFFFFF;
+			break;
+		case POD5:
+			memcpy(header.pod5.ident, "POD5", POD_IDENT_SIZE);
+			header.pod5.file_count = writer->directory.count;
+			header.pod5.index_offset = index_offset;
+			header.pod5.unknown10c = 0x10c;
+			header.pod5.size_index = (pod_number_t)writer->directory.path_data_size;
+			header.pod5.pad11c = 0xFFFFFFFF;
+			if(next_archive != NULL)
+				strcpy(header.pod5.next_archive, next_archive);
+			break;
+		case POD6:
+			memcpy(header.pod6.ident, "POD6", POD_IDENT_SIZE);
+			header.pod6.file_count = writer->directory.count;
+			header.pod6.index_offset = index_offset;
+			header.pod6.size_index = (pod_number_t)writer->directory.path_data_size;
+			if(next_archive != NULL)
+				strcpy(header.pod6.next_archive, next_archive);
+			break;
+		default:
+			return false;
+	}
+
+	if(fseek(writer->output, 0, SEEK_SET) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_writer_finish(%s) could not seek to the header: %s\n", writer->name, strerror(errno));
+		return false;
+	}
+	if(!pod_writer_write(writer, &header, pod_writer_header_size(writer->type)))
+		return false;
+
+	FILE* output = writer->output;
+	writer->output = NULL;
+	if(fclose(output) != 0)
+	{
+		fprintf(stderr, "ERROR: pod_writer_finish(%s) fclose failed: %s\n", writer->name, strerror(errno));
+		return false;
+	}
+
+	writer->finished = true;
+	return true;
+}
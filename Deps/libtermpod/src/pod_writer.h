@@ -0,0 +1,74 @@
+#ifndef _POD_WRITER_H
+#define _POD_WRITER_H
+
+#define POD_WRITER_BUFFER_SIZE               0x100000                 /* stdio buffer of the output     */
+
+/* directory record kept until the archive is finished, the fields of */
+/* every format that stores its directory behind the entry data       */
+typedef struct pod_writer_entry_s
+{
+	pod_number_t path_offset; /* into the path table */
+	pod_number_t size;        /* stored bytes */
+	pod_number_t offset;      /* of the stored bytes in the archive */
+	pod_number_t uncompressed;
+	pod_number_t level;       /* compression level, 0 if stored */
+	pod_number_t timestamp;
+	pod_number_t checksum;    /* of the stored bytes */
+	pod_number_t source;      /* entry whose stored bytes these are, itself unless linked */
+} pod_writer_entry_t;
+
+/* directory records and the path table they point into, both grow by */
+/* doubling; shared by pod_writer_t and pod_builder_t                 */
+typedef struct pod_writer_directory_s
+{
+	pod_writer_entry_t* entries;
+	pod_number_t count;
+	pod_number_t capacity;
+	pod_char_t* path_data;
+	pod_size_t path_data_size;
+	pod_size_t path_capacity;
+} pod_writer_directory_t;
+
+/* archive written front to back while entries are added. The header is  */
+/* reserved, entry data goes straight to the output and only directory   */
+/* and path table stay in memory until pod_writer_finish() appends them  */
+/* and patches the header. Holds for POD3 to POD6, which locate their    */
+/* directory through index_offset; the other formats keep it in front of */
+/* the data and are built in memory.                                     */
+typedef struct pod_writer_s
+{
+	pod_ident_type_t type;
+	pod_string_t name;
+	FILE* output;
+	pod_writer_directory_t directory;
+	pod_size_t size;          /* bytes written so far */
+	pod_bool_t finished;
+} pod_writer_t;
+
+/* grow buffer of *capacity bytes by doubling, from initial, until needed bytes fit */
+pod_bool_t pod_writer_grow(void** buffer, pod_size_t* capacity, pod_size_t needed, pod_size_t initial);
+/* @returns a new record for name with its name in the path table, NULL if */
+/* size more bytes behind data_size would take the archive past 4GB         */
+pod_writer_entry_t* pod_writer_directory_append(pod_writer_directory_t* directory, const pod_char_t* name, pod_size_t data_size, pod_size_t size);
+/* add record name sharing the stored bytes of record source */
+pod_bool_t pod_writer_directory_link(pod_writer_directory_t* directory, const pod_char_t* name, pod_number_t source, pod_time_t mtime);
+/* free records and path table */
+void pod_writer_directory_free(pod_writer_directory_t* directory);
+
+/* @returns true if archives of type can be streamed */
+pod_bool_t pod_writer_supports(pod_ident_type_t type);
+/* create name and reserve the header of type */
+pod_writer_t* pod_writer_create(pod_path_t name, pod_ident_type_t type);
+/* closes and removes the output if the archive was not finished */
+pod_writer_t* pod_writer_delete(pod_writer_t* writer);
+/* append size stored bytes of data as entry name, compressed by level */
+/* from uncompressed bytes or stored as is with level 0                */
+pod_bool_t pod_writer_add(pod_writer_t* writer, const pod_char_t* name, const pod_byte_t* data, pod_size_t size, pod_size_t uncompressed, pod_number_t level, pod_time_t mtime);
+/* add entry name sharing the stored bytes of entry source instead of */
+/* writing the same data again                                        */
+pod_bool_t pod_writer_link(pod_writer_t* writer, const pod_char_t* name, pod_number_t source, pod_time_t mtime);
+/* append directory and path table and patch the header; next_archive */
+/* chains POD5 and POD6 volumes and may be NULL                       */
+pod_bool_t pod_writer_finish(pod_writer_t* writer, const pod_char_t* next_archive);
+
+#endif
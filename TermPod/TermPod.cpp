@@ -7,6 +7,10 @@
 
 #include <sstream>
 #include <iomanip>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
 
 extern "C" {
 #include <libtermpod.h>
@@ -19,7 +23,7 @@ std::string to_format(const pod_ssize_t number) {
 }
 
 void printHelp() {
-	fprintf(stderr, "Usage: %s [-h] [-l | -x | -c | -p] file [dir]\n\n", "TermPod");
+	fprintf(stderr, "Usage: %s [-h] [-i] [-j N] [--uring] [--sync] [--prune] [--dedup] [--policy FILE] [--tar FILE] [--inflate NAME] [-l | -x | -c | -p | --bench-inflate | --bench-open] file [dir]\n\n", "TermPod");
 	fprintf(stderr, "Pack/Unpack Terminal Reality POD and EPD archive files\n\n");
 	fprintf(stderr, "positional arguments:\n");
 	fprintf(stderr, "  file        input/output POD/EPD file\n");
@@ -29,8 +33,25 @@ void printHelp() {
 	fprintf(stderr, "-l, --list                        list files in POD/EPD archive\n");
 	fprintf(stderr, "-x, --extract                     extract files from POD/EPD archive\n");
 	fprintf(stderr, "-c, --create                      create POD/EPD archive\n");
+	fprintf(stderr, "-i, --index                       keep a .podidx index next to the archive for faster reopens\n");
 	fprintf(stderr, "-p PATTERN, --pattern PATTERN\n");
-	fprintf(stderr, "                                  list/extract only the files matching specified pattern\n");
+	fprintf(stderr, "                                  list/extract only the files matching specified pattern, may be repeated\n");
+	fprintf(stderr, "                                  substring, glob (*, **, ?, [...]) or re:REGEX, prefix with ! to exclude\n");
+	fprintf(stderr, "--pattern-file FILE               read one pattern per line from FILE\n");
+	fprintf(stderr, "-s DIR, --subtree DIR             list the directory DIR or extract only the files below it\n");
+	fprintf(stderr, "-j N, --jobs N                    extract, scan or compress with N worker threads, 0 uses every processor\n");
+	fprintf(stderr, "--uring                           extract with io_uring write-behind where the kernel has it\n");
+	fprintf(stderr, "--sync                            only rewrite extracted files that differ from the archive\n");
+	fprintf(stderr, "--prune                           with --sync, also remove files below dir the archive lacks\n");
+	fprintf(stderr, "--dedup                           with -c, store files of equal content once\n");
+	fprintf(stderr, "--policy FILE                     with -c, per-extension compression rules, one \"ext level|store|auto\" per line\n");
+	fprintf(stderr, "--tar FILE                        extract into a POSIX tar archive FILE instead of dir, - is stdout\n");
+	fprintf(stderr, "--inflate NAME                    decompress with backend NAME, one of");
+	for (pod_number_t i = 0; i < pod_codec_backend_count(); i++)
+		fprintf(stderr, " %s", pod_codec_backend_get(i)->name);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "--bench-inflate                   time every decompression backend on the archive\n");
+	fprintf(stderr, "--bench-open                      time opening the archive in every open mode, with -i from the index\n");
 }
 
 // make a argument parser function
@@ -39,7 +60,22 @@ struct Arguments {
 	bool list;
 	bool extract;
 	bool create;
+	bool index;
 	std::string pattern;
+	std::vector<std::string> patterns;
+	std::vector<std::string> pattern_files;
+	std::string subtree;
+	bool has_subtree;
+	int jobs;
+	bool uring;
+	bool sync;
+	bool prune;
+	bool dedup;
+	std::string policy;
+	std::string tar;
+	std::string inflate;
+	bool bench_inflate;
+	bool bench_open;
 	std::string file;
 	std::string dir;
 };
@@ -50,7 +86,20 @@ Arguments parseArguments(int argc, char* argv[]) {
 	args.list = false;
 	args.extract = false;
 	args.create = false;
+	args.index = false;
 	args.pattern = "";
+	args.subtree = "";
+	args.has_subtree = false;
+	args.jobs = -1;
+	args.uring = false;
+	args.sync = false;
+	args.prune = false;
+	args.dedup = false;
+	args.policy = "";
+	args.tar = "";
+	args.inflate = "";
+	args.bench_inflate = false;
+	args.bench_open = false;
 	args.file = "";
 	args.dir = "";
 
@@ -68,9 +117,68 @@ Arguments parseArguments(int argc, char* argv[]) {
 		else if (arg == "-c" || arg == "--create") {
 			args.create = true;
 		}
+		else if (arg == "-i" || arg == "--index") {
+			args.index = true;
+		}
 		else if (arg == "-p" || arg == "--pattern") {
 			if (i + 1 < argc) {
 				args.pattern = argv[i + 1];
+				args.patterns.push_back(args.pattern);
+				i++;
+			}
+		}
+		else if (arg == "-s" || arg == "--subtree") {
+			if (i + 1 < argc) {
+				args.subtree = argv[i + 1];
+				args.has_subtree = true;
+				i++;
+			}
+		}
+		else if (arg == "-j" || arg == "--jobs") {
+			if (i + 1 < argc) {
+				args.jobs = atoi(argv[i + 1]);
+				i++;
+			}
+		}
+		else if (arg == "--uring") {
+			args.uring = true;
+		}
+		else if (arg == "--sync") {
+			args.sync = true;
+		}
+		else if (arg == "--prune") {
+			args.prune = true;
+		}
+		else if (arg == "--dedup") {
+			args.dedup = true;
+		}
+		else if (arg == "--policy") {
+			if (i + 1 < argc) {
+				args.policy = argv[i + 1];
+				i++;
+			}
+		}
+		else if (arg == "--tar") {
+			if (i + 1 < argc) {
+				args.tar = argv[i + 1];
+				i++;
+			}
+		}
+		else if (arg == "--inflate") {
+			if (i + 1 < argc) {
+				args.inflate = argv[i + 1];
+				i++;
+			}
+		}
+		else if (arg == "--bench-inflate") {
+			args.bench_inflate = true;
+		}
+		else if (arg == "--bench-open") {
+			args.bench_open = true;
+		}
+		else if (arg == "--pattern-file") {
+			if (i + 1 < argc) {
+				args.pattern_files.push_back(argv[i + 1]);
 				i++;
 			}
 		}
@@ -88,6 +196,144 @@ Arguments parseArguments(int argc, char* argv[]) {
 	return args;
 }
 
+// pack the files below args.dir into args.file as type; the caller releases
+// scan, policy, pack, writer and builder whether or not this succeeds
+bool createArchive(Arguments& args, pod_ident_type_t type, pod_scan_t*& scan, pod_policy_t*& policy, pod_pack_t*& pack, pod_writer_t*& writer, pod_builder_t*& builder) {
+	std::transform(args.file.begin(), args.file.end(), args.file.begin(), ::toupper);
+
+	std::string new_filename = args.file;
+	
+	pod_ssize_t pods_count = 1;
+	
+	pod_ssize_t file_count = 0;
+	// one pass over the tree yields names, sizes and times of every file
+	scan = pod_scan_create((pod_path_t)args.dir.c_str(), args.jobs >= 0 ? (pod_number_t)args.jobs : 0);
+	if (scan == nullptr) {
+		return false;
+	}
+	// POD4 to POD6 store or deflate each file as the policy decides, the others only store
+	if (type == POD4 || type == POD5 || type == POD6) {
+		policy = pod_policy_create();
+		if (policy == nullptr) {
+			return false;
+		}
+		if (!args.policy.empty() && !pod_policy_add_file(policy, (pod_path_t)args.policy.c_str())) {
+			fprintf(stderr, "Invalid policy file: %s\n", args.policy.c_str());
+			return false;
+		}
+	}
+	// files are loaded and deflated on the workers, then added here in scan order
+	pack = pod_pack_create(scan, args.jobs >= 0 ? (pod_number_t)args.jobs : 0, policy, args.dedup);
+	if (pack == nullptr) {
+		return false;
+	}
+	// archive entry and volume of the stored copy of each scanned file, duplicates
+	// link to it while it is in the same volume and are stored again otherwise
+	std::vector<pod_number_t> entry_of(scan->count);
+	std::vector<pod_ssize_t> volume_of(scan->count, 0);
+	pod_ssize_t dedup_count = 0;
+	pod_size_t dedup_saved = 0;
+
+	// POD3 to POD6 stream entry data to disk, only their index stays in memory;
+	// the other formats need their directory in front and are built in memory
+	if (pod_writer_supports(type)) {
+		writer = pod_writer_create((pod_path_t)new_filename.c_str(), type);
+		if (writer == nullptr) {
+			return false;
+		}
+	}
+	else {
+		builder = pod_builder_create(type);
+		if (builder == nullptr) {
+			return false;
+		}
+	}
+
+	pod_pack_item_t* item;
+	while ((item = pod_pack_next(pack)) != nullptr) {
+		const pod_scan_entry_t* scanned = item->entry;
+		std::string path = scanned->path;
+		std::string relative_path = scanned->name;
+
+		if (!item->ok) {
+			return false;
+		}
+		const pod_scan_data_t& buffer = item->content;
+		pod_number_t index = (pod_number_t)(scanned - scan->entries);
+
+		if (item->duplicate != 0 && volume_of[item->duplicate - 1] == pods_count) {
+			pod_number_t source = entry_of[item->duplicate - 1];
+			bool linked = writer != nullptr
+				? pod_writer_link(writer, relative_path.c_str(), source, scanned->mtime)
+				: pod_builder_link(builder, relative_path.c_str(), source, scanned->mtime);
+			if (!linked) {
+				return false;
+			}
+			dedup_saved += writer != nullptr ? writer->directory.entries[source].size : builder->directory.entries[source].size;
+			dedup_count++;
+
+			fprintf(stderr, "%s -> %s\n", path.c_str(), new_filename.c_str());
+			file_count++;
+			continue;
+		}
+		// the first copy went to an earlier volume, this one becomes the copy to link to
+		if (item->duplicate != 0) {
+			pod_pack_deflate(pack, item);
+			index = item->duplicate - 1;
+		}
+
+		const pod_byte_t* stored = item->packed != nullptr ? item->packed : buffer.data;
+		pod_size_t stored_size = item->packed != nullptr ? item->packed_size : buffer.size;
+
+		// POD5 and POD6 volumes are split before they reach 2GB, POD5 has the larger header
+		if ((type == POD5 || type == POD6) && writer->size + stored_size >= 0x7FFFFFFF) {
+			if (writer->directory.count == 0 || stored_size >= 0x7FFFFFFF - POD_HEADER_POD5_SIZE) {
+				fprintf(stderr, "File '%s' size exceeds 2GB limit! Aborting.\n", relative_path.c_str());
+				return false;
+			}
+			fprintf(stderr, "Archive size exceeds 2GB limit! Saving & splitting archive.\n");
+			pods_count++;
+			std::string next_filename = args.file.substr(0, args.file.length() - 4) + to_format(pods_count) + ".POD";
+			if (next_filename.length() >= POD_HEADER_NEXT_ARCHIVE_SIZE) {
+				fprintf(stderr, "Filename too long! Aborting.\n");
+				return false;
+			}
+			bool finished = pod_writer_finish(writer, next_filename.c_str());
+			writer = pod_writer_delete(writer);
+			if (!finished) {
+				return false;
+			}
+			new_filename = next_filename;
+			file_count = 0;
+			writer = pod_writer_create((pod_path_t)new_filename.c_str(), type);
+			if (writer == nullptr) {
+				return false;
+			}
+		}
+
+		pod_number_t level = item->packed != nullptr ? item->level : 0;
+		bool added = writer != nullptr
+			? pod_writer_add(writer, relative_path.c_str(), stored, stored_size, buffer.size, level, scanned->mtime)
+			: pod_builder_add(builder, relative_path.c_str(), stored, stored_size, buffer.size, level, scanned->mtime);
+		if (!added) {
+			return false;
+		}
+		entry_of[index] = (writer != nullptr ? writer->directory.count : builder->directory.count) - 1;
+		volume_of[index] = pods_count;
+
+		fprintf(stderr, "%s -> %s\n", path.c_str(), new_filename.c_str());
+		file_count++;
+	}
+	
+	if (dedup_count > 0) {
+		fprintf(stderr, "Deduplicated %lld files, saved %zu bytes\n", (long long)dedup_count, (size_t)dedup_saved);
+	}
+
+	return writer != nullptr
+		? pod_writer_finish(writer, nullptr)
+		: pod_builder_write(builder, (pod_path_t)new_filename.c_str(), nullptr);
+}
+
 int main(int argc, char* argv[])
 {
 	SetConsoleTitleA("TermPod (By Malte0621)");
@@ -114,24 +360,118 @@ int main(int argc, char* argv[])
 		return 0;
 	}
 
-	if (args.list) {
+	pod_cache_enable(args.index);
+	pod_uring_enable(args.uring);
+
+	if (!args.inflate.empty() && !pod_codec_backend_select(args.inflate.c_str())) {
+		return 1;
+	}
+
+	// all -p and --pattern-file rules are compiled into one matcher
+	pod_match_t* match = nullptr;
+	if ((args.list || args.extract) && (!args.patterns.empty() || !args.pattern_files.empty())) {
+		match = pod_match_create();
+		if (match == nullptr) {
+			return 1;
+		}
+		for (const auto& pattern : args.patterns) {
+			if (!pattern.empty() && !pod_match_add(match, pattern.c_str())) {
+				fprintf(stderr, "Invalid pattern: %s\n", pattern.c_str());
+				pod_match_delete(match);
+				return 1;
+			}
+		}
+		for (const auto& pattern_file : args.pattern_files) {
+			if (!pod_match_add_file(match, (pod_path_t)pattern_file.c_str())) {
+				fprintf(stderr, "Invalid pattern file: %s\n", pattern_file.c_str());
+				pod_match_delete(match);
+				return 1;
+			}
+		}
+	}
+
+	if (args.bench_inflate) {
+		fprintf(stderr, "Benchmark decompression of POD archive\n");
+		pod_file_type_t pod = pod_file_open((pod_path_t)args.file.c_str(), UNKNOWN, POD_OPEN_MMAP);
+		if (pod.pod1 == nullptr || !pod_file_inflate_bench(pod, 3)) {
+			pod_match_delete(match);
+			return 1;
+		}
+	}
+	else if (args.bench_open) {
+		fprintf(stderr, "Benchmark opening of POD archive\n");
+		if (!pod_file_open_bench((pod_path_t)args.file.c_str(), 10)) {
+			pod_match_delete(match);
+			return 1;
+		}
+	}
+	else if (args.list) {
 		fprintf(stderr, "List files in POD/EPD archive\n");
-		pod_file_type_t pod = pod_file_create((pod_path_t)args.file.c_str(), UNKNOWN);
-		if (!args.pattern.empty()) {
-			pod_file_print(pod, (pod_char_t*)args.pattern.c_str());
+		pod_volumes_t* volumes = pod_volumes_open((pod_path_t)args.file.c_str(), POD_OPEN_LAZY);
+		if (volumes == nullptr) {
+			pod_match_delete(match);
+			return 1;
 		}
-		else {
-			pod_file_print(pod, NULL);
+		bool listed = args.has_subtree
+			? pod_volumes_list_dir(volumes, (pod_path_t)args.subtree.c_str(), match) >= 0
+			: pod_volumes_print(volumes, match);
+		pod_volumes_delete(volumes);
+		if (!listed) {
+			pod_match_delete(match);
+			return 1;
 		}
 	}
 	else if (args.extract) {
 		fprintf(stderr, "Extract files from POD/EPD archive\n");
-		pod_file_type_t pod = pod_file_create((pod_path_t)args.file.c_str(), UNKNOWN);
-		if (!args.pattern.empty()) {
-			pod_file_extract(pod, (pod_char_t*)args.pattern.c_str(), (pod_path_t)args.dir.c_str());
+		pod_file_type_t pod = pod_file_open((pod_path_t)args.file.c_str(), UNKNOWN, POD_OPEN_MMAP);
+		if (!args.tar.empty()) {
+			FILE* output = stdout;
+			if (args.tar == "-") {
+#ifdef _WIN32
+				_setmode(_fileno(stdout), _O_BINARY);
+#endif
+			}
+			else if ((output = fopen(args.tar.c_str(), "wb")) == nullptr) {
+				fprintf(stderr, "ERROR: fopen(%s) failed: %s\n", args.tar.c_str(), strerror(errno));
+				pod_match_delete(match);
+				return 1;
+			}
+			pod_ssize_t extracted = pod_file_extract_tar(pod, (pod_path_t)args.subtree.c_str(), match, output);
+			if (output != stdout && fclose(output) != 0) {
+				fprintf(stderr, "ERROR: fclose(%s) failed: %s\n", args.tar.c_str(), strerror(errno));
+				pod_match_delete(match);
+				return 1;
+			}
+			if (extracted < 0) {
+				pod_match_delete(match);
+				return 1;
+			}
+		}
+		else if (args.sync || args.prune) {
+			pod_number_t jobs = args.jobs >= 0 ? (pod_number_t)args.jobs : 1;
+			if (pod_file_extract_sync(pod, (pod_path_t)args.subtree.c_str(), match, (pod_path_t)args.dir.c_str(), jobs, args.prune) < 0) {
+				pod_match_delete(match);
+				return 1;
+			}
+		}
+		else if (args.jobs >= 0 || args.uring) {
+			pod_number_t jobs = args.jobs >= 0 ? (pod_number_t)args.jobs : 1;
+			if (pod_file_extract_parallel(pod, (pod_path_t)args.subtree.c_str(), match, (pod_path_t)args.dir.c_str(), jobs) < 0) {
+				pod_match_delete(match);
+				return 1;
+			}
+		}
+		else if (args.has_subtree) {
+			if (pod_file_extract_dir(pod, (pod_path_t)args.subtree.c_str(), match, (pod_path_t)args.dir.c_str()) < 0) {
+				pod_match_delete(match);
+				return 1;
+			}
 		}
 		else {
-			pod_file_extract(pod, NULL, (pod_path_t)args.dir.c_str());
+			if (pod_file_extract_parallel(pod, (pod_path_t)"", match, (pod_path_t)args.dir.c_str(), 1) < 0) {
+				pod_match_delete(match);
+				return 1;
+			}
 		}
 	}
 	else if (args.create) {
@@ -155,242 +495,34 @@ int main(int argc, char* argv[])
 			type = EPD;
 		else {
 			fprintf(stderr, "Invalid pattern (POD Version)\n");
+			pod_match_delete(match);
 			return 1;
 		}
 
-		std::transform(args.file.begin(), args.file.end(), args.file.begin(), ::toupper);
-
-		std::string new_filename = args.file;
-		
-		pod_file_type_t pod = pod_file_create((pod_path_t)args.dir.c_str(), type);
-		pod_ssize_t pods_count = 1;
-		
-		pod_ssize_t file_count = 0;
-		pod_ssize_t final_file_count = 0;
-		for (const auto& direntry : std::filesystem::recursive_directory_iterator(args.dir)) {
-			if (!std::filesystem::is_regular_file(direntry.status())) {
-				continue;
-			}
-
-			final_file_count++;
-		}
-
-		for (const auto& direntry : std::filesystem::recursive_directory_iterator(args.dir)) {
-			std::string path = direntry.path().string();
-
-			if (!std::filesystem::is_regular_file(direntry.status())) {
-				continue;
-			}
-
-			std::string relative_path = path.substr(args.dir.length());
-			std::replace(relative_path.begin(), relative_path.end(), '/', POD_PATH_SEPARATOR);
-
-			if (relative_path[0] == POD_PATH_SEPARATOR) {
-				relative_path = relative_path.substr(1);
-			}
-			
-			std::ifstream file(path, std::ios::binary);
-			std::vector<char> buffer(std::istreambuf_iterator<char>(file), {});
-
-			pod_byte_t* data = (pod_byte_t*)buffer.data();
-
-			void* entry = nullptr;
-
-			// get file timestamp
-			unsigned long long timestamp = 0;
-			struct stat result;
-			if (stat(path.c_str(), &result) == 0) {
-				timestamp = result.st_mtime;
-			}
-
-			pod_byte_t* data2 = nullptr;
-			pod_number_t data2_size = 0;
-			pod_char_t name[POD_DIR_ENTRY_POD1_FILENAME_SIZE] = { 0 };
-			pod_char_t name2[POD_DIR_ENTRY_EPD_FILENAME_SIZE] = { 0 };
-
-			unsigned char compressionLevel = 0;
-
-			switch (type) {
-				case POD1:
-					data2_size = buffer.size();
-					strncpy(name, relative_path.c_str(), POD_DIR_ENTRY_POD1_FILENAME_SIZE);
-					entry = new pod_entry_pod1_t {
-						.name = *name,
-						.size = (pod_number_t)buffer.size(),
-						.offset = (pod_number_t)(POD_HEADER_POD1_SIZE + file_count * POD_DIR_ENTRY_POD1_SIZE),
-					};
-					break;
-				case POD2:
-					data2_size = buffer.size();
-					entry = new pod_entry_pod2_t{
-						.path_offset = (pod_number_t)(pod.pod2->size + POD_DIR_ENTRY_POD2_SIZE + buffer.size()),
-						.size = (pod_number_t)buffer.size(),
-						.offset = (pod_number_t)(POD_HEADER_POD2_SIZE + file_count * POD_DIR_ENTRY_POD2_SIZE),
-						.timestamp = (pod_signed_number_t)timestamp,
-						.checksum = pod_crc((pod_byte_t*)data, (pod_size_t)buffer.size())
-					};
-					break;
-				case POD3:
-					data2_size = buffer.size();
-					entry = new pod_entry_pod3_t{
-						.path_offset = (pod_number_t)(pod.pod3->size + POD_DIR_ENTRY_POD3_SIZE + buffer.size()),
-						.size = (pod_number_t)buffer.size(),
-						.offset = (pod_number_t)(POD_HEADER_POD3_SIZE + file_count * POD_DIR_ENTRY_POD3_SIZE),
-						.timestamp = (pod_number_t)timestamp,
-						.checksum = pod_crc((pod_byte_t*)data, (pod_size_t)buffer.size())
-					};
-					break;
-				case POD4:
-					if (buffer.size() >= 1024) {
-						if (buffer.size() >= 1024 * 4) compressionLevel = 8;
-						else if (buffer.size() >= 1024 * 2) compressionLevel = 4;
-						else if (buffer.size() >= 1024 * 1) compressionLevel = 2;
-						else compressionLevel = 1;
-						data2 = pod_compress((pod_byte_t*)data, compressionLevel, (pod_size_t)buffer.size(), (pod_string_t)relative_path.c_str(), &data2_size);
-					}
-					else {
-						data2_size = buffer.size();
-					}
-
-					entry = new pod_entry_pod4_t{
-						.path_offset = (pod_number_t)(pod.pod4->size + POD_DIR_ENTRY_POD4_SIZE + data2_size),
-						.size = (pod_number_t)data2_size,
-						.offset = (pod_number_t)(pod.pod4->size + file_count * POD_DIR_ENTRY_POD4_SIZE),
-						.uncompressed = (pod_number_t)buffer.size(),
-						.compression_level = (pod_number_t)(data2 == nullptr ? 0 : compressionLevel),
-						.timestamp = (pod_number_t)timestamp,
-						.checksum = pod_crc((pod_byte_t*)data2, (pod_size_t)buffer.size())
-					};
-					break;
-				case POD5:
-					if (buffer.size() >= 1024) {
-						if (buffer.size() >= 1024 * 4) compressionLevel = 8;
-						else if (buffer.size() >= 1024 * 2) compressionLevel = 4;
-						else if (buffer.size() >= 1024 * 1) compressionLevel = 2;
-						else compressionLevel = 1;
-						data2 = pod_compress((pod_byte_t*)data, compressionLevel, (pod_size_t)buffer.size(), (pod_string_t)relative_path.c_str(), &data2_size);
-					}
-					else {
-						data2_size = buffer.size();
-					}
-
-					entry = new pod_entry_pod5_t{
-						.path_offset = (pod_number_t)(pod.pod5->size + POD_DIR_ENTRY_POD5_SIZE + data2_size),
-						.size = (pod_number_t)data2_size,
-						.offset = (pod_number_t)(pod.pod5->size + file_count * POD_DIR_ENTRY_POD5_SIZE),
-						.uncompressed = (pod_number_t)buffer.size(),
-						.compression_level = (pod_number_t)(data2 == nullptr ? 0 : compressionLevel),
-						.timestamp = (pod_number_t)timestamp,
-						.checksum = pod_crc((pod_byte_t*)data2, (pod_size_t)buffer.size())
-					};
-					break;
-				case POD6:
-					if (buffer.size() >= 1024) {
-						if (buffer.size() >= 1024 * 4) compressionLevel = 8;
-						else if (buffer.size() >= 1024 * 2) compressionLevel = 4;
-						else if (buffer.size() >= 1024 * 1) compressionLevel = 2;
-						else compressionLevel = 1;
-						data2 = pod_compress((pod_byte_t*)data, compressionLevel, (pod_size_t)buffer.size(), (pod_string_t)relative_path.c_str(), &data2_size);
-					}
-					else {
-						data2_size = buffer.size();
-					}
-
-					entry = new pod_entry_pod6_t{
-						.path_offset = (pod_number_t)(pod.pod6->size + POD_DIR_ENTRY_POD6_SIZE + data2_size),
-						.size = (pod_number_t)data2_size,
-						.offset = (pod_number_t)(pod.pod6->size + file_count * POD_DIR_ENTRY_POD6_SIZE),
-						.uncompressed = (pod_number_t)buffer.size(),
-						.compression_level = (pod_number_t)(data2 == nullptr ? 0 : compressionLevel),
-						.zero = 0,
-					};
-					break;
-				case EPD:
-					data2_size = buffer.size();
-					strncpy(name2, relative_path.c_str(), POD_DIR_ENTRY_EPD_FILENAME_SIZE);
-					entry = new pod_entry_epd_t{
-						.name = *name2,
-						.size = (pod_number_t)buffer.size(),
-						.offset = (pod_number_t)(POD_HEADER_EPD_SIZE + file_count * POD_DIR_ENTRY_EPD_SIZE),
-						.timestamp = (pod_number_t)timestamp,
-						.checksum = pod_crc((pod_byte_t*)data2, (pod_size_t)buffer.size())
-					};
-					break;
-				default:
-					fprintf(stderr, "Unknown pod type\n");
-					break;
-			}
-
-			if (entry == nullptr) {
-				fprintf(stderr, "Entry is null\n");
-				return 1;
-			}
-			
-			switch (type) {
-			case POD5:
-				if (pod.pod5->size + data2_size >= 0x7FFFFFFF) {
-					fprintf(stderr, "Archive size exceeds 2GB limit! Saving & splitting archive.\n");
-					file_count = 0;
-					pods_count++;
-					new_filename = args.file.substr(0, args.file.length() - 4) + to_format(pods_count) + ".POD";
-					if (new_filename.length() >= POD_HEADER_NEXT_ARCHIVE_SIZE) {
-						fprintf(stderr, "Filename too long! Aborting.\n");
-						return 1;
-					}
-					if (pod.pod5->size >= 0x7FFFFFFF) {
-						fprintf(stderr, "File '%s' size exceeds 2GB limit! Aborting.\n", name);
-						return 1;
-					}
-
-					strcpy(pod.pod5->header->next_archive, new_filename.c_str());
-					pod_file_write(pod, (pod_path_t)args.file.c_str());
-					pod_file_delete(pod);
-					pod = pod_file_create((pod_path_t)args.dir.c_str(), type);
-				}
-				break;
-			case POD6:
-				if (pod.pod6->size + data2_size >= 0x7FFFFFFF) {
-					fprintf(stderr, "Archive size exceeds 2GB limit! Saving & splitting archive.\n");
-					file_count = 0;
-					pods_count++;
-					new_filename = args.file.substr(0, args.file.length() - 4) + to_format(pods_count) + ".POD";
-					if (new_filename.length() >= POD_HEADER_NEXT_ARCHIVE_SIZE) {
-						fprintf(stderr, "Filename too long! Aborting.\n");
-						return 1;
-					}
-					if (pod.pod5->size >= 0x7FFFFFFF) {
-						fprintf(stderr, "File '%s' size exceeds 2GB limit! Aborting.\n", name);
-						return 1;
-					}
-					strcpy(pod.pod6->header->next_archive, new_filename.c_str());
-					pod_file_write(pod, (pod_path_t)args.file.c_str());
-					pod_file_delete(pod);
-					pod = pod_file_create((pod_path_t)args.dir.c_str(), type);
-				}
-				break;
-			}
-
-			if (data2 == nullptr) {
-				pod_file_entry_data_add(pod, entry, (pod_string_t)relative_path.c_str(), (pod_byte_t*)data);
-			}
-			else {
-				pod_file_entry_data_add(pod, entry, (pod_string_t)relative_path.c_str(), (pod_byte_t*)data2);
-			}
-			
-			delete data2;
-			delete entry;
-
-			fprintf(stderr, "%s -> %s\n", path.c_str(), new_filename.c_str());
-			file_count++;
+		pod_scan_t* scan = nullptr;
+		pod_policy_t* policy = nullptr;
+		pod_pack_t* pack = nullptr;
+		pod_writer_t* writer = nullptr;
+		pod_builder_t* builder = nullptr;
+		bool created = createArchive(args, type, scan, policy, pack, writer, builder);
+		// an unfinished writer also removes its partial output
+		pod_writer_delete(writer);
+		pod_builder_delete(builder);
+		pod_pack_delete(pack);
+		pod_policy_delete(policy);
+		pod_scan_delete(scan);
+		if (!created) {
+			pod_match_delete(match);
+			return 1;
 		}
-		
-		pod_file_write(pod, (pod_path_t)new_filename.c_str());
 	}
 	else {
 		printHelp();
 		fprintf(stderr, "\nInvalid arguments\n");
+		pod_match_delete(match);
 		return 1;
 	}
 
+	pod_match_delete(match);
 	return 0;
 }